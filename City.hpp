@@ -1,8 +1,10 @@
 #ifndef __City_hpp__
 #define __City_hpp__
 
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <functional>
 
 /**
  * @brief Classe per rappresentare una città
@@ -88,6 +90,36 @@ bool std::greater<City>::operator()(const City &a, const City &b) const
     return a.getPopulation() < b.getPopulation();
 }
 
+/**
+ * @brief Specializzazione di std::hash per la classe City
+ * Coerente con std::less e std::greater: due città sono equivalenti se hanno la stessa popolazione
+ *
+ * @param city è la città di cui calcolare l'hash
+ * @return std::size_t è l'hash della popolazione
+ */
+template <>
+struct std::hash<City>
+{
+    inline std::size_t operator()(const City &city) const
+    {
+        return std::hash<uint>{}(city.getPopulation());
+    }
+};
+
+/**
+ * @brief Proiezione della popolazione di una città, per aggregarla con monoidAugmentation
+ *
+ * @param city è la città
+ * @return uint64_t è la popolazione della città
+ */
+struct cityPopulation
+{
+    inline uint64_t operator()(const City &city) const
+    {
+        return city.getPopulation();
+    }
+};
+
 /**
  * Stampa il nome di una città su uno stream
  *
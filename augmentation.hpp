@@ -0,0 +1,217 @@
+#ifndef __augmentation_hpp__
+#define __augmentation_hpp__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+
+/**
+ * @brief Aumento nullo: i nodi di bst non memorizzano alcuna informazione sul proprio sottoalbero
+ *
+ * Un aumento descrive un valore calcolato per ogni nodo a partire dal sottoalbero di cui è radice. Deve fornire:
+ * - value_type, il tipo del valore memorizzato nel nodo;
+ * - enabled, false se il valore non deve essere mantenuto (nessun costo aggiuntivo);
+ * - identity(), il valore di un sottoalbero vuoto;
+ * - lift(key, count), il valore di un singolo nodo;
+ * - combine(a, b), il valore della concatenazione di due sequenze di chiavi (deve essere associativa).
+ * Il valore di un nodo è combine(combine(sinistro, lift(chiave, occorrenze)), destro) e viene ricalcolato da bst
+ * a ogni modifica della struttura (inserimenti, cancellazioni, rotazioni, divisioni e concatenazioni).
+ */
+struct noAugmentation
+{
+    struct value_type
+    {
+    };
+
+    static constexpr bool enabled{false};
+
+    static inline value_type identity()
+    {
+        return {};
+    }
+
+    template <typename T>
+    static inline value_type lift(const T &, unsigned int)
+    {
+        return {};
+    }
+
+    static inline value_type combine(const value_type &, const value_type &)
+    {
+        return {};
+    }
+};
+
+/**
+ * @brief Hash del multinsieme delle chiavi di un sottoalbero
+ *
+ * Il valore di un sottoalbero è la somma (modulo 2^64) degli hash rimescolati delle sue chiavi, ripetuti tante volte
+ * quante sono le occorrenze. La somma è commutativa, quindi l'hash non dipende dalla forma dell'albero: due repliche
+ * con le stesse chiavi hanno lo stesso hash anche se costruite con ordini di inserimento diversi, e le rotazioni non
+ * modificano l'hash degli antenati.
+ *
+ * @tparam T è il tipo di dato delle chiavi
+ * @tparam HASH è la funzione hash del tipo T (chiavi equivalenti devono avere lo stesso hash)
+ */
+template <typename T, typename HASH = std::hash<T>>
+struct subtreeHash
+{
+    using value_type = uint64_t;
+
+    static constexpr bool enabled{true};
+
+    static inline value_type identity()
+    {
+        return 0;
+    }
+
+    static inline value_type lift(const T &key, unsigned int count)
+    {
+        uint64_t h{(uint64_t)HASH{}(key) + 0x9e3779b97f4a7c15ULL}; // Finalizzatore di splitmix64
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return (h ^ (h >> 31)) * count;
+    }
+
+    static inline value_type combine(const value_type &a, const value_type &b)
+    {
+        return a + b;
+    }
+};
+
+/**
+ * @brief Monoide della somma
+ *
+ * @tparam V è il tipo dei valori da sommare
+ */
+template <typename V>
+struct sumMonoid
+{
+    using value_type = V;
+
+    static inline value_type identity()
+    {
+        return V{};
+    }
+
+    static inline value_type combine(const value_type &a, const value_type &b)
+    {
+        return a + b;
+    }
+};
+
+/**
+ * @brief Monoide del minimo
+ *
+ * @tparam V è il tipo dei valori (l'elemento neutro è il massimo valore rappresentabile)
+ */
+template <typename V>
+struct minMonoid
+{
+    using value_type = V;
+
+    static inline value_type identity()
+    {
+        return std::numeric_limits<V>::max();
+    }
+
+    static inline value_type combine(const value_type &a, const value_type &b)
+    {
+        return b < a ? b : a;
+    }
+};
+
+/**
+ * @brief Monoide del massimo
+ *
+ * @tparam V è il tipo dei valori (l'elemento neutro è il minimo valore rappresentabile)
+ */
+template <typename V>
+struct maxMonoid
+{
+    using value_type = V;
+
+    static inline value_type identity()
+    {
+        return std::numeric_limits<V>::lowest();
+    }
+
+    static inline value_type combine(const value_type &a, const value_type &b)
+    {
+        return a < b ? b : a;
+    }
+};
+
+/**
+ * @brief Proiezione che restituisce la chiave stessa
+ */
+struct keyProjection
+{
+    template <typename T>
+    inline const T &operator()(const T &key) const
+    {
+        return key;
+    }
+};
+
+/**
+ * @brief Proiezione che vale 1 per ogni chiave (con sumMonoid conta le chiavi)
+ */
+struct unitProjection
+{
+    template <typename T>
+    inline std::size_t operator()(const T &) const
+    {
+        return 1;
+    }
+};
+
+/**
+ * @brief Aumento definito da un monoide applicato a una proiezione delle chiavi
+ *
+ * Ogni nodo memorizza la combinazione, in ordine simmetrico, dei valori PROJ(chiave) del proprio sottoalbero; bst::aggregate(a, b)
+ * restituisce la combinazione dei valori delle chiavi di un intervallo in O(h). Per esempio
+ * monoidAugmentation<City, cityPopulation, sumMonoid<uint64_t>> somma la popolazione delle città.
+ *
+ * @tparam T è il tipo di dato delle chiavi
+ * @tparam PROJ è la proiezione, un oggetto funzione che ricava dalla chiave il valore da aggregare
+ * @tparam MONOID è il monoide (value_type, identity() e combine() associativa), per esempio sumMonoid, minMonoid o maxMonoid
+ */
+template <typename T, typename PROJ, typename MONOID>
+struct monoidAugmentation
+{
+    using value_type = typename MONOID::value_type;
+
+    static constexpr bool enabled{true};
+
+    static inline value_type identity()
+    {
+        return MONOID::identity();
+    }
+
+    static inline value_type lift(const T &key, unsigned int count)
+    {
+        value_type power{(value_type)PROJ{}(key)};
+        value_type result{MONOID::identity()};
+        for (; count > 0; count >>= 1) // Le occorrenze ripetute si combinano per raddoppi successivi
+        {
+            if (count & 1)
+            {
+                result = MONOID::combine(result, power);
+            }
+            if (count > 1)
+            {
+                power = MONOID::combine(power, power);
+            }
+        }
+        return result;
+    }
+
+    static inline value_type combine(const value_type &a, const value_type &b)
+    {
+        return MONOID::combine(a, b);
+    }
+};
+
+#endif
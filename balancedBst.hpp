@@ -0,0 +1,375 @@
+#ifndef __balancedBst_hpp__
+#define __balancedBst_hpp__
+
+#include <math.h>
+
+#include "bst.hpp"
+
+/**
+ * @class balancedBst
+ *
+ * @brief Albero binario di ricerca con ribilanciamento automatico in stile scapegoat tree.
+ * Quando un inserimento crea un nodo a profondità maggiore di c·log₂(n), si risale dal nuovo nodo fino al primo
+ * antenato sbilanciato (il "capro espiatorio", in cui un figlio contiene più di una frazione α dei nodi) e se ne
+ * ribilancia il sottoalbero con l'algoritmo di Day-Stout-Warren. Con α = 2^(-1/c) l'altezza resta O(c·log₂(n))
+ * e il costo ammortizzato di inserimento e cancellazione è O(log n).
+ * Il numero di nodi è aggiornato da tutte le operazioni che modificano l'albero (anche eraseRange(), erase(), eraseIf(),
+ * split(), join() e insertValue(hint, value)); quando le cancellazioni lo portano sotto la frazione α del massimo raggiunto
+ * l'albero viene ribilanciato per intero. remove() e swap() di bst non sono disponibili, perché non aggiornano il numero di nodi.
+ *
+ * @tparam T è il tipo di dato delle chiavi associate ai nodi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ */
+template <typename T, typename CMP = std::greater<T>>
+class balancedBst : public bst<T, CMP>
+{
+private:
+    u_int size;    // numero di nodi dell'albero
+    u_int maxSize; // numero massimo di nodi dall'ultimo ribilanciamento completo
+    double factor; // costante c del limite di altezza c·log₂(n)
+    double alpha;  // frazione massima di nodi in un sottoalbero figlio
+
+    using bst<T, CMP>::remove; // Non aggiorna il numero di nodi
+
+    /**
+     * @brief Verifica se una profondità supera il limite c·log₂(n)
+     *
+     * @param depth è la profondità da verificare
+     * @return true se la profondità supera il limite
+     * @return false altrimenti
+     */
+    inline bool tooDeep(u_int depth) const
+    {
+        return depth > factor * log2((double)size + 1) + 1;
+    }
+
+    /**
+     * @brief Conta un nodo appena inserito e, se è troppo profondo, ribilancia il sottoalbero del capro espiatorio
+     *
+     * @param node è il nodo inserito
+     * @return true se è stato ribilanciato un sottoalbero (i nodi possono aver cambiato chiave)
+     * @return false altrimenti
+     */
+    bool inserted(bst<T, CMP> *node)
+    {
+        ++size;
+        maxSize = size > maxSize ? size : maxSize;
+        u_int depth{1};
+        for (const bst<T, CMP> *up{node}; up->parent != nullptr; up = up->parent)
+        {
+            ++depth;
+        }
+        if (!tooDeep(depth))
+        {
+            return false;
+        }
+        u_int childSize{1}; // Si risale calcolando le dimensioni dei sottoalberi fino al capro espiatorio
+        while (node->parent != nullptr)
+        {
+            bst<T, CMP> *up{node->parent};
+            bst<T, CMP> *sibling{node == up->left ? up->right : up->left};
+            u_int upSize{1 + childSize + (sibling == nullptr ? 0 : sibling->nodesCount())};
+            if (childSize > alpha * upSize)
+            {
+                bst<T, CMP>::rebalanceSubtree(up);
+                return true;
+            }
+            node = up;
+            childSize = upSize;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Sottrae i nodi eliminati e ribilancia l'albero se è sceso sotto la frazione α della dimensione massima
+     *
+     * @param count è il numero di nodi eliminati
+     * @return u_int è il numero di nodi eliminati
+     */
+    u_int erased(u_int count)
+    {
+        size -= count;
+        if (size < alpha * maxSize)
+        {
+            this->rebalance();
+            maxSize = size;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Sposta in un albero bilanciato il contenuto di un bst di cui si conosce il numero di nodi
+     *
+     * @param tree è l'albero da spostare (rimane vuoto)
+     * @param nodes è il numero di nodi di tree
+     * @param inputMaxSize è la dimensione massima di riferimento per la regola di cancellazione
+     * @param inputFactor è la costante c del limite di altezza
+     * @return balancedBst<T, CMP> è l'albero bilanciato
+     */
+    static balancedBst<T, CMP> wrap(bst<T, CMP> &tree, u_int nodes, u_int inputMaxSize, double inputFactor)
+    {
+        balancedBst<T, CMP> result(inputFactor);
+        result.bst<T, CMP>::swap(tree);
+        result.size = nodes;
+        result.maxSize = inputMaxSize;
+        result.erased(0);
+        return result;
+    }
+
+    /**
+     * @brief Concatena due alberi bilanciati con un eventuale pivot mantenendo il limite di altezza
+     * Se le dimensioni sono confrontabili la nuova radice non è un capro espiatorio e basta la concatenazione di bst
+     * (O(h)). Se un albero è molto più piccolo dell'altro le sue chiavi vengono inserite nel maggiore (O(m log n) per
+     * m chiavi), altrimenti l'albero concatenato viene ribilanciato per intero (O(n)).
+     *
+     * @param a è l'albero con le chiavi minori (rimane vuoto)
+     * @param pivot è la chiave che separa i due alberi (nullptr se assente)
+     * @param b è l'albero con le chiavi maggiori (rimane vuoto)
+     * @return balancedBst<T, CMP> è l'albero concatenato
+     */
+    static balancedBst<T, CMP> concatenate(balancedBst<T, CMP> &a, const T *pivot, balancedBst<T, CMP> &b)
+    {
+        u_int total{a.size + b.size + (pivot != nullptr ? 1 : 0)};
+        balancedBst<T, CMP> &large{a.size >= b.size ? a : b};
+        balancedBst<T, CMP> &small{a.size >= b.size ? b : a};
+        if ((small.size + 1) * log2((double)total + 1) < large.size) // Pochi nodi: si inseriscono nell'albero maggiore
+        {
+            balancedBst<T, CMP> result{wrap(large, large.size, large.maxSize, large.factor)};
+            large.size = large.maxSize = 0;
+            if (pivot != nullptr)
+            {
+                result.insertValue(*pivot);
+            }
+            if (!small.isEmpty())
+            {
+                for (const bst<T, CMP> *node{small.bst<T, CMP>::min()}; node != nullptr; node = bst<T, CMP>::nextNode(node))
+                {
+                    result.insertValue(node->key);
+                }
+                delete small.release();
+            }
+            small.size = small.maxSize = 0;
+            return result;
+        }
+        // Con il pivot i figli della radice sono a e b, altrimenti la radice è il minimo di b
+        u_int right{pivot == nullptr && b.size > 0 ? b.size - 1 : b.size};
+        u_int larger{a.size > right ? a.size : right};
+        bst<T, CMP> joined{pivot != nullptr ? bst<T, CMP>::join(std::move(a), *pivot, std::move(b)) : bst<T, CMP>::join(std::move(a), std::move(b))};
+        balancedBst<T, CMP> result{wrap(joined, total, total, a.factor)};
+        a.size = a.maxSize = b.size = b.maxSize = 0;
+        if (larger > result.alpha * total) // La radice è un capro espiatorio
+        {
+            result.rebalance();
+        }
+        return result;
+    }
+
+public:
+    /**
+     * @brief Costruttore vuoto
+     *
+     * @param inputFactor è la costante c del limite di altezza (deve essere maggiore di 1)
+     */
+    balancedBst(double inputFactor = 2.0) : bst<T, CMP>(), size{0}, maxSize{0}, factor{inputFactor}, alpha{pow(2.0, -1.0 / inputFactor)} {}
+
+    /**
+     * @brief Costruttore per convertire un array in un albero bilanciato
+     *
+     * @param array che si vuole convertire nell'albero binario di ricerca
+     * @param length è la lunghezza dell'array
+     * @param inputFactor è la costante c del limite di altezza (deve essere maggiore di 1)
+     */
+    balancedBst(const T array[], uint length, double inputFactor = 2.0) : balancedBst(inputFactor)
+    {
+        for (u_int i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    /**
+     * @brief Inserisce un valore e ribilancia il sottoalbero del capro espiatorio se il nuovo nodo è troppo profondo
+     *
+     * @param value è il valore da inserire
+     * @return puntatore alla radice dell'albero
+     */
+    bst<T, CMP> *insertValue(const T &value)
+    {
+        inserted(this->insertNode(value));
+        return this;
+    }
+
+    /**
+     * @brief Inserisce un valore partendo da un nodo vicino (vedi bst::insertValue(hint, value))
+     * Se il nuovo nodo è troppo profondo si ribilancia il sottoalbero del capro espiatorio: in quel caso l'iteratore
+     * restituito viene ricalcolato dalla radice e gli iteratori ottenuti in precedenza non vanno più usati come hint.
+     *
+     * @param hint è l'iteratore al nodo da cui partire (se vuoto si parte dalla radice)
+     * @param value è il valore da inserire
+     * @return const_iterator a un nodo con la chiave inserita
+     */
+    typename bst<T, CMP>::const_iterator insertValue(typename bst<T, CMP>::const_iterator hint, const T &value)
+    {
+        typename bst<T, CMP>::const_iterator it{bst<T, CMP>::insertValue(hint, value)};
+        if (inserted(const_cast<bst<T, CMP> *>(&*it)))
+        {
+            return this->findFrom(typename bst<T, CMP>::const_iterator{}, value);
+        }
+        return it;
+    }
+
+    /**
+     * @brief Inserisce un lotto di valori non ordinati usando più thread (vedi bst::insertBatch())
+     * I valori che finiscono sotto un figlio mancante formano sottoalberi bilanciati, ma un lotto concentrato in un
+     * intervallo di chiavi può comunque allungare un cammino: se uno dei cammini raggiunti dal lotto supera il limite
+     * c·log₂(n) l'albero viene ribilanciato per intero. Il numero di nodi aumenta della lunghezza del lotto e la profondità
+     * viene misurata solo sui cammini modificati, quindi il controllo costa quanto l'inserimento e non O(n).
+     *
+     * @tparam IT è il tipo degli iteratori del lotto
+     * @param first è l'iteratore al primo valore
+     * @param last è l'iteratore successivo all'ultimo valore
+     * @param threadCount è il numero massimo di compiti paralleli
+     */
+    template <typename IT>
+    void insertBatch(IT first, IT last, uint threadCount = std::thread::hardware_concurrency())
+    {
+        std::vector<T> batch(first, last);
+        size += batch.size();
+        maxSize = size > maxSize ? size : maxSize;
+        if (tooDeep(bst<T, CMP>::mergeBatch(std::move(batch), threadCount)))
+        {
+            this->rebalance();
+        }
+    }
+
+    /**
+     * @brief Elimina il nodo associato a una chiave
+     * Se dopo molte cancellazioni l'albero scende sotto una frazione α della dimensione massima viene ribilanciato per intero.
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value chiave corrispondente al nodo da eliminare
+     */
+    void deleteKey(const T &value)
+    {
+        bst<T, CMP>::deleteKey(value);
+        erased(1);
+    }
+
+    /**
+     * @brief Eliminazione delle chiavi di un intervallo chiuso [a, b] (vedi bst::eraseRange()) con la regola di deleteKey()
+     *
+     * @param a è l'estremo sinistro dell'intervallo
+     * @param b è l'estremo destro dell'intervallo
+     * @return numero di nodi eliminati
+     */
+    u_int eraseRange(const T &a, const T &b)
+    {
+        return erased(bst<T, CMP>::eraseRange(a, b));
+    }
+
+    /**
+     * @brief Eliminazione dei nodi compresi tra due iteratori (vedi bst::erase()) con la regola di deleteKey()
+     *
+     * @param first è l'iteratore al primo nodo da eliminare
+     * @param last è l'iteratore al primo nodo da non eliminare
+     * @return numero di nodi eliminati
+     */
+    u_int erase(typename bst<T, CMP>::const_iterator first, typename bst<T, CMP>::const_iterator last)
+    {
+        return erased(bst<T, CMP>::erase(first, last));
+    }
+
+    /**
+     * @brief Eliminazione dei nodi la cui chiave soddisfa un predicato (vedi bst::eraseIf()) con la regola di deleteKey()
+     *
+     * @tparam PRED è il tipo del predicato
+     * @param pred è il predicato che indica le chiavi da eliminare
+     * @return numero di nodi eliminati
+     */
+    template <typename PRED>
+    u_int eraseIf(PRED pred)
+    {
+        return erased(bst<T, CMP>::eraseIf(pred));
+    }
+
+    /**
+     * @brief Divide l'albero in corrispondenza di una chiave (vedi bst::split())
+     * Il numero di nodi delle due parti si ottiene visitandole in parallelo fino all'esaurimento della minore, quindi il
+     * costo è O(h + min(k, n - k)). Ogni parte eredita la dimensione massima dell'albero diviso: come dopo una
+     * cancellazione, la parte rimasta sotto la frazione α di quella dimensione viene ribilanciata.
+     *
+     * @param value è la chiave di divisione
+     * @return coppia di alberi: il primo con le chiavi minori di value, il secondo con quelle maggiori o uguali
+     */
+    std::pair<balancedBst<T, CMP>, balancedBst<T, CMP>> split(const T &value)
+    {
+        std::pair<bst<T, CMP>, bst<T, CMP>> parts{bst<T, CMP>::split(value)};
+        const bst<T, CMP> *x{parts.first.isEmpty() ? nullptr : parts.first.min()};
+        const bst<T, CMP> *y{parts.second.isEmpty() ? nullptr : parts.second.min()};
+        u_int counted{0};
+        while (x != nullptr && y != nullptr)
+        {
+            x = bst<T, CMP>::nextNode(x);
+            y = bst<T, CMP>::nextNode(y);
+            ++counted;
+        }
+        u_int lessSize{x == nullptr ? counted : size - counted};
+        std::pair<balancedBst<T, CMP>, balancedBst<T, CMP>> result{wrap(parts.first, lessSize, maxSize, factor),
+                                                                  wrap(parts.second, size - lessSize, maxSize, factor)};
+        size = maxSize = 0;
+        return result;
+    }
+
+    /**
+     * @brief Concatena due alberi in cui tutte le chiavi di a precedono quelle di b (vedi bst::join())
+     * Il risultato rispetta il limite di altezza; se i due alberi hanno dimensioni molto diverse il costo supera O(h)
+     * (vedi concatenate()). I due alberi forniti rimangono vuoti.
+     *
+     * @param a è l'albero con le chiavi minori
+     * @param b è l'albero con le chiavi maggiori
+     * @return balancedBst<T, CMP> è l'albero concatenato
+     */
+    static balancedBst<T, CMP> join(balancedBst<T, CMP> &&a, balancedBst<T, CMP> &&b)
+    {
+        return concatenate(a, nullptr, b);
+    }
+
+    /**
+     * @brief Concatena due alberi separati da una chiave pivot (vedi bst::join()) rispettando il limite di altezza
+     *
+     * @param a è l'albero con le chiavi minori o uguali al pivot
+     * @param pivot è la chiave che separa i due alberi
+     * @param b è l'albero con le chiavi maggiori
+     * @return balancedBst<T, CMP> è l'albero concatenato
+     */
+    static balancedBst<T, CMP> join(balancedBst<T, CMP> &&a, const T &pivot, balancedBst<T, CMP> &&b)
+    {
+        return concatenate(a, &pivot, b);
+    }
+
+    /**
+     * @brief Scambia il contenuto di due alberi bilanciati, compreso il numero di nodi
+     *
+     * @param other è l'albero con cui scambiare il contenuto
+     */
+    void swap(balancedBst<T, CMP> &other)
+    {
+        bst<T, CMP>::swap(other);
+        std::swap(size, other.size);
+        std::swap(maxSize, other.maxSize);
+        std::swap(factor, other.factor);
+        std::swap(alpha, other.alpha);
+    }
+
+    /**
+     * @brief Contatore dei nodi dell'albero in tempo costante
+     *
+     * @return naturale che esprime il numero di nodi dell'albero
+     */
+    inline u_int nodesCount() const
+    {
+        return size;
+    }
+};
+
+#endif
@@ -0,0 +1,1306 @@
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <memory>
+#include <filesystem>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "bst.hpp"
+#include "splayBst.hpp"
+#include "indexBst.hpp"
+#include "bufferedBst.hpp"
+#include "weightedBst.hpp"
+#include "indexedBst.hpp"
+#include "filteredBst.hpp"
+#include "staticBst.hpp"
+#include "learnedIndex.hpp"
+#include "merkleBst.hpp"
+#include "loggedBst.hpp"
+#include "intervalTree.hpp"
+#include "btree.hpp"
+#include "shardedBst.hpp"
+#include "vebTree.hpp"
+#include "stringBst.hpp"
+#include "projectedBst.hpp"
+#include "City.hpp"
+#include "lazyBst.hpp"
+
+void benchSplay();
+void benchCompact();
+void benchIndex();
+void benchBuffered();
+void benchWeighted();
+void benchIndexed();
+void benchFiltered();
+void benchLearned();
+void benchMerkle();
+void benchLogged();
+void benchAggregate();
+void benchInterval();
+void benchBtree();
+void benchSharded();
+void benchBatch();
+void benchVeb();
+void benchString();
+void benchProjected();
+void benchLazy();
+
+/**
+ * @brief Programma per misurare le prestazioni delle varianti della classe bst
+ * Sono definite le seguenti funzioni di misura:
+ * 1 - benchSplay() per confrontare bst e splayBst (splaying a ogni accesso e randomizzato) con ricerche uniformi, con distribuzione di Zipf e concentrate su poche chiavi
+ * 2 - benchCompact() per misurare visita e ricerca prima e dopo relayout() su un albero frammentato
+ * 3 - benchIndex() per confrontare memoria e tempi di bst e indexBst (con e senza indice del genitore)
+ * 4 - benchBuffered() per confrontare gli inserimenti singoli con quelli a lotti di bufferedBst
+ * 5 - benchWeighted() per misurare confronti attesi e tempi di ricerca prima e dopo weightedBst::rebuildOptimal() e la registrazione di accessi a chiavi con gli stessi bit bassi
+ * 6 - benchIndexed() per confrontare le ricerche esatte di bst e indexedBst
+ * 7 - benchFiltered() per confrontare isPresent() di bst e filteredBst con ricerche per lo più senza esito
+ * 8 - benchLearned() per confrontare learnedIndex con bst, l'array ordinato e staticBst sulle stesse chiavi
+ * 9 - benchMerkle() per confrontare merkleBst::diff() con il confronto completo di due repliche
+ * 10 - benchLogged() per misurare il costo del log di loggedBst sugli inserimenti e i tempi di ripristino
+ * 11 - benchAggregate() per confrontare bst::aggregate(a, b) con la visita delle chiavi dell'intervallo
+ * 12 - benchInterval() per confrontare intervalTree::overlaps() con la scansione lineare degli intervalli
+ * 13 - benchBtree() per confrontare inserimenti, ricerche e cancellazioni di bst e btree con diverse dimensioni dei nodi
+ * 14 - benchSharded() per confrontare gli inserimenti concorrenti in un bst protetto da un mutex e in shardedBst
+ * 15 - benchBatch() per confrontare l'inserimento di un lotto di chiavi non ordinate con insertValue() e con bst::insertBatch()
+ * 16 - benchVeb() per confrontare bst, btree e vebTree su chiavi intere e misurare successor() di vebTree
+ * 17 - benchString() per confrontare inserimenti e ricerche di bst<std::string> e stringBst
+ * 18 - benchProjected() per confrontare le ricerche per popolazione di bst<City> e projectedBst<City, &City::getPopulation>
+ * 19 - benchLazy() per confrontare le cancellazioni di bst e quelle pigre di lazyBst (tempo totale e cancellazione più lenta) con diverse soglie
+ */
+int main()
+{
+    benchSplay();
+    benchCompact();
+    benchIndex();
+    benchBuffered();
+    benchWeighted();
+    benchIndexed();
+    benchFiltered();
+    benchLearned();
+    benchMerkle();
+    benchLogged();
+    benchAggregate();
+    benchInterval();
+    benchBtree();
+    benchSharded();
+    benchBatch();
+    benchVeb();
+    benchString();
+    benchProjected();
+    benchLazy();
+
+    return 0;
+}
+
+/**
+ * @brief Misura il tempo di esecuzione di una funzione
+ *
+ * @tparam F è il tipo della funzione da misurare
+ * @param f è la funzione da misurare
+ * @return double è il tempo impiegato in millisecondi
+ */
+template <typename F>
+double measure(F f)
+{
+    auto start{std::chrono::steady_clock::now()};
+    f();
+    std::chrono::duration<double, std::milli> elapsed{std::chrono::steady_clock::now() - start};
+    return elapsed.count();
+}
+
+/**
+ * @brief Genera le chiavi 0, ..., n - 1 in ordine casuale
+ *
+ * @param n è il numero di chiavi
+ * @param gen è il generatore di numeri casuali
+ * @return std::vector<uint> sono le chiavi mescolate
+ */
+std::vector<uint> shuffledKeys(uint n, std::mt19937 &gen)
+{
+    std::vector<uint> keys(n);
+    for (uint i{0}; i < n; ++i)
+    {
+        keys[i] = i;
+    }
+    std::shuffle(keys.begin(), keys.end(), gen);
+    return keys;
+}
+
+/**
+ * @brief Genera una sequenza di ricerche con distribuzione di Zipf (esponente 1) sulle chiavi fornite
+ * La chiave in posizione i ha probabilità proporzionale a 1 / (i + 1)
+ *
+ * @param keys sono le chiavi ordinate per popolarità
+ * @param queries è il numero di ricerche da generare
+ * @param gen è il generatore di numeri casuali
+ * @return std::vector<uint> sono le chiavi da cercare
+ */
+std::vector<uint> zipfQueries(const std::vector<uint> &keys, uint queries, std::mt19937 &gen)
+{
+    std::vector<double> weights(keys.size());
+    for (uint i{0}; i < keys.size(); ++i)
+    {
+        weights[i] = 1.0 / (i + 1);
+    }
+    std::discrete_distribution<uint> dist(weights.begin(), weights.end());
+    std::vector<uint> result(queries);
+    for (uint &q : result)
+    {
+        q = keys[dist(gen)];
+    }
+    return result;
+}
+
+void benchSplay()
+{
+    const uint n{100000};
+    const uint queries{1000000};
+    std::mt19937 gen(42);
+    std::vector<uint> keys{shuffledKeys(n, gen)};
+
+    bst<uint> plainTree;
+    splayBst<uint> splayTree;
+    splayBst<uint> sampledTree; // Splaying randomizzato: in media un accesso su 16
+    sampledTree.setSplayPeriod(16);
+    for (uint k : keys)
+    {
+        plainTree.insertValue(k);
+        splayTree.insertValue(k);
+        sampledTree.insertValue(k);
+    }
+
+    std::uniform_int_distribution<uint> uniform(0, n - 1);
+    std::vector<uint> uniformQueries(queries);
+    for (uint &q : uniformQueries)
+    {
+        q = uniform(gen);
+    }
+    std::vector<uint> hotKeys{shuffledKeys(n, gen)}; // La popolarità non dipende dal valore della chiave
+    std::vector<uint> skewedQueries{zipfQueries(hotKeys, queries, gen)};
+    std::uniform_int_distribution<uint> hotIndex(0, 299);
+    std::bernoulli_distribution hit(0.9);
+    std::vector<uint> hotQueries(queries); // Il 90% delle ricerche riguarda 300 chiavi calde
+    for (uint &q : hotQueries)
+    {
+        q = hit(gen) ? hotKeys[hotIndex(gen)] : uniform(gen);
+    }
+
+    std::cout << "bst vs splayBst (" << n << " chiavi, " << queries << " ricerche)" << std::endl;
+    const std::pair<const char *, std::vector<uint> *> workloads[] = {{"uniforme", &uniformQueries}, {"Zipf", &skewedQueries}, {"300 chiavi calde", &hotQueries}};
+    for (const auto &workload : workloads)
+    {
+        uint found{0};
+        double plainTime{measure([&]()
+                                 {
+                                     for (uint q : *workload.second)
+                                     {
+                                         found += plainTree.find(q) != nullptr;
+                                     }
+                                 })};
+        double splayTime{measure([&]()
+                                 {
+                                     for (uint q : *workload.second)
+                                     {
+                                         found += splayTree.find(q) != nullptr;
+                                     }
+                                 })};
+        double sampledTime{measure([&]()
+                                   {
+                                       for (uint q : *workload.second)
+                                       {
+                                           found += sampledTree.find(q) != nullptr;
+                                       }
+                                   })};
+        std::cout << "  " << workload.first << ": bst " << plainTime << " ms, splayBst " << splayTime
+                  << " ms, splayBst (1 splaying ogni 16 accessi) " << sampledTime << " ms (trovate " << found << ")" << std::endl;
+    }
+}
+
+void benchCompact()
+{
+    const uint n{200000};
+    const uint queries{1000000};
+    std::mt19937 gen(7);
+    std::vector<uint> keys{shuffledKeys(2 * n, gen)};
+
+    bst<uint> tree;
+    for (uint i{0}; i < n; ++i) // Inserimenti e cancellazioni alternati disperdono i nodi tra i chunk
+    {
+        tree.insertValue(keys[i]);
+        if (i % 2 == 1)
+        {
+            tree.deleteKey(keys[i / 2]);
+            tree.insertValue(keys[n + i]);
+        }
+    }
+    std::uniform_int_distribution<uint> uniform(0, 2 * n - 1);
+    std::vector<uint> searches(queries);
+    for (uint &q : searches)
+    {
+        q = uniform(gen);
+    }
+
+    auto run{[&](const char *label)
+             {
+                 unsigned long sum{0};
+                 double visitTime{measure([&]()
+                                          {
+                                              bst<uint> *last{tree.max()};
+                                              for (int repeat{0}; repeat < 10; ++repeat)
+                                              {
+                                                  for (bst<uint> *node{tree.min()}; node != last; node = node->successor())
+                                                  {
+                                                      sum += node->getKey();
+                                                  }
+                                              }
+                                          })};
+                 double searchTime{measure([&]()
+                                           {
+                                               for (uint q : searches)
+                                               {
+                                                   sum += tree.find(q) != nullptr;
+                                               }
+                                           })};
+                 std::cout << "  " << label << ": 10 visite " << visitTime << " ms, " << queries << " ricerche " << searchTime
+                           << " ms (checksum " << sum << ")" << std::endl;
+             }};
+
+    std::cout << "relayout() su un albero frammentato (" << tree.nodesCount() << " nodi)" << std::endl;
+    run("frammentato");
+    std::cout << "  compact(): " << measure([&]()
+                                             { tree.compact(); })
+              << " ms" << std::endl;
+    run("simmetrico");
+    tree.relayout(layoutOrder::vanEmdeBoas);
+    run("van Emde Boas");
+}
+
+/**
+ * @brief Misura inserimento, ricerca e visita di un albero con archi a indici
+ *
+ * @tparam TREE è il tipo di albero da misurare
+ * @param label è il nome dell'albero
+ * @param keys sono le chiavi da inserire
+ * @param searches sono le chiavi da cercare
+ * @param bytesPerNode è la memoria occupata da un nodo
+ */
+template <typename TREE>
+void benchIndexTree(const char *label, const std::vector<uint> &keys, const std::vector<uint> &searches, std::size_t bytesPerNode)
+{
+    TREE tree;
+    unsigned long sum{0};
+    double insertTime{measure([&]()
+                              {
+                                  for (uint k : keys)
+                                  {
+                                      tree.insertValue(k);
+                                  }
+                              })};
+    double searchTime{measure([&]()
+                              {
+                                  for (uint q : searches)
+                                  {
+                                      sum += tree.isPresent(q);
+                                  }
+                              })};
+    double visitTime{measure([&]()
+                             {
+                                 // Fino all'iteratore vuoto: end() di bst indica il massimo e lo escluderebbe
+                                 for (typename TREE::const_iterator it{tree.begin()}; it != typename TREE::const_iterator{}; ++it)
+                                 {
+                                     sum += it->getKey();
+                                 }
+                             })};
+    std::cout << "  " << label << ": " << bytesPerNode << " byte/nodo (" << 64.0 / bytesPerNode << " nodi per linea di cache), inserimento "
+              << insertTime << " ms, ricerca " << searchTime << " ms, visita " << visitTime << " ms (checksum " << sum << ")" << std::endl;
+}
+
+void benchIndex()
+{
+    const uint n{1000000};
+    std::mt19937 gen(11);
+    std::vector<uint> keys{shuffledKeys(n, gen)};
+    std::uniform_int_distribution<uint> uniform(0, 2 * n - 1);
+    std::vector<uint> searches(n);
+    for (uint &q : searches)
+    {
+        q = uniform(gen);
+    }
+
+    std::cout << "bst vs indexBst (" << n << " chiavi)" << std::endl;
+    benchIndexTree<bst<uint>>("bst (puntatori a 64 bit)", keys, searches, sizeof(bst<uint>));
+    benchIndexTree<indexBst<uint>>("indexBst (indici a 32 bit)", keys, searches, sizeof(indexNode<uint, true>));
+    benchIndexTree<indexBst<uint, std::greater<uint>, false>>("indexBst senza genitore", keys, searches, sizeof(indexNode<uint, false>));
+}
+
+void benchBuffered()
+{
+    const uint n{1000000};
+    std::mt19937 gen(13);
+    std::vector<uint> keys{shuffledKeys(n, gen)};
+
+    std::cout << "bst vs bufferedBst (" << n << " inserimenti)" << std::endl;
+    {
+        bst<uint> tree;
+        std::cout << "  bst: " << measure([&]()
+                                          {
+                                              for (uint k : keys)
+                                              {
+                                                  tree.insertValue(k);
+                                              }
+                                          })
+                  << " ms" << std::endl;
+    }
+    const std::size_t capacities[] = {1024, 16384, 262144};
+    for (std::size_t capacity : capacities)
+    {
+        bufferedBst<uint> tree(capacity);
+        uint hits{0};
+        double insertTime{measure([&]()
+                                  {
+                                      for (uint k : keys)
+                                      {
+                                          tree.insertValue(k);
+                                      }
+                                      tree.flush();
+                                  })};
+        for (uint i{0}; i < n; i += 1000) // Le ricerche restano corrette anche con il buffer non vuoto
+        {
+            hits += tree.isPresent(keys[i]);
+        }
+        std::cout << "  bufferedBst (buffer " << capacity << "): " << insertTime << " ms (trovate " << hits << ")" << std::endl;
+    }
+}
+
+void benchWeighted()
+{
+    const uint queries{1000000};
+    const uint sizes[] = {1000, 100000}; // Algoritmo di Knuth e approssimazione di Mehlhorn
+    for (uint n : sizes)
+    {
+        std::mt19937 gen(17);
+        weightedBst<uint> tree;
+        for (uint k : shuffledKeys(n, gen))
+        {
+            tree.insertValue(k);
+        }
+        std::vector<uint> skewedQueries{zipfQueries(shuffledKeys(n, gen), queries, gen)};
+        for (uint q : skewedQueries) // Gli accessi registrati durante il riscaldamento definiscono la distribuzione
+        {
+            tree.find(q);
+        }
+        auto search{[&]()
+                    {
+                        uint found{0};
+                        for (uint q : skewedQueries)
+                        {
+                            found += tree.bst<uint>::find(q) != nullptr;
+                        }
+                        return found;
+                    }};
+        uint found{0};
+        double beforeTime{measure([&]()
+                                  { found += search(); })};
+        std::pair<double, double> cost;
+        double rebuildTime{measure([&]()
+                                   { cost = tree.rebuildOptimal(); })};
+        double afterTime{measure([&]()
+                                 { found += search(); })};
+        std::cout << "weightedBst (" << n << " chiavi, " << queries << " ricerche Zipf)" << std::endl
+                  << "  confronti attesi " << cost.first << " -> " << cost.second << ", ricerche " << beforeTime << " ms -> " << afterTime
+                  << " ms, ricostruzione " << rebuildTime << " ms (trovate " << found << ")" << std::endl;
+    }
+
+    // Chiavi con gli stessi 12 bit bassi: senza rimescolare l'hash i contatori finirebbero tutti nello stesso gruppo della tabella
+    const uint strided{200000};
+    std::mt19937 gen(17);
+    std::vector<uint> stridedKeys{shuffledKeys(strided, gen)};
+    for (uint &k : stridedKeys)
+    {
+        k *= 4096;
+    }
+    weightedBst<uint> stridedTree;
+    double recordTime{measure([&]()
+                              {
+                                  for (uint round{0}; round < 5; ++round)
+                                  {
+                                      for (uint k : stridedKeys)
+                                      {
+                                          stridedTree.recordAccess(k);
+                                      }
+                                  }
+                              })};
+    std::cout << "weightedBst con " << strided << " chiavi multiple di 4096: " << 5 * strided << " accessi registrati in "
+              << recordTime << " ms" << std::endl;
+}
+
+void benchIndexed()
+{
+    const uint n{1000000};
+    std::mt19937 gen(19);
+    std::vector<uint> keys{shuffledKeys(n, gen)};
+    std::uniform_int_distribution<uint> uniform(0, 2 * n - 1);
+    std::vector<uint> searches(n);
+    for (uint &q : searches)
+    {
+        q = uniform(gen);
+    }
+
+    bst<uint> plainTree;
+    indexedBst<uint> indexedTree;
+    double plainInsert{measure([&]()
+                               {
+                                   for (uint k : keys)
+                                   {
+                                       plainTree.insertValue(k);
+                                   }
+                               })};
+    double indexedInsert{measure([&]()
+                                 {
+                                     for (uint k : keys)
+                                     {
+                                         indexedTree.insertValue(k);
+                                     }
+                                 })};
+    uint found{0};
+    double plainSearch{measure([&]()
+                               {
+                                   for (uint q : searches)
+                                   {
+                                       found += plainTree.find(q) != nullptr;
+                                   }
+                               })};
+    double indexedSearch{measure([&]()
+                                 {
+                                     for (uint q : searches)
+                                     {
+                                         found += indexedTree.contains(q);
+                                     }
+                                 })};
+    std::cout << "bst vs indexedBst (" << n << " chiavi)" << std::endl
+              << "  bst: inserimento " << plainInsert << " ms, ricerca " << plainSearch << " ms" << std::endl
+              << "  indexedBst: inserimento " << indexedInsert << " ms, ricerca " << indexedSearch << " ms (trovate " << found << ")" << std::endl;
+
+    // Chiavi con gli stessi 12 bit bassi: senza rimescolare l'hash finirebbero tutte nello stesso gruppo della tabella
+    const uint strided{200000};
+    indexedBst<uint> stridedTree;
+    std::vector<uint> stridedKeys{shuffledKeys(strided, gen)};
+    for (uint &k : stridedKeys)
+    {
+        k *= 4096;
+    }
+    double stridedInsert{measure([&]()
+                                 {
+                                     for (uint k : stridedKeys)
+                                     {
+                                         stridedTree.insertValue(k);
+                                     }
+                                 })};
+    found = 0;
+    double stridedSearch{measure([&]()
+                                 {
+                                     for (uint k : stridedKeys)
+                                     {
+                                         found += stridedTree.contains(k);
+                                     }
+                                 })};
+    std::cout << "  indexedBst con " << strided << " chiavi multiple di 4096: inserimento " << stridedInsert << " ms, ricerca "
+              << stridedSearch << " ms (trovate " << found << ")" << std::endl;
+}
+
+void benchFiltered()
+{
+    const uint n{1000000};
+    const uint queries{1000000};
+    std::mt19937 gen(23);
+    std::vector<uint> keys{shuffledKeys(n, gen)};
+    for (uint &k : keys) // Le chiavi sono i multipli di 10: le ricerche senza esito sono sparse tra le chiavi
+    {
+        k *= 10;
+    }
+    std::uniform_int_distribution<uint> uniform(0, 10 * n - 1); // Circa il 90% delle ricerche non ha esito
+    std::vector<uint> searches(queries);
+    for (uint &q : searches)
+    {
+        q = uniform(gen);
+    }
+
+    bst<uint> plainTree;
+    for (uint k : keys)
+    {
+        plainTree.insertValue(k);
+    }
+    uint found{0};
+    double plainTime{measure([&]()
+                             {
+                                 for (uint q : searches)
+                                 {
+                                     found += plainTree.isPresent(q);
+                                 }
+                             })};
+    std::cout << "bst vs filteredBst (" << n << " chiavi, " << queries << " ricerche, 90% senza esito)" << std::endl
+              << "  bst: " << plainTime << " ms (trovate " << found << ")" << std::endl;
+    const double rates[] = {0.01, 0.001};
+    for (double rate : rates)
+    {
+        filteredBst<uint> filteredTree(n, rate);
+        for (uint k : keys)
+        {
+            filteredTree.insertValue(k);
+        }
+        found = 0;
+        double filteredTime{measure([&]()
+                                    {
+                                        for (uint q : searches)
+                                        {
+                                            found += filteredTree.isPresent(q);
+                                        }
+                                    })};
+        std::cout << "  filteredBst (falsi positivi " << rate << ", filtro " << filteredTree.filterBytes() / 1024 << " KiB): " << filteredTime
+                  << " ms (trovate " << found << ")" << std::endl;
+    }
+}
+
+/**
+ * @brief Misura le ricerche su un'istantanea delle chiavi
+ *
+ * @tparam F è il tipo della funzione di ricerca
+ * @param label è il nome della struttura
+ * @param searches sono le chiavi da cercare
+ * @param contains restituisce true se la chiave è presente
+ */
+template <typename F>
+void benchLookup(const char *label, const std::vector<uint> &searches, F contains)
+{
+    uint found{0};
+    double time{measure([&]()
+                        {
+                            for (uint q : searches)
+                            {
+                                found += contains(q);
+                            }
+                        })};
+    std::cout << "  " << label << ": " << time << " ms (trovate " << found << ")" << std::endl;
+}
+
+/**
+ * @brief Confronta le ricerche sulle istantanee di n chiavi casuali
+ *
+ * @tparam N è il numero di chiavi di staticBst (0 se non si misura staticBst, che si ordina in O(N²))
+ * @param n è il numero di chiavi
+ */
+template <std::size_t N>
+void benchSnapshots(uint n)
+{
+    const uint queries{1000000};
+    std::mt19937 gen(29);
+    std::vector<uint> keys(n);
+    for (uint &k : keys)
+    {
+        k = gen();
+    }
+    std::vector<uint> searches(queries);
+    for (uint i{0}; i < queries; ++i) // Metà delle ricerche ha esito
+    {
+        searches[i] = i % 2 == 0 ? keys[gen() % n] : gen();
+    }
+
+    bst<uint> tree;
+    for (uint k : keys)
+    {
+        tree.insertValue(k);
+    }
+    tree.relayout(layoutOrder::vanEmdeBoas);
+    learnedIndex<uint> learned(tree);
+    std::vector<uint> sorted{learnedIndex<uint>::inorderKeys(tree)};
+
+    std::cout << "learnedIndex (" << n << " chiavi, " << queries << " ricerche, finestra massima " << learned.maxError() << ", modelli "
+              << learned.modelBytes() << " byte)" << std::endl;
+    benchLookup("bst (layout di van Emde Boas)", searches, [&](uint q)
+                { return tree.find(q) != nullptr; });
+    benchLookup("array ordinato", searches, [&](uint q)
+                { return std::binary_search(sorted.begin(), sorted.end(), q); });
+    if constexpr (N != 0)
+    {
+        std::array<uint, N> input;
+        std::copy(keys.begin(), keys.end(), input.begin());
+        std::unique_ptr<staticBst<uint, N>> eytzinger{new staticBst<uint, N>(input)};
+        benchLookup("staticBst (Eytzinger)", searches, [&](uint q)
+                    { return eytzinger->contains(q); });
+    }
+    benchLookup("learnedIndex", searches, [&](uint q)
+                { return learned.contains(q); });
+}
+
+void benchLearned()
+{
+    benchSnapshots<4096>(4096);
+    benchSnapshots<0>(1000000);
+}
+
+void benchMerkle()
+{
+    const uint n{1000000};
+    const uint differences{10};
+    std::mt19937 gen(31);
+    std::vector<uint> keys{shuffledKeys(n, gen)};
+
+    bst<uint> plainTree;
+    merkleBst<uint> replicaA, replicaB;
+    double plainInsert{measure([&]()
+                               {
+                                   for (uint k : keys)
+                                   {
+                                       plainTree.insertValue(k);
+                                   }
+                               })};
+    double merkleInsert{measure([&]()
+                                {
+                                    for (uint k : keys)
+                                    {
+                                        replicaA.insertValue(k);
+                                    }
+                                })};
+    for (uint k : shuffledKeys(n, gen)) // La seconda replica riceve le stesse chiavi in un altro ordine, tranne alcune
+    {
+        if (k % (n / differences) != 0)
+        {
+            replicaB.insertValue(k);
+        }
+    }
+
+    std::size_t found{0};
+    double fullTime{measure([&]()
+                            {
+                                auto *a{replicaA.min()}, *b{replicaB.min()};
+                                auto *lastA{replicaA.max()}, *lastB{replicaB.max()};
+                                while (a != nullptr && b != nullptr) // Fusione delle due visite simmetriche
+                                {
+                                    if (a->getKey() == b->getKey())
+                                    {
+                                        a = a == lastA ? nullptr : a->successor();
+                                        b = b == lastB ? nullptr : b->successor();
+                                    }
+                                    else if (a->getKey() < b->getKey())
+                                    {
+                                        ++found;
+                                        a = a == lastA ? nullptr : a->successor();
+                                    }
+                                    else
+                                    {
+                                        ++found;
+                                        b = b == lastB ? nullptr : b->successor();
+                                    }
+                                }
+                            })};
+    std::pair<std::vector<uint>, std::vector<uint>> result;
+    double diffTime{measure([&]()
+                            { result = merkleBst<uint>::diff(replicaA, replicaB); })};
+    std::cout << "merkleBst (" << n << " chiavi, " << differences << " differenze)" << std::endl
+              << "  inserimento: bst " << plainInsert << " ms, merkleBst " << merkleInsert << " ms" << std::endl
+              << "  confronto completo " << fullTime << " ms (" << found << " differenze), diff() " << diffTime << " ms ("
+              << result.first.size() + result.second.size() << " differenze)" << std::endl;
+}
+
+void benchLogged()
+{
+    const uint n{1000000};
+    const uint durable{2000}; // Con syncPolicy::always ogni inserimento attende il disco
+    std::mt19937 gen(37);
+    std::vector<uint> keys{shuffledKeys(n, gen)};
+    const std::string path{std::filesystem::temp_directory_path() / "benchLoggedBst"};
+    auto clean{[&]()
+               {
+                   for (uint g{0}; g < 4; ++g)
+                   {
+                       std::remove((path + ".log." + std::to_string(g)).c_str());
+                   }
+                   std::remove((path + ".snapshot").c_str());
+               }};
+
+    std::cout << "bst vs loggedBst (" << n << " inserimenti)" << std::endl;
+    {
+        bst<uint> tree;
+        std::cout << "  bst: " << measure([&]()
+                                          {
+                                              for (uint k : keys)
+                                              {
+                                                  tree.insertValue(k);
+                                              }
+                                          })
+                  << " ms" << std::endl;
+    }
+    const std::pair<const char *, syncPolicy> policies[] = {{"never", syncPolicy::never}, {"group", syncPolicy::group}};
+    for (const auto &policy : policies)
+    {
+        clean();
+        loggedBst<uint> tree(path, policy.second);
+        double insertTime{measure([&]()
+                                  {
+                                      for (uint k : keys)
+                                      {
+                                          tree.insertValue(k);
+                                      }
+                                      tree.sync();
+                                  })};
+        std::cout << "  loggedBst (" << policy.first << "): " << insertTime << " ms" << std::endl;
+    }
+    double replayTime{measure([&]()
+                              { loggedBst<uint> tree(path); })};
+    double checkpointTime, snapshotTime;
+    {
+        loggedBst<uint> tree(path);
+        checkpointTime = measure([&]()
+                                 { tree.checkpoint(); });
+        snapshotTime = measure([&]()
+                               { tree.waitCheckpoint(); });
+    }
+    double loadTime{measure([&]()
+                            { loggedBst<uint> tree(path); })};
+    std::cout << "  ripristino dal log " << replayTime << " ms, checkpoint " << checkpointTime << " ms (+ " << snapshotTime
+              << " ms in background), ripristino dall'istantanea " << loadTime << " ms" << std::endl;
+
+    clean();
+    {
+        loggedBst<uint> tree(path, syncPolicy::always);
+        double alwaysTime{measure([&]()
+                                  {
+                                      for (uint i{0}; i < durable; ++i)
+                                      {
+                                          tree.insertValue(keys[i]);
+                                      }
+                                  })};
+        std::cout << "  loggedBst (always): " << alwaysTime / durable * 1000 << " us per inserimento" << std::endl;
+    }
+    clean();
+}
+
+void benchAggregate()
+{
+    const uint n{1000000};
+    const uint queries{100};
+    using sumTree = bst<uint, std::greater<uint>, monoidAugmentation<uint, keyProjection, sumMonoid<unsigned long>>>;
+    std::mt19937 gen(41);
+    std::vector<uint> keys{shuffledKeys(n, gen)};
+    std::uniform_int_distribution<uint> uniform(0, n - 1);
+    std::vector<std::pair<uint, uint>> ranges(queries);
+    for (auto &range : ranges) // Intervalli di ampiezza media n / 3
+    {
+        uint a{uniform(gen)}, b{uniform(gen)};
+        range = {std::min(a, b), std::max(a, b)};
+    }
+
+    bst<uint> plainTree;
+    sumTree augmentedTree;
+    double plainInsert{measure([&]()
+                               {
+                                   for (uint k : keys)
+                                   {
+                                       plainTree.insertValue(k);
+                                   }
+                               })};
+    double augmentedInsert{measure([&]()
+                                   {
+                                       for (uint k : keys)
+                                       {
+                                           augmentedTree.insertValue(k);
+                                       }
+                                   })};
+    unsigned long walkSum{0}, aggregateSum{0};
+    double walkTime{measure([&]()
+                            {
+                                for (const auto &range : ranges)
+                                {
+                                    bst<uint> *start{nullptr}; // Prima chiave non minore dell'estremo sinistro
+                                    for (bst<uint> *node{&plainTree}; node != nullptr;)
+                                    {
+                                        if (node->getKey() < range.first)
+                                        {
+                                            node = node->getRight();
+                                        }
+                                        else
+                                        {
+                                            start = node;
+                                            node = node->getLeft();
+                                        }
+                                    }
+                                    bst<uint> *last{plainTree.max()};
+                                    for (bst<uint> *node{start}; node != nullptr && node->getKey() <= range.second;
+                                         node = node == last ? nullptr : node->successor())
+                                    {
+                                        walkSum += node->getKey();
+                                    }
+                                }
+                            })};
+    double aggregateTime{measure([&]()
+                                 {
+                                     for (const auto &range : ranges)
+                                     {
+                                         aggregateSum += augmentedTree.aggregate(range.first, range.second);
+                                     }
+                                 })};
+    std::cout << "bst::aggregate() (" << n << " chiavi, " << queries << " somme su intervalli)" << std::endl
+              << "  inserimento: bst " << plainInsert << " ms, bst con aumento " << augmentedInsert << " ms" << std::endl
+              << "  visita dell'intervallo " << walkTime << " ms (somma " << walkSum << "), aggregate() " << aggregateTime
+              << " ms (somma " << aggregateSum << ")" << std::endl;
+}
+
+void benchInterval()
+{
+    const uint n{1000000};
+    const uint queries{1000};
+    std::mt19937 gen(43);
+    std::uniform_int_distribution<uint> start(0, 100000000);
+    std::exponential_distribution<double> length(1.0 / 1000); // Intervalli lunghi in media 1000
+    std::vector<interval<uint>> ranges(n);
+    for (interval<uint> &range : ranges)
+    {
+        range.low = start(gen);
+        range.high = range.low + (uint)length(gen);
+    }
+    std::vector<uint> windows(queries);
+    for (uint &x : windows)
+    {
+        x = start(gen);
+    }
+
+    intervalTree<uint> tree;
+    double insertTime{measure([&]()
+                              {
+                                  for (const interval<uint> &range : ranges)
+                                  {
+                                      tree.insertValue(range);
+                                  }
+                              })};
+    std::size_t scanFound{0}, treeFound{0};
+    double scanTime{measure([&]()
+                            {
+                                for (uint x : windows)
+                                {
+                                    for (const interval<uint> &range : ranges)
+                                    {
+                                        scanFound += range.low <= x + 10000 && range.high >= x;
+                                    }
+                                }
+                            })};
+    double treeTime{measure([&]()
+                            {
+                                for (uint x : windows)
+                                {
+                                    treeFound += tree.overlaps(x, x + 10000).size();
+                                }
+                            })};
+    std::cout << "intervalTree (" << n << " intervalli, " << queries << " ricerche di sovrapposizioni)" << std::endl
+              << "  inserimento " << insertTime << " ms, scansione lineare " << scanTime << " ms (trovati " << scanFound
+              << "), overlaps() " << treeTime << " ms (trovati " << treeFound << ")" << std::endl;
+}
+
+/**
+ * @brief Misura inserimenti, ricerche e cancellazioni di un albero con l'interfaccia di bst
+ *
+ * @tparam TREE è il tipo di albero da misurare
+ * @param label è il nome dell'albero
+ * @param keys sono le chiavi da inserire (e poi eliminare)
+ * @param searches sono le chiavi da cercare
+ */
+template <typename TREE>
+void benchOrdered(const char *label, const std::vector<uint> &keys, const std::vector<uint> &searches)
+{
+    TREE tree;
+    uint found{0};
+    double insertTime{measure([&]()
+                              {
+                                  for (uint k : keys)
+                                  {
+                                      tree.insertValue(k);
+                                  }
+                              })};
+    double searchTime{measure([&]()
+                              {
+                                  for (uint q : searches)
+                                  {
+                                      found += tree.isPresent(q);
+                                  }
+                              })};
+    double deleteTime{measure([&]()
+                              {
+                                  for (std::size_t i{0}; i < keys.size(); i += 2)
+                                  {
+                                      tree.deleteKey(keys[i]);
+                                  }
+                              })};
+    std::cout << "  " << label << ": inserimento " << insertTime << " ms, ricerca " << searchTime << " ms, cancellazione di metà delle chiavi "
+              << deleteTime << " ms (trovate " << found << ")" << std::endl;
+}
+
+void benchBtree()
+{
+    const uint n{1000000};
+    std::mt19937 gen(47);
+    std::vector<uint> keys{shuffledKeys(n, gen)};
+    std::uniform_int_distribution<uint> uniform(0, 2 * n - 1);
+    std::vector<uint> searches(n);
+    for (uint &q : searches)
+    {
+        q = uniform(gen);
+    }
+
+    std::cout << "bst vs btree (" << n << " chiavi)" << std::endl;
+    benchOrdered<bst<uint>>("bst", keys, searches);
+    benchOrdered<btree<uint, std::greater<uint>, 64>>("btree (nodi da 64 byte)", keys, searches);
+    benchOrdered<btree<uint, std::greater<uint>, 128>>("btree (nodi da 128 byte)", keys, searches);
+    benchOrdered<btree<uint>>("btree (nodi da 256 byte)", keys, searches);
+}
+
+/**
+ * @brief Esegue una funzione su più thread, ciascuno con la propria parte delle chiavi
+ *
+ * @tparam F è il tipo della funzione eseguita per ogni chiave
+ * @param keys sono le chiavi
+ * @param threads è il numero di thread
+ * @param f è la funzione da eseguire
+ * @return double è il tempo impiegato in millisecondi
+ */
+template <typename F>
+double measureThreads(const std::vector<uint> &keys, uint threads, F f)
+{
+    return measure([&]()
+                   {
+                       std::vector<std::thread> workers;
+                       for (uint t{0}; t < threads; ++t)
+                       {
+                           workers.emplace_back([&, t]()
+                                                {
+                                                    for (std::size_t i{t}; i < keys.size(); i += threads)
+                                                    {
+                                                        f(keys[i]);
+                                                    }
+                                                });
+                       }
+                       for (std::thread &worker : workers)
+                       {
+                           worker.join();
+                       }
+                   });
+}
+
+void benchSharded()
+{
+    const uint n{1000000};
+    std::mt19937 gen(53);
+    std::vector<uint> keys{shuffledKeys(n, gen)};
+
+    // Con un solo core i thread si alternano e i tempi misurano solo il costo della sincronizzazione: l'accelerazione
+    // rispetto a un thread è significativa solo su una macchina con almeno tanti core quanti thread
+    std::cout << "bst con mutex vs shardedBst (" << n << " inserimenti, " << std::thread::hardware_concurrency() << " core)" << std::endl;
+    double lockedBase{0}, shardedBase{0};
+    for (uint threads : {1u, 2u, 4u, 8u})
+    {
+        bst<uint> tree;
+        std::mutex lock;
+        double lockedTime{measureThreads(keys, threads, [&](uint k)
+                                         {
+                                             std::lock_guard<std::mutex> guard{lock};
+                                             tree.insertValue(k);
+                                         })};
+        shardedBst<uint> sharded(threads * 4);
+        double shardedTime{measureThreads(keys, threads, [&](uint k)
+                                          { sharded.insertValue(k); })};
+        if (threads == 1)
+        {
+            lockedBase = lockedTime;
+            shardedBase = shardedTime;
+        }
+        std::cout << "  " << threads << " thread: bst con mutex " << lockedTime << " ms (x" << lockedBase / lockedTime << "), shardedBst ("
+                  << threads * 4 << " shard) " << shardedTime << " ms (x" << shardedBase / shardedTime << ")" << std::endl;
+    }
+
+    // Chiavi crescenti: ogni nuova chiave finisce nell'ultimo shard, che viene alleggerito spostando le chiavi di bordo
+    std::vector<uint> ascending(n / 20);
+    for (uint i{0}; i < ascending.size(); ++i)
+    {
+        ascending[i] = i;
+    }
+    for (uint threads : {1u, 4u})
+    {
+        shardedBst<uint> sharded(16);
+        double time{measureThreads(ascending, threads, [&](uint k)
+                                   { sharded.insertValue(k); })};
+        std::vector<std::size_t> sizes{sharded.shardSizes()};
+        std::cout << "  chiavi crescenti, " << threads << " thread: " << time << " ms, shard da " << *std::min_element(sizes.begin(), sizes.end())
+                  << " a " << *std::max_element(sizes.begin(), sizes.end()) << " chiavi" << std::endl;
+    }
+}
+
+void benchBatch()
+{
+    const uint n{1000000};
+    const uint batchSize{500000};
+    std::mt19937 gen(59);
+    std::vector<uint> keys{shuffledKeys(n + batchSize, gen)};
+    std::vector<uint> batch(keys.begin() + n, keys.end());
+
+    std::cout << "insertValue() vs insertBatch() (" << batchSize << " chiavi in un albero di " << n << ")" << std::endl;
+    {
+        bst<uint> tree;
+        tree.insertBatch(keys.begin(), keys.begin() + n);
+        std::cout << "  insertValue(): " << measure([&]()
+                                                    {
+                                                        for (uint k : batch)
+                                                        {
+                                                            tree.insertValue(k);
+                                                        }
+                                                    })
+                  << " ms" << std::endl;
+    }
+    for (uint threads : {1u, 2u, 4u})
+    {
+        bst<uint> tree;
+        tree.insertBatch(keys.begin(), keys.begin() + n);
+        std::cout << "  insertBatch() con " << threads << " thread: " << measure([&]()
+                                                                           { tree.insertBatch(batch.begin(), batch.end(), threads); })
+                  << " ms" << std::endl;
+    }
+}
+
+void benchVeb()
+{
+    const uint n{1000000};
+    std::mt19937 gen(61);
+    std::vector<uint> keys(n);
+    std::uniform_int_distribution<uint> uniform;
+    for (uint &k : keys)
+    {
+        k = uniform(gen);
+    }
+    std::vector<uint> searches(n);
+    for (std::size_t i{0}; i < n; ++i)
+    {
+        searches[i] = i % 2 == 0 ? keys[(i * 7919) % n] : uniform(gen); // Metà delle ricerche ha esito positivo
+    }
+
+    std::cout << "bst vs btree vs vebTree (" << n << " chiavi a 32 bit)" << std::endl;
+    benchOrdered<bst<uint>>("bst", keys, searches);
+    benchOrdered<btree<uint>>("btree", keys, searches);
+    benchOrdered<vebTree<uint>>("vebTree", keys, searches);
+    vebTree<uint> tree(keys.data(), n);
+    uint64_t sum{0};
+    double successorTime{measure([&]()
+                                 {
+                                     for (uint q : searches)
+                                     {
+                                         auto it{tree.successor(q)};
+                                         sum += it == tree.end() ? 0 : it->getKey();
+                                     }
+                                 })};
+    std::cout << "  vebTree::successor(): " << successorTime << " ms (somma " << sum << ")" << std::endl;
+}
+
+void benchString()
+{
+    const uint n{1000000};
+    std::mt19937 gen(67);
+    const char *prefixes[] = {"", "San ", "Santa ", "Villa "}; // Come nei nomi delle città, molte chiavi condividono l'inizio
+    std::vector<std::string> names(n);
+    for (std::string &name : names)
+    {
+        name = prefixes[gen() % 4];
+        for (uint length{6 + static_cast<uint>(gen() % 14)}; length > 0; --length)
+        {
+            name.push_back('a' + gen() % 26);
+        }
+    }
+    std::vector<std::string> searches(n);
+    for (std::size_t i{0}; i < n; ++i)
+    {
+        searches[i] = names[(i * 7919) % n];
+        if (i % 2 == 1) // Metà delle ricerche senza esito
+        {
+            searches[i].back() = 'A';
+        }
+    }
+
+    std::cout << "bst<std::string> vs stringBst (" << n << " nomi)" << std::endl;
+    uint found{0};
+    {
+        bst<std::string> tree;
+        double insertTime{measure([&]()
+                                  {
+                                      for (const std::string &name : names)
+                                      {
+                                          tree.insertValue(name);
+                                      }
+                                  })};
+        double searchTime{measure([&]()
+                                  {
+                                      for (const std::string &name : searches)
+                                      {
+                                          found += tree.find(name) != nullptr;
+                                      }
+                                  })};
+        std::cout << "  bst<std::string>: inserimento " << insertTime << " ms, ricerca " << searchTime << " ms (trovati " << found << ")" << std::endl;
+    }
+    found = 0;
+    {
+        stringBst tree;
+        double insertTime{measure([&]()
+                                  {
+                                      for (const std::string &name : names)
+                                      {
+                                          tree.insertValue(name);
+                                      }
+                                  })};
+        double searchTime{measure([&]()
+                                  {
+                                      for (const std::string &name : searches)
+                                      {
+                                          found += tree.isPresent(name);
+                                      }
+                                  })};
+        std::cout << "  stringBst: inserimento " << insertTime << " ms, ricerca " << searchTime << " ms (trovati " << found << "), arena "
+                  << tree.arenaBytes() / 1024 << " KiB" << std::endl;
+    }
+}
+
+void benchProjected()
+{
+    const uint n{1000000};
+    std::mt19937 gen(71);
+    std::vector<uint> populations{shuffledKeys(n, gen)};
+    std::vector<City> cities;
+    cities.reserve(n);
+    for (uint p : populations)
+    {
+        cities.emplace_back("Comune di " + std::to_string(p) + " abitanti", p); // Nome oltre la small string optimization
+    }
+    std::uniform_int_distribution<uint> uniform(0, 2 * n - 1);
+    std::vector<uint> searches(n);
+    for (uint &q : searches)
+    {
+        q = uniform(gen);
+    }
+
+    std::vector<City> probes; // Le chiavi di ricerca di bst<City> sono costruite fuori dalle misure
+    probes.reserve(n);
+    for (uint q : searches)
+    {
+        probes.emplace_back("", q);
+    }
+
+    std::cout << "bst<City> vs projectedBst<City, &City::getPopulation> (" << n << " città, nodi da " << sizeof(bst<City>) << " e "
+              << sizeof(projectedBst<City, &City::getPopulation>::node_type) << " byte)" << std::endl;
+    bst<City> plain;
+    projectedBst<City, &City::getPopulation> projected;
+    double plainInsert{measure([&]()
+                               {
+                                   for (const City &city : cities)
+                                   {
+                                       plain.insertValue(city);
+                                   }
+                               })};
+    double projectedInsert{measure([&]()
+                                   {
+                                       for (const City &city : cities)
+                                       {
+                                           projected.insertValue(city);
+                                       }
+                                   })};
+    // Le ricerche sui due alberi si alternano per 5 turni e si riporta il tempo migliore di ciascuno,
+    // così il rumore della macchina non favorisce l'albero misurato per primo
+    uint plainFound{0}, projectedFound{0};
+    double plainSearch{0}, projectedSearch{0};
+    for (uint round{0}; round < 5; ++round)
+    {
+        plainFound = projectedFound = 0;
+        double time{measure([&]()
+                            {
+                                for (const City &probe : probes)
+                                {
+                                    plainFound += plain.find(probe) != nullptr;
+                                }
+                            })};
+        plainSearch = round == 0 ? time : std::min(plainSearch, time);
+        time = measure([&]()
+                       {
+                           for (uint q : searches)
+                           {
+                               projectedFound += projected.find(q) != nullptr;
+                           }
+                       });
+        projectedSearch = round == 0 ? time : std::min(projectedSearch, time);
+    }
+    std::cout << "  bst<City>: inserimento " << plainInsert << " ms, ricerca " << plainSearch << " ms (migliore di 5, trovate " << plainFound << ")" << std::endl;
+    std::cout << "  projectedBst: inserimento " << projectedInsert << " ms, ricerca " << projectedSearch << " ms (migliore di 5, trovate " << projectedFound << ")" << std::endl;
+}
+
+void benchLazy()
+{
+    const uint n{1000000};
+    std::mt19937 gen(73);
+    std::vector<uint> keys{shuffledKeys(n, gen)};
+    std::vector<uint> deletions(keys.begin(), keys.begin() + 3 * n / 5); // Più di ogni soglia: le ricostruzioni sono comprese
+    std::shuffle(deletions.begin(), deletions.end(), gen);
+
+    std::cout << "bst::deleteKey() vs lazyBst::deleteKey() (" << deletions.size() << " cancellazioni su " << n << " chiavi)" << std::endl;
+    double worst{0}; // cancellazione singola più lenta (ms)
+    auto timedDelete{[&worst](auto &tree, uint k)
+                     {
+                         auto start{std::chrono::steady_clock::now()};
+                         tree.deleteKey(k);
+                         std::chrono::duration<double, std::milli> elapsed{std::chrono::steady_clock::now() - start};
+                         worst = std::max(worst, elapsed.count());
+                     }};
+    uint found{0};
+    {
+        bst<uint> tree;
+        for (uint k : keys)
+        {
+            tree.insertValue(k);
+        }
+        double deleteTime{measure([&]()
+                                  {
+                                      for (uint k : deletions)
+                                      {
+                                          timedDelete(tree, k);
+                                      }
+                                  })};
+        double searchTime{measure([&]()
+                                  {
+                                      for (uint k : keys)
+                                      {
+                                          found += tree.isPresent(k);
+                                      }
+                                  })};
+        std::cout << "  bst: cancellazione " << deleteTime << " ms (la più lenta " << worst << " ms), ricerca " << searchTime << " ms (trovate "
+                  << found << ")" << std::endl;
+    }
+    for (double threshold : {0.1, 0.25, 0.5})
+    {
+        found = 0;
+        worst = 0;
+        lazyBst<uint> tree(threshold);
+        for (uint k : keys)
+        {
+            tree.insertValue(k);
+        }
+        double deleteTime{measure([&]()
+                                  {
+                                      for (uint k : deletions)
+                                      {
+                                          timedDelete(tree, k);
+                                      }
+                                  })};
+        double searchTime{measure([&]()
+                                  {
+                                      for (uint k : keys)
+                                      {
+                                          found += tree.isPresent(k);
+                                      }
+                                  })};
+        std::cout << "  lazyBst (soglia " << threshold << "): cancellazione " << deleteTime << " ms (la più lenta " << worst << " ms), ricerca "
+                  << searchTime << " ms (trovate " << found << ", tombstone " << tree.tombstoneCount() << ")" << std::endl;
+    }
+}
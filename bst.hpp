@@ -4,70 +4,1114 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <utility>
+#include <functional>
 #include <math.h>
 
+#include <algorithm>
+#include <thread>
+
 #include "bstException.hpp"
 #include "accessory.hpp"
+#include "nodePool.hpp"
+#include "workerPool.hpp"
+#include "augmentation.hpp"
+
+/**
+ * @brief Ordine con cui bst::relayout() dispone i nodi in memoria
+ */
+enum class layoutOrder
+{
+    inorder,    // ordine della visita simmetrica (visite e successor() scorrono la memoria in modo sequenziale)
+    vanEmdeBoas // ordine di van Emde Boas (ogni sottoalbero di altezza h/2 occupa memoria contigua)
+};
+
+template <typename T, typename CMP>
+class multiBst;
+
+template <typename T, typename CMP>
+class splayBst;
+
+template <typename T, typename CMP>
+class balancedBst;
+
+template <typename T, typename CMP>
+class bufferedBst;
+
+template <typename T, typename CMP, typename HASH>
+class weightedBst;
+
+template <typename T, typename CMP, typename HASH>
+class indexedBst;
+
+template <typename T, typename CMP, typename HASH>
+class filteredBst;
+
+template <typename T, typename CMP, typename HASH>
+class merkleBst;
+
+template <typename T, typename CMP>
+class loggedBst;
+
+template <typename V>
+class intervalTree;
+
+template <typename T, typename CMP>
+class shardedBst;
+
+template <typename T, typename CMP>
+class lazyBst;
+
+/**
+ * @class bst
+ *
+ * @brief Classe per la rappresentazione degli alberi binari di ricerca.
+ * Un albero è definito in modo ricorsivo dal valore della sua radice, dal puntatore al nodo genitore (se è un sottoalbero)
+ * e dai puntatori ai suoi sottoalberi sinistro e destro.
+ *
+ * Nota: in questa classe i termini nodo e albero vengono interscambiati. Nonostante siano entità diverse
+ * (un albero è composto da nodi), per come è stata definita la classe un puntatore a bst<T, CMP, AUG> indica
+ * sia un nodo, perché bst<T, CMP, AUG> ha un valore key che è il valore del nodo, sia un albero, perché contiene
+ * i puntatori ai nodi (o appunto alberi) figli. Un oggetto bst<T, CMP, AUG> si può quindi pensare o come a un albero
+ * o coma a un nodo più i suoi archi.
+ *
+ * @tparam T è il tipo di dato delle chiavi associate ai nodi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ * @tparam AUG è l'aumento mantenuto in ogni nodo (vedi augmentation.hpp; noAugmentation non ha alcun costo)
+ *
+ * @param key è il valore dela chiave associata al nodo
+ * @param parent è il puntatore al genitore del nodo
+ * @param left è il puntatore al figlio sinistro del nodo
+ * @param right è il untatore al figlio destro del nodo
+ * @param empty indica la presenza di un valore nel nodo (true se non è presente, false se è presente) per classificare i nodo vuoti
+ * @param count è il numero di occorrenze della chiave memorizzate nel nodo (sempre 1 tranne che in modalità multiset, vedi multiBst)
+ * @param cmp è la relazione d'ordine da utilizzare. È necessario utilizzare un comparatore che esprima la relazione
+ * d'ordine di "maggiore" se si vuole ottenere un albero binario ordinato correttamente
+ * @param aug è il valore dell'aumento calcolato sul sottoalbero di cui il nodo è radice
+ */
+template <typename T, typename CMP = std::greater<T>, typename AUG = noAugmentation>
+class bst
+{
+protected:
+    T key;                               // valore del nodo
+    class bst<T, CMP, AUG> *parent;      // puntatore al nodo genitore
+    class bst<T, CMP, AUG> *left;        // puntatore al nodo figlio sinistro
+    class bst<T, CMP, AUG> *right;       // puntatore al nodo figlio destro
+    uint count;                          // numero di occorrenze della chiave (usato dalla modalità multiset)
+    bool empty;                          // presenza di un valore nel nodo (per classificare il nodo come vuoto)
+    CMP cmp;                             // comparatore
+    typename AUG::value_type aug;        // aumento del sottoalbero (dopo i campi piccoli per non aumentare la dimensione del nodo)
+
+    static const std::ptrdiff_t parallelMinimum{1 << 14}; // numero minimo di valori per cui insertBatch() divide il lavoro in due compiti
+
+    /**
+     * @brief Ricalcola l'aumento di un nodo a partire da quelli dei figli
+     *
+     * @param node è il nodo da aggiornare
+     */
+    static inline void updateAug(bst<T, CMP, AUG> *node)
+    {
+        if constexpr (AUG::enabled)
+        {
+            if (node->empty) // La radice di un albero vuoto non contiene chiavi
+            {
+                node->aug = AUG::identity();
+                return;
+            }
+            node->aug = AUG::combine(AUG::combine(node->left == nullptr ? AUG::identity() : node->left->aug, AUG::lift(node->key, node->count)),
+                                     node->right == nullptr ? AUG::identity() : node->right->aug);
+        }
+    }
+
+    /**
+     * @brief Ricalcola l'aumento di un nodo e di tutti i suoi antenati
+     *
+     * @param node è il nodo da cui iniziare la risalita (può essere nullptr)
+     */
+    static void fixUpward(bst<T, CMP, AUG> *node)
+    {
+        if constexpr (AUG::enabled)
+        {
+            for (; node != nullptr; node = node->parent)
+            {
+                updateAug(node);
+            }
+        }
+    }
+
+    /**
+     * @brief Ricalcola l'aumento di tutti i nodi di un sottoalbero (dopo una ricostruzione completa degli archi)
+     *
+     * @param root è la radice del sottoalbero
+     */
+    static void recomputeAug(bst<T, CMP, AUG> *root)
+    {
+        if constexpr (AUG::enabled)
+        {
+            std::vector<bst<T, CMP, AUG> *> preorder{root}; // L'ordine anticipato al contrario visita i figli prima dei genitori
+            for (std::size_t i{0}; i < preorder.size(); ++i)
+            {
+                for (bst<T, CMP, AUG> *child : {preorder[i]->left, preorder[i]->right})
+                {
+                    if (child != nullptr)
+                    {
+                        preorder.push_back(child);
+                    }
+                }
+            }
+            for (auto node{preorder.rbegin()}; node != preorder.rend(); ++node)
+            {
+                updateAug(*node);
+            }
+        }
+    }
+
+    /**
+     * @brief Aumento delle chiavi di un sottoalbero che rispettano entrambi gli estremi forniti
+     *
+     * Come in pruneRange() si scende solo lungo i due cammini che delimitano l'intervallo e per i sottoalberi compresi
+     * interamente nell'intervallo si usa l'aumento memorizzato, quindi il costo è O(h).
+     *
+     * @tparam LOW è il tipo del predicato "chiave non inferiore all'estremo sinistro"
+     * @tparam HIGH è il tipo del predicato "chiave non superiore all'estremo destro"
+     * @param node è la radice del sottoalbero
+     * @param lowInside è true se tutte le chiavi del sottoalbero rispettano l'estremo sinistro
+     * @param highInside è true se tutte le chiavi del sottoalbero rispettano l'estremo destro
+     * @param aboveLow è il predicato per l'estremo sinistro
+     * @param belowHigh è il predicato per l'estremo destro
+     * @return typename AUG::value_type è l'aumento delle chiavi nell'intervallo
+     */
+    template <typename LOW, typename HIGH>
+    static typename AUG::value_type aggregateRange(const bst<T, CMP, AUG> *node, bool lowInside, bool highInside, LOW &aboveLow, HIGH &belowHigh)
+    {
+        if (node == nullptr)
+        {
+            return AUG::identity();
+        }
+        if (lowInside && highInside) // Tutto il sottoalbero è nell'intervallo
+        {
+            return node->aug;
+        }
+        if (!lowInside && !aboveLow(node->key)) // Chiave prima dell'intervallo
+        {
+            return aggregateRange(node->right, lowInside, highInside, aboveLow, belowHigh);
+        }
+        if (!highInside && !belowHigh(node->key)) // Chiave dopo l'intervallo
+        {
+            return aggregateRange(node->left, lowInside, highInside, aboveLow, belowHigh);
+        }
+        return AUG::combine(AUG::combine(aggregateRange(node->left, lowInside, true, aboveLow, belowHigh), AUG::lift(node->key, node->count)),
+                            aggregateRange(node->right, true, highInside, aboveLow, belowHigh));
+    }
+
+    /**
+     * @brief Eliminazione di un nodo dall'albero mediante puntatore al nodo da eliminare
+     *
+     * Sia N il nodo da eliminare, ci sono tre casi possibili:
+     * -# N è un nodo foglia; il puntatore a N del genitore viene sostituito con nullptr (N.parent non ha più il figlio N)
+     *    e quindi N viene rimosso dall'albero.
+     * -# N ha solo un figlio; il figlio diventa figlio sinistro del genitore di N (se N è il figlio sinistro del suo genitore)
+     *    o figlio destro del genitore di N (se N è il figlio destro del suo genitore) e quindi N viene rimosso dall'albero.
+     * -# N ha entrambi i figli; sia S il successore di N, S prende la posizione di N nell'albero.
+     *    Se S è il figlio destro (diretto) di N, allora S sostituisce N e il puntatore al figlio sinistro di S diventa uguale al
+     *    puntatore al figlio sinistro di N.
+     *    Se S non è il figlio destro immediato di N, allora S viene sostituito dal figlio destro si S e S prende la posizione di N
+     *
+     * @param keyNode puntatore al nodo da eliminare
+     */
+    void deleteKey(bst<T, CMP, AUG> *keyNode);
+
+    /**
+     * @brief Sostituzione di un nodo
+     *
+     * @param nodeA puntatore al nodo che deve essere sostituito
+     * @param nodeB puntatore al nodo che sostituisce il nodeA
+     */
+    void nodeChange(bst<T, CMP, AUG> *nodeA, bst<T, CMP, AUG> *nodeB);
+
+    /**
+     * @brief Verifica se due chiavi sono equivalenti secondo la relazione d'ordine
+     * Due chiavi sono equivalenti se nessuna delle due è maggiore dell'altra
+     *
+     * @param a prima chiave da confrontare
+     * @param b seconda chiave da confrontare
+     * @return true se le chiavi sono equivalenti
+     * @return false altrimenti
+     */
+    inline bool equivalent(const T &a, const T &b) const
+    {
+        return !cmp(a, b) && !cmp(b, a);
+    }
+
+    /**
+     * @brief Restituisce il nodo successivo nella visita simmetrica senza lanciare eccezioni
+     *
+     * @param node è il nodo di partenza
+     * @return puntatore al nodo successivo o nullptr se node è il massimo
+     */
+    static bst<T, CMP, AUG> *nextNode(const bst<T, CMP, AUG> *node)
+    {
+        if (node->right != nullptr)
+        {
+            return node->right->min();
+        }
+        while (node->parent != nullptr && node == node->parent->right) // Risalgo finché sono un figlio destro
+        {
+            node = node->parent;
+        }
+        return node->parent;
+    }
+
+    /**
+     * @brief Restituisce il nodo precedente nella visita simmetrica senza lanciare eccezioni
+     *
+     * @param node è il nodo di partenza
+     * @return puntatore al nodo precedente o nullptr se node è il minimo
+     */
+    static bst<T, CMP, AUG> *prevNode(const bst<T, CMP, AUG> *node)
+    {
+        if (node->left != nullptr)
+        {
+            return node->left->max();
+        }
+        while (node->parent != nullptr && node == node->parent->left) // Risalgo finché sono un figlio sinistro
+        {
+            node = node->parent;
+        }
+        return node->parent;
+    }
+
+    /**
+     * @brief Scambia il contenuto (chiave e occorrenze) di due nodi senza modificarne gli archi
+     *
+     * @param a primo nodo
+     * @param b secondo nodo
+     */
+    static void swapPayload(bst<T, CMP, AUG> *a, bst<T, CMP, AUG> *b)
+    {
+        std::swap(a->key, b->key);
+        std::swap(a->count, b->count);
+    }
+
+    /**
+     * @brief Scambia la posizione in memoria di due nodi diversi dalla radice senza cambiare l'albero
+     *
+     * Oltre al contenuto (chiave, occorrenze e aumento) i due oggetti si scambiano anche il posto nella forma
+     * dell'albero: genitori e figli vengono ricollegati, anche quando un nodo è genitore o fratello dell'altro.
+     *
+     * @param a primo nodo (non la radice)
+     * @param b secondo nodo (non la radice)
+     */
+    static void exchangeNodes(bst<T, CMP, AUG> *a, bst<T, CMP, AUG> *b)
+    {
+        auto other{[a, b](bst<T, CMP, AUG> *node)
+                   { return node == a ? b : node == b ? a : node; }};
+        bst<T, CMP, AUG> *aParent{a->parent}, *aLeft{a->left}, *aRight{a->right};
+        bst<T, CMP, AUG> *bParent{b->parent}, *bLeft{b->left}, *bRight{b->right};
+        bool aIsLeft{aParent->left == a};
+        bool bIsLeft{bParent->left == b};
+        swapPayload(a, b);
+        std::swap(a->aug, b->aug);
+        a->parent = other(bParent);
+        a->left = other(bLeft);
+        a->right = other(bRight);
+        b->parent = other(aParent);
+        b->left = other(aLeft);
+        b->right = other(aRight);
+        for (bst<T, CMP, AUG> *node : {a, b})
+        {
+            if (node->left != nullptr)
+            {
+                node->left->parent = node;
+            }
+            if (node->right != nullptr)
+            {
+                node->right->parent = node;
+            }
+        }
+        (bIsLeft ? a->parent->left : a->parent->right) = a; // a prende il posto che era di b
+        (aIsLeft ? b->parent->left : b->parent->right) = b;
+    }
+
+    /**
+     * @brief Rotazione a destra del sottoalbero con radice node
+     *
+     * Il figlio sinistro sale al posto di node. Per non dover sostituire la radice dell'albero (che può essere
+     * un oggetto allocato sullo stack) il nodo node rimane nella stessa posizione e si scambia il contenuto
+     * con il figlio sinistro, che diventa il nuovo figlio destro.
+     *
+     * @param node è la radice del sottoalbero da ruotare (deve avere il figlio sinistro)
+     */
+    static void rotateRight(bst<T, CMP, AUG> *node)
+    {
+        bst<T, CMP, AUG> *y{node->left};
+        swapPayload(node, y);
+        node->left = y->left; // Il sottoalbero sinistro del figlio sale di un livello
+        if (node->left != nullptr)
+        {
+            node->left->parent = node;
+        }
+        y->left = y->right;     // Il sottoalbero destro del figlio resta tra le due chiavi
+        y->right = node->right; // Il sottoalbero destro di node scende di un livello
+        if (y->right != nullptr)
+        {
+            y->right->parent = y;
+        }
+        node->right = y;
+        updateAug(y);
+        updateAug(node);
+    }
+
+    /**
+     * @brief Rotazione a sinistra del sottoalbero con radice node
+     *
+     * Simmetrica di rotateRight(): il figlio destro sale al posto di node scambiando il contenuto dei due nodi.
+     *
+     * @param node è la radice del sottoalbero da ruotare (deve avere il figlio destro)
+     */
+    static void rotateLeft(bst<T, CMP, AUG> *node)
+    {
+        bst<T, CMP, AUG> *y{node->right};
+        swapPayload(node, y);
+        node->right = y->right; // Il sottoalbero destro del figlio sale di un livello
+        if (node->right != nullptr)
+        {
+            node->right->parent = node;
+        }
+        y->right = y->left;   // Il sottoalbero sinistro del figlio resta tra le due chiavi
+        y->left = node->left; // Il sottoalbero sinistro di node scende di un livello
+        if (y->left != nullptr)
+        {
+            y->left->parent = y;
+        }
+        node->left = y;
+        updateAug(y);
+        updateAug(node);
+    }
+
+    /**
+     * @brief Elimina la chiave memorizzata nella radice mantenendo l'oggetto radice al suo posto
+     *
+     * La radice non può essere deallocata (può essere sullo stack), quindi se ha un solo figlio ne acquisisce
+     * il contenuto e i figli, se ne ha due acquisisce la chiave del successore che viene poi eliminato.
+     */
+    void deleteRoot()
+    {
+        if (left == nullptr && right == nullptr) // L'albero diventa vuoto
+        {
+            empty = true;
+            count = 0;
+            aug = AUG::identity();
+        }
+        else if (left == nullptr || right == nullptr) // Il figlio unico prende il posto della radice
+        {
+            bst<T, CMP, AUG> *child{left != nullptr ? left : right};
+            swapPayload(this, child);
+            left = child->left;
+            right = child->right;
+            if (left != nullptr)
+            {
+                left->parent = this;
+            }
+            if (right != nullptr)
+            {
+                right->parent = this;
+            }
+            child->left = nullptr; // Evito che il distruttore elimini i figli adottati dalla radice
+            child->right = nullptr;
+            delete child;
+            updateAug(this);
+        }
+        else // Il successore (che non ha figlio sinistro) cede la sua chiave alla radice
+        {
+            bst<T, CMP, AUG> *S{right->min()};
+            swapPayload(this, S);
+            deleteKey(S);
+        }
+    }
+
+    /**
+     * @brief Ribilanciamento di un sottoalbero con l'algoritmo di Day-Stout-Warren
+     *
+     * Il sottoalbero viene prima trasformato in una lista (vine) verso destra con rotazioni a destra, poi compresso
+     * con successive passate di rotazioni a sinistra fino a ottenere un albero perfettamente bilanciato
+     * (tutti i livelli pieni tranne l'ultimo). Il costo è O(n) con O(1) memoria aggiuntiva. Le rotazioni mantengono
+     * fisso il nodo radice del sottoalbero, quindi il genitore non deve essere aggiornato e nessun nodo viene riallocato.
+     *
+     * @param root è la radice (non vuota) del sottoalbero da ribilanciare
+     */
+    static void rebalanceSubtree(bst<T, CMP, AUG> *root)
+    {
+        u_int n{0};
+        for (bst<T, CMP, AUG> *node{root}; node != nullptr;) // Fase 1: trasformazione in vine
+        {
+            if (node->left != nullptr)
+            {
+                rotateRight(node);
+            }
+            else
+            {
+                ++n;
+                node = node->right;
+            }
+        }
+        u_int full{1}; // Numero di nodi del più grande albero completo con al più n nodi
+        while (2 * full + 1 <= n)
+        {
+            full = 2 * full + 1;
+        }
+        compressVine(root, n - full); // Fase 2: i nodi in eccesso formano l'ultimo livello
+        while (full > 1)
+        {
+            full /= 2;
+            compressVine(root, full);
+        }
+    }
+
+    /**
+     * @brief Passata di compressione dell'algoritmo di Day-Stout-Warren
+     * Esegue count rotazioni a sinistra su nodi alterni del vine che parte da root
+     *
+     * @param root è la radice del vine
+     * @param count è il numero di rotazioni
+     */
+    static void compressVine(bst<T, CMP, AUG> *root, u_int count)
+    {
+        bst<T, CMP, AUG> *node{root};
+        for (u_int i{0}; i < count; ++i)
+        {
+            rotateLeft(node);
+            node = node->right;
+        }
+    }
+
+    /**
+     * @brief Ricollega i nodi dell'albero secondo una nuova forma
+     *
+     * La forma è descritta con gli indici della visita simmetrica: i nodi mantengono l'ordine delle chiavi e cambiano solo
+     * gli archi. Se la nuova radice non è l'oggetto radice, le due chiavi vengono scambiate (insieme alle posizioni nel vettore).
+     *
+     * @param nodes sono i nodi nell'ordine della visita simmetrica (viene aggiornato)
+     * @param leftIdx è l'indice del figlio sinistro di ogni nodo (-1 se assente)
+     * @param rightIdx è l'indice del figlio destro di ogni nodo (-1 se assente)
+     * @param rootIdx è l'indice della nuova radice
+     */
+    void relinkShape(std::vector<bst<T, CMP, AUG> *> &nodes, const std::vector<int> &leftIdx, const std::vector<int> &rightIdx, uint rootIdx)
+    {
+        uint current{0}; // posizione dell'oggetto radice nella visita simmetrica
+        while (nodes[current] != this)
+        {
+            ++current;
+        }
+        if (current != rootIdx)
+        {
+            swapPayload(nodes[current], nodes[rootIdx]);
+            std::swap(nodes[current], nodes[rootIdx]);
+        }
+        for (uint i{0}; i < nodes.size(); ++i)
+        {
+            nodes[i]->left = nullptr;
+            nodes[i]->right = nullptr;
+            if (leftIdx[i] >= 0)
+            {
+                nodes[i]->setLeft(nodes[leftIdx[i]]);
+            }
+            if (rightIdx[i] >= 0)
+            {
+                nodes[i]->setRight(nodes[rightIdx[i]]);
+            }
+        }
+        parent = nullptr;
+        recomputeAug(this);
+    }
+
+    /**
+     * @brief Inserimento iterativo che restituisce il nodo appena creato
+     *
+     * @param value è il valore da inserire
+     * @return puntatore al nodo che contiene value
+     */
+    bst<T, CMP, AUG> *insertNode(const T &value)
+    {
+        if (isEmpty()) // L'albero era vuoto: la radice riceve il valore
+        {
+            empty = false;
+            key = value;
+            count = 1;
+            updateAug(this);
+            return this;
+        }
+        return insertBelow(this, value);
+    }
+
+    /**
+     * @brief Inserimento iterativo nel sottoalbero con radice node
+     * Il chiamante deve garantire che value rispetti i limiti imposti dagli antenati di node.
+     *
+     * @param node è la radice (non vuota) del sottoalbero da cui parte la discesa
+     * @param value è il valore da inserire
+     * @return puntatore al nodo appena creato
+     */
+    static bst<T, CMP, AUG> *insertBelow(bst<T, CMP, AUG> *node, const T &value)
+    {
+        return insertBelow(const_iterator{node}, value).ptr;
+    }
+
+    /**
+     * @brief Valore centrale di un intervallo ordinato non vuoto, spostato dopo i suoi duplicati
+     *
+     * @param first è il puntatore al primo valore
+     * @param last è il puntatore successivo all'ultimo valore
+     * @return puntatore al valore che diventa radice del sottoalbero
+     */
+    static const T *median(const T *first, const T *last)
+    {
+        CMP cmp;
+        const T *mid{first + (last - first) / 2};
+        while (mid + 1 != last && !cmp(*(mid + 1), *mid)) // I duplicati della mediana restano a sinistra
+        {
+            ++mid;
+        }
+        return mid;
+    }
+
+    /**
+     * @brief Costruisce un sottoalbero bilanciato da un intervallo di valori ordinati
+     * Le chiavi uguali alla radice vengono lasciate a sinistra, come negli inserimenti.
+     *
+     * @param first è il puntatore al primo valore
+     * @param last è il puntatore successivo all'ultimo valore
+     * @return puntatore alla radice del sottoalbero (senza genitore, nullptr se l'intervallo è vuoto)
+     */
+    static bst<T, CMP, AUG> *buildSorted(const T *first, const T *last)
+    {
+        if (first == last)
+        {
+            return nullptr;
+        }
+        const T *mid{median(first, last)};
+        bst<T, CMP, AUG> *node{new bst<T, CMP, AUG>(*mid)};
+        node->setLeft(buildSorted(first, mid));
+        node->setRight(buildSorted(mid + 1, last));
+        return node;
+    }
+
+    /**
+     * @brief Inserisce in un sottoalbero un intervallo di valori ordinati visitando ogni sottoalbero interessato una sola volta
+     *
+     * In ogni nodo l'intervallo viene diviso con una ricerca binaria tra i valori destinati al sottoalbero sinistro
+     * e quelli destinati al destro; quando si raggiunge un figlio mancante i valori rimanenti formano un sottoalbero bilanciato.
+     *
+     * @param node è la radice (non vuota) del sottoalbero
+     * @param first è il puntatore al primo valore
+     * @param last è il puntatore successivo all'ultimo valore
+     * @return uint è il numero di livelli del cammino più lungo tra quelli modificati, contando node (0 se non ci sono valori)
+     */
+    static uint mergeSorted(bst<T, CMP, AUG> *node, const T *first, const T *last)
+    {
+        if (first == last)
+        {
+            return 0;
+        }
+        const T *split{std::partition_point(first, last, [node](const T &value)
+                                            { return !node->cmp(value, node->key); })}; // Minori o uguali a sinistra
+        uint leftLevels, rightLevels;
+        if (node->left != nullptr)
+        {
+            leftLevels = mergeSorted(node->left, first, split);
+        }
+        else
+        {
+            node->setLeft(buildSorted(first, split));
+            leftLevels = node->left->height(); // Solo nodi nuovi: il costo è proporzionale ai valori inseriti
+        }
+        if (node->right != nullptr)
+        {
+            rightLevels = mergeSorted(node->right, split, last);
+        }
+        else
+        {
+            node->setRight(buildSorted(split, last));
+            rightLevels = node->right->height();
+        }
+        updateAug(node);
+        return 1 + std::max(leftLevels, rightLevels);
+    }
+
+    /**
+     * @brief Ordina un intervallo di valori dividendolo ricorsivamente in due compiti di workerPool e fondendo le due metà
+     *
+     * @param first è il puntatore al primo valore
+     * @param last è il puntatore successivo all'ultimo valore
+     * @param depth è il numero di livelli in cui il lavoro viene ancora diviso (fino a 2^depth compiti)
+     */
+    static void sortParallel(T *first, T *last, uint depth)
+    {
+        CMP cmp;
+        auto less{[&cmp](const T &a, const T &b)
+                  { return cmp(b, a); }};
+        if (depth == 0 || last - first < parallelMinimum)
+        {
+            std::sort(first, last, less);
+            return;
+        }
+        T *mid{first + (last - first) / 2};
+        workerPool::instance().forkJoin([=]()
+                                        { sortParallel(first, mid, depth - 1); },
+                                        [=]()
+                                        { sortParallel(mid, last, depth - 1); });
+        std::inplace_merge(first, mid, last, less);
+    }
+
+    /**
+     * @brief Versione parallela di buildSorted(): i due sottoalberi della mediana vengono costruiti da due compiti di workerPool
+     *
+     * @param first è il puntatore al primo valore
+     * @param last è il puntatore successivo all'ultimo valore
+     * @param depth è il numero di livelli in cui il lavoro viene ancora diviso (fino a 2^depth compiti)
+     * @return puntatore alla radice del sottoalbero (senza genitore, nullptr se l'intervallo è vuoto)
+     */
+    static bst<T, CMP, AUG> *buildSortedParallel(const T *first, const T *last, uint depth)
+    {
+        if (depth == 0 || last - first < parallelMinimum)
+        {
+            return buildSorted(first, last);
+        }
+        const T *mid{median(first, last)};
+        bst<T, CMP, AUG> *node{new bst<T, CMP, AUG>(*mid)};
+        bst<T, CMP, AUG> *leftSubtree{nullptr};
+        bst<T, CMP, AUG> *rightSubtree{nullptr};
+        workerPool::instance().forkJoin([&]()
+                                        { leftSubtree = buildSortedParallel(first, mid, depth - 1); },
+                                        [&]()
+                                        { rightSubtree = buildSortedParallel(mid + 1, last, depth - 1); });
+        node->setLeft(leftSubtree); // I figli vengono collegati dopo forkJoin(), così solo questo thread modifica node
+        node->setRight(rightSubtree);
+        return node;
+    }
+
+    /**
+     * @brief Versione parallela di mergeSorted(): i valori destinati ai due sottoalberi di un nodo vengono inseriti
+     * da due compiti di workerPool, che modificano sottoalberi disgiunti. Se tutti i valori vanno dalla stessa parte si
+     * scende senza dividere il lavoro. Gli aumenti del nodo vengono aggiornati dopo forkJoin().
+     *
+     * @param node è la radice (non vuota) del sottoalbero
+     * @param first è il puntatore al primo valore
+     * @param last è il puntatore successivo all'ultimo valore
+     * @param depth è il numero di livelli in cui il lavoro viene ancora diviso (fino a 2^depth compiti)
+     * @return uint è il numero di livelli del cammino più lungo tra quelli modificati, contando node (0 se non ci sono valori)
+     */
+    static uint mergeSortedParallel(bst<T, CMP, AUG> *node, const T *first, const T *last, uint depth)
+    {
+        if (depth == 0 || last - first < parallelMinimum)
+        {
+            return mergeSorted(node, first, last);
+        }
+        const T *split{std::partition_point(first, last, [node](const T &value)
+                                            { return !node->cmp(value, node->key); })}; // Minori o uguali a sinistra
+        uint levels;
+        if (split == last && node->left != nullptr)
+        {
+            levels = 1 + mergeSortedParallel(node->left, first, last, depth);
+        }
+        else if (split == first && node->right != nullptr)
+        {
+            levels = 1 + mergeSortedParallel(node->right, first, last, depth);
+        }
+        else
+        {
+            bst<T, CMP, AUG> *leftSubtree{nullptr};
+            bst<T, CMP, AUG> *rightSubtree{nullptr};
+            uint leftLevels{0}, rightLevels{0};
+            workerPool::instance().forkJoin([&]()
+                                            {
+                                                if (node->left != nullptr)
+                                                {
+                                                    leftLevels = mergeSortedParallel(node->left, first, split, depth - 1);
+                                                }
+                                                else
+                                                {
+                                                    leftSubtree = buildSortedParallel(first, split, depth - 1);
+                                                    leftLevels = leftSubtree->height();
+                                                }
+                                            },
+                                            [&]()
+                                            {
+                                                if (node->right != nullptr)
+                                                {
+                                                    rightLevels = mergeSortedParallel(node->right, split, last, depth - 1);
+                                                }
+                                                else
+                                                {
+                                                    rightSubtree = buildSortedParallel(split, last, depth - 1);
+                                                    rightLevels = rightSubtree->height();
+                                                }
+                                            });
+            if (leftSubtree != nullptr)
+            {
+                node->setLeft(leftSubtree);
+            }
+            if (rightSubtree != nullptr)
+            {
+                node->setRight(rightSubtree);
+            }
+            levels = 1 + std::max(leftLevels, rightLevels);
+        }
+        updateAug(node);
+        return levels;
+    }
+
+    /**
+     * @brief Inserisce nell'albero un intervallo di valori ordinati in modo crescente
+     *
+     * @param first è il puntatore al primo valore
+     * @param last è il puntatore successivo all'ultimo valore
+     */
+    void insertSorted(const T *first, const T *last)
+    {
+        if (first == last)
+        {
+            return;
+        }
+        if (isEmpty())
+        {
+            adopt(buildSorted(first, last));
+        }
+        else
+        {
+            mergeSorted(this, first, last);
+        }
+    }
+
+    /**
+     * @brief Unisce due sottoalberi staccati in cui tutte le chiavi di l precedono quelle di r
+     * Il minimo di r diventa la radice del sottoalbero risultante.
+     *
+     * @param l è il sottoalbero con le chiavi minori (può essere nullptr)
+     * @param r è il sottoalbero con le chiavi maggiori (può essere nullptr)
+     * @return puntatore alla radice del sottoalbero unito (senza genitore)
+     */
+    static bst<T, CMP, AUG> *joinSubtrees(bst<T, CMP, AUG> *l, bst<T, CMP, AUG> *r)
+    {
+        if (l == nullptr || r == nullptr)
+        {
+            bst<T, CMP, AUG> *joined{l == nullptr ? r : l};
+            if (joined != nullptr)
+            {
+                joined->parent = nullptr;
+            }
+            return joined;
+        }
+        bst<T, CMP, AUG> *S{r->min()};
+        if (S != r) // Il minimo viene staccato e sostituito dal suo figlio destro
+        {
+            bst<T, CMP, AUG> *up{S->parent};
+            up->left = S->right;
+            if (S->right != nullptr)
+            {
+                S->right->parent = up;
+            }
+            for (; up != r; up = up->parent) // Il cammino da cui è stato tolto il minimo cambia aumento
+            {
+                updateAug(up);
+            }
+            updateAug(r);
+            S->setRight(r);
+        }
+        S->setLeft(l);
+        S->parent = nullptr;
+        return S;
+    }
+
+    /**
+     * @brief Elimina da un sottoalbero staccato le chiavi comprese in un intervallo
+     *
+     * I sottoalberi che cadono interamente nell'intervallo vengono liberati in un solo passo senza visitarne le chiavi.
+     *
+     * @tparam LOW è il tipo del predicato "chiave non inferiore all'estremo sinistro"
+     * @tparam HIGH è il tipo del predicato "chiave non superiore all'estremo destro"
+     * @param node è la radice del sottoalbero
+     * @param lowInside è true se tutte le chiavi del sottoalbero rispettano l'estremo sinistro
+     * @param highInside è true se tutte le chiavi del sottoalbero rispettano l'estremo destro
+     * @param aboveLow è il predicato per l'estremo sinistro
+     * @param belowHigh è il predicato per l'estremo destro
+     * @param erased è il contatore dei nodi eliminati
+     * @return puntatore alla nuova radice del sottoalbero (senza genitore)
+     */
+    template <typename LOW, typename HIGH>
+    static bst<T, CMP, AUG> *pruneRange(bst<T, CMP, AUG> *node, bool lowInside, bool highInside, LOW &aboveLow, HIGH &belowHigh, u_int &erased)
+    {
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+        if (lowInside && highInside) // Tutto il sottoalbero è nell'intervallo
+        {
+            erased += node->nodesCount();
+            delete node;
+            return nullptr;
+        }
+        if (!lowInside && !aboveLow(node->key)) // Chiave prima dell'intervallo: il sottoalbero sinistro non va toccato
+        {
+            node->setRight(pruneRange(node->right, lowInside, highInside, aboveLow, belowHigh, erased));
+            return node;
+        }
+        if (!highInside && !belowHigh(node->key)) // Chiave dopo l'intervallo: il sottoalbero destro non va toccato
+        {
+            node->setLeft(pruneRange(node->left, lowInside, highInside, aboveLow, belowHigh, erased));
+            return node;
+        }
+        bst<T, CMP, AUG> *l{pruneRange(node->left, lowInside, true, aboveLow, belowHigh, erased)};
+        bst<T, CMP, AUG> *r{pruneRange(node->right, true, highInside, aboveLow, belowHigh, erased)};
+        node->left = nullptr; // I figli sopravvissuti non devono essere eliminati dal distruttore
+        node->right = nullptr;
+        delete node;
+        ++erased;
+        return joinSubtrees(l, r);
+    }
+
+    /**
+     * @brief Elimina da un sottoalbero staccato i nodi la cui chiave soddisfa un predicato
+     *
+     * @tparam PRED è il tipo del predicato
+     * @param node è la radice del sottoalbero
+     * @param pred è il predicato da verificare
+     * @param erased è il contatore dei nodi eliminati
+     * @return puntatore alla nuova radice del sottoalbero (senza genitore)
+     */
+    template <typename PRED>
+    static bst<T, CMP, AUG> *pruneIf(bst<T, CMP, AUG> *node, PRED &pred, u_int &erased)
+    {
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+        node->setLeft(pruneIf(node->left, pred, erased));
+        node->setRight(pruneIf(node->right, pred, erased));
+        if (!pred(node->key))
+        {
+            return node;
+        }
+        bst<T, CMP, AUG> *l{node->left};
+        bst<T, CMP, AUG> *r{node->right};
+        node->left = nullptr;
+        node->right = nullptr;
+        delete node;
+        ++erased;
+        return joinSubtrees(l, r);
+    }
+
+    /**
+     * @brief Conta i nodi di un sottoalbero fermandosi al limite fornito
+     *
+     * @param node è la radice del sottoalbero (può essere nullptr)
+     * @param limit è il numero massimo di nodi da contare
+     * @return numero di nodi del sottoalbero se non supera limit, altrimenti limit
+     */
+    static u_int nodesUpTo(const bst<T, CMP, AUG> *node, u_int limit)
+    {
+        if (node == nullptr || limit == 0)
+        {
+            return 0;
+        }
+        u_int counted{1 + nodesUpTo(node->left, limit - 1)};
+        return counted + nodesUpTo(node->right, limit - counted);
+    }
 
-/**
- * @class bst
- *
- * @brief Classe per la rappresentazione degli alberi binari di ricerca.
- * Un albero è definito in modo ricorsivo dal valore della sua radice, dal puntatore al nodo genitore (se è un sottoalbero)
- * e dai puntatori ai suoi sottoalberi sinistro e destro.
- *
- * Nota: in questa classe i termini nodo e albero vengono interscambiati. Nonostante siano entità diverse
- * (un albero è composto da nodi), per come è stata definita la classe un puntatore a bst<T, CMP> indica
- * sia un nodo, perché bst<T, CMP> ha un valore key che è il valore del nodo, sia un albero, perché contiene
- * i puntatori ai nodi (o appunto alberi) figli. Un oggetto bst<T, CMP> si può quindi pensare o come a un albero
- * o coma a un nodo più i suoi archi.
- *
- * @tparam T è il tipo di dato delle chiavi associate ai nodi
- * @tparam CMP è la relazione d'ordine del tipo T
- *
- * @param key è il valore dela chiave associata al nodo
- * @param parent è il puntatore al genitore del nodo
- * @param left è il puntatore al figlio sinistro del nodo
- * @param right è il untatore al figlio destro del nodo
- * @param empty indica la presenza di un valore nel nodo (true se non è presente, false se è presente) per classificare i nodo vuoti
- * @param cmp è la relazione d'ordine da utilizzare. È necessario utilizzare un comparatore che esprima la relazione
- * d'ordine di "maggiore" se si vuole ottenere un albero binario ordinato correttamente
- */
-template <typename T, typename CMP = std::greater<T>>
-class bst
-{
-private:
-    T key;                     // valore del nodo
-    class bst<T, CMP> *parent; // puntatore al nodo genitore
-    class bst<T, CMP> *left;   // puntatore al nodo figlio sinistro
-    class bst<T, CMP> *right;  // puntatore al nodo figlio destro
-    bool empty;                // presenza di un valore nel nodo (per classificare il nodo come vuoto)
-    CMP cmp;                   // comparatore
+    /**
+     * @brief Ribilancia l'albero se una cancellazione ha eliminato più nodi di quelli rimasti
+     * Le cancellazioni non riducono l'altezza, quindi dopo molte eliminazioni l'albero resterebbe alto quanto prima
+     * con pochi nodi. Il conteggio si ferma a erased nodi e rebalance() costa O(n) sui meno di erased nodi rimasti,
+     * quindi il costo aggiuntivo è O(erased).
+     *
+     * @param erased è il numero di nodi eliminati
+     * @return erased
+     */
+    u_int rebalanceAfterErase(u_int erased)
+    {
+        if (erased > 0 && !isEmpty() && nodesUpTo(this, erased) < erased)
+        {
+            rebalanceSubtree(this);
+        }
+        return erased;
+    }
 
     /**
-     * @brief Eliminazione di un nodo dall'albero mediante puntatore al nodo da eliminare
+     * @brief Imposta il figlio sinistro aggiornandone il puntatore al genitore
+     * Aggiorna anche l'aumento del nodo, quindi i sottoalberi vanno collegati dal basso verso l'alto.
      *
-     * Sia N il nodo da eliminare, ci sono tre casi possibili:
-     * -# N è un nodo foglia; il puntatore a N del genitore viene sostituito con nullptr (N.parent non ha più il figlio N)
-     *    e quindi N viene rimosso dall'albero.
-     * -# N ha solo un figlio; il figlio diventa figlio sinistro del genitore di N (se N è il figlio sinistro del suo genitore)
-     *    o figlio destro del genitore di N (se N è il figlio destro del suo genitore) e quindi N viene rimosso dall'albero.
-     * -# N ha entrambi i figli; sia S il successore di N, S prende la posizione di N nell'albero.
-     *    Se S è il figlio destro (diretto) di N, allora S sostituisce N e il puntatore al figlio sinistro di S diventa uguale al
-     *    puntatore al figlio sinistro di N.
-     *    Se S non è il figlio destro immediato di N, allora S viene sostituito dal figlio destro si S e S prende la posizione di N
+     * @param child è il nuovo figlio sinistro (può essere nullptr)
+     */
+    inline void setLeft(bst<T, CMP, AUG> *child)
+    {
+        left = child;
+        if (child != nullptr)
+        {
+            child->parent = this;
+        }
+        updateAug(this);
+    }
+
+    /**
+     * @brief Imposta il figlio destro aggiornandone il puntatore al genitore
+     * Aggiorna anche l'aumento del nodo, quindi i sottoalberi vanno collegati dal basso verso l'alto.
      *
-     * @param keyNode puntatore al nodo da eliminare
+     * @param child è il nuovo figlio destro (può essere nullptr)
      */
-    void deleteKey(bst<T, CMP> *keyNode);
+    inline void setRight(bst<T, CMP, AUG> *child)
+    {
+        right = child;
+        if (child != nullptr)
+        {
+            child->parent = this;
+        }
+        updateAug(this);
+    }
 
     /**
-     * @brief Sostituzione di un nodo
+     * @brief Inserisce un lotto di valori non ordinati (vedi insertBatch()) e restituisce la profondità dei cammini modificati
+     * Le varianti che controllano l'altezza (balancedBst) verificano solo i cammini raggiunti dal lotto invece di
+     * visitare l'albero intero.
      *
-     * @param nodeA puntatore al nodo che deve essere sostituito
-     * @param nodeB puntatore al nodo che sostituisce il nodeA
+     * @param batch sono i valori da inserire
+     * @param threadCount è il numero massimo di compiti paralleli (arrotondato alla potenza di due successiva)
+     * @return uint è il numero di livelli del cammino più lungo tra quelli modificati (0 se il lotto è vuoto)
+     */
+    uint mergeBatch(std::vector<T> batch, uint threadCount)
+    {
+        if (batch.empty())
+        {
+            return 0;
+        }
+        uint depth{0};
+        while ((1u << depth) < threadCount)
+        {
+            ++depth;
+        }
+        sortParallel(batch.data(), batch.data() + batch.size(), depth);
+        if (isEmpty())
+        {
+            adopt(buildSortedParallel(batch.data(), batch.data() + batch.size(), depth));
+            return height(); // L'albero contiene solo i nodi nuovi
+        }
+        return mergeSortedParallel(this, batch.data(), batch.data() + batch.size(), depth);
+    }
+
+    /**
+     * @brief Sposta il contenuto della radice in un nodo allocato dinamicamente
+     * Serve per trattare l'intero albero come un sottoalbero staccato; la radice rimane vuota.
+     *
+     * @return puntatore al nodo che ha preso il posto della radice (nullptr se l'albero è vuoto)
+     */
+    bst<T, CMP, AUG> *release()
+    {
+        if (isEmpty())
+        {
+            return nullptr;
+        }
+        bst<T, CMP, AUG> *node{new bst<T, CMP, AUG>()};
+        swapPayload(node, this); // La chiave viene spostata, non copiata
+        node->empty = false;
+        node->setLeft(left);
+        node->setRight(right);
+        left = nullptr;
+        right = nullptr;
+        empty = true;
+        count = 0;
+        aug = AUG::identity();
+        return node;
+    }
+
+    /**
+     * @brief Operazione inversa di release(): la radice vuota acquisisce il contenuto di un sottoalbero staccato
+     *
+     * @param node è la radice del sottoalbero staccato (può essere nullptr), che viene deallocata
+     */
+    void adopt(bst<T, CMP, AUG> *node)
+    {
+        if (node == nullptr)
+        {
+            return;
+        }
+        swapPayload(this, node);
+        empty = false;
+        setLeft(node->left);
+        setRight(node->right);
+        node->left = nullptr;
+        node->right = nullptr;
+        delete node;
+    }
+
+    /**
+     * @brief Divide un sottoalbero staccato lungo il cammino di ricerca di una chiave
+     *
+     * @param node è la radice del sottoalbero da dividere
+     * @param value è la chiave di divisione
+     * @param less è il sottoalbero risultante con le chiavi minori di value
+     * @param greaterEqual è il sottoalbero risultante con le chiavi maggiori o uguali a value
+     */
+    static void splitSubtree(bst<T, CMP, AUG> *node, const T &value, bst<T, CMP, AUG> *&less, bst<T, CMP, AUG> *&greaterEqual)
+    {
+        if (node == nullptr)
+        {
+            less = nullptr;
+            greaterEqual = nullptr;
+            return;
+        }
+        node->parent = nullptr;
+        if (node->cmp(value, node->key)) // Il nodo è minore di value: resta a sinistra con il suo sottoalbero sinistro
+        {
+            bst<T, CMP, AUG> *rest;
+            splitSubtree(node->right, value, rest, greaterEqual);
+            node->setRight(rest);
+            less = node;
+        }
+        else // Il nodo è maggiore o uguale a value: resta a destra con il suo sottoalbero destro
+        {
+            bst<T, CMP, AUG> *rest;
+            splitSubtree(node->left, value, less, rest);
+            node->setLeft(rest);
+            greaterEqual = node;
+        }
+    }
+
+    /**
+     * @brief Elimina dall'albero le chiavi che rispettano entrambi gli estremi forniti
+     * La radice è trattata a parte perché non può essere deallocata.
+     *
+     * @tparam LOW è il tipo del predicato per l'estremo sinistro
+     * @tparam HIGH è il tipo del predicato per l'estremo destro
+     * @param aboveLow è il predicato per l'estremo sinistro
+     * @param belowHigh è il predicato per l'estremo destro
+     * @return numero di nodi eliminati
      */
-    void nodeChange(bst<T, CMP> *nodeA, bst<T, CMP> *nodeB);
+    template <typename LOW, typename HIGH>
+    u_int eraseBetween(LOW &aboveLow, HIGH &belowHigh)
+    {
+        u_int erased{0};
+        if (isEmpty())
+        {
+            return erased;
+        }
+        bool geLow{aboveLow(key)};
+        bool leHigh{belowHigh(key)};
+        if (!geLow)
+        {
+            setRight(pruneRange(right, false, false, aboveLow, belowHigh, erased));
+        }
+        else if (!leHigh)
+        {
+            setLeft(pruneRange(left, false, false, aboveLow, belowHigh, erased));
+        }
+        else
+        {
+            setLeft(pruneRange(left, false, true, aboveLow, belowHigh, erased));
+            setRight(pruneRange(right, true, false, aboveLow, belowHigh, erased));
+            deleteRoot();
+            ++erased;
+        }
+        return rebalanceAfterErase(erased);
+    }
 
 public:
     /**
@@ -79,27 +1123,49 @@ public:
     class const_iterator
     {
     private:
-        bst<T> *ptr; // puntatore all'elemento associato all'iteratore
+        bst<T, CMP, AUG> *ptr;   // puntatore all'elemento associato all'iteratore
+        bst<T, CMP, AUG> *lower; // antenato che limita inferiormente il sottoalbero di ptr (nullptr se non esiste)
+        bst<T, CMP, AUG> *upper; // antenato che limita superiormente il sottoalbero di ptr (nullptr se non esiste)
+        bool lowerKnown;         // true se lower è stato determinato (solo per gli iteratori di insertValue(hint) e findFrom())
+        bool upperKnown;         // true se upper è stato determinato
 
         /**
          * @brief Costruttore privato
          *
          * @param inputPtr è il puntatore da associare all'iteratore
          */
-        const_iterator(bst<T> *inputPtr) : ptr{inputPtr} {}
+        const_iterator(bst<T, CMP, AUG> *inputPtr) : ptr{inputPtr}, lower{nullptr}, upper{nullptr}, lowerKnown{false}, upperKnown{false} {}
+
+        /**
+         * @brief Costruttore privato con i limiti dell'intervallo di chiavi del sottoalbero di inputPtr
+         *
+         * @param inputPtr è il puntatore da associare all'iteratore
+         * @param bounds sono i limiti del sottoalbero, già determinati o meno
+         */
+        const_iterator(bst<T, CMP, AUG> *inputPtr, const const_iterator &bounds)
+            : ptr{inputPtr}, lower{bounds.lower}, upper{bounds.upper}, lowerKnown{bounds.lowerKnown}, upperKnown{bounds.upperKnown} {}
+
+        /**
+         * @brief Dimentica i limiti memorizzati (dopo uno spostamento dell'iteratore)
+         */
+        inline void forget()
+        {
+            lowerKnown = false;
+            upperKnown = false;
+        }
 
     public:
         using iterator_category = std::input_iterator_tag; // categoria di iteratore (nota: in realtà è un'estensione di un operatore di input
                                                            // con funzionalità di un operatore ad accesso casuale)
         using difference_type = std::ptrdiff_t;            // il tipo della differenza tra iteratori
-        using value_type = bst<T>;                         // il valore trattato dall'iteratore
+        using value_type = bst<T, CMP, AUG>;                      // il valore trattato dall'iteratore
         using pointer = const value_type *;                // il tipo puntatore
         using reference = const value_type &;              // il tipo riferimento
 
         /**
          * @brief Costruttore vuoto pubblico
          */
-        const_iterator() : ptr{nullptr} {}
+        const_iterator() : ptr{nullptr}, lower{nullptr}, upper{nullptr}, lowerKnown{false}, upperKnown{false} {}
 
         /**
          * @brief Operatore di incremento prefisso
@@ -108,7 +1174,8 @@ public:
          */
         const_iterator &operator++()
         {
-            ptr = ptr->successor();
+            ptr = nextNode(ptr); // Dopo il massimo si arriva a cend() anche se il massimo è la radice
+            forget();
             return *this;
         }
 
@@ -120,7 +1187,8 @@ public:
         const_iterator operator++(int)
         {
             const_iterator current{*this}; // copia dell'iteratore corrente
-            ptr = ptr->successor();
+            ptr = nextNode(ptr);
+            forget();
             return current;
         }
 
@@ -132,6 +1200,7 @@ public:
         const_iterator &operator--()
         {
             ptr = ptr->predecessor();
+            forget();
             return *this;
         }
 
@@ -144,6 +1213,7 @@ public:
         {
             const_iterator current{*this}; // copia dell'iteratore corrente
             ptr = ptr->predecessor();
+            forget();
             return current;
         }
 
@@ -219,96 +1289,351 @@ public:
             return ptr != it.ptr;
         }
 
-        friend class bst<T>;
+        friend class bst<T, CMP, AUG>;
     };
 
+protected:
+    /**
+     * @brief Inserimento iterativo nel sottoalbero di un iteratore, aggiornando i limiti dell'iteratore durante la discesa
+     * Il chiamante deve garantire che value rispetti i limiti imposti dagli antenati di from.
+     *
+     * @param from è l'iteratore alla radice (non vuota) del sottoalbero da cui parte la discesa
+     * @param value è il valore da inserire
+     * @return const_iterator al nodo appena creato, con i limiti del suo sottoalbero noti se lo erano quelli di from
+     */
+    static const_iterator insertBelow(const_iterator from, const T &value)
+    {
+        bst<T, CMP, AUG> *node{from.ptr};
+        while (true)
+        {
+            bool greater{node->cmp(value, node->key)}; // Maggiori a destra, minori (o uguali) a sinistra
+            if (greater)
+            {
+                from.lower = node;
+                from.lowerKnown = true;
+            }
+            else
+            {
+                from.upper = node;
+                from.upperKnown = true;
+            }
+            bst<T, CMP, AUG> *&child{greater ? node->right : node->left};
+            if (child == nullptr)
+            {
+                child = new bst<T, CMP, AUG>(value);
+                child->parent = node;
+                fixUpward(node);
+                from.ptr = child;
+                return from;
+            }
+            node = child;
+        }
+    }
+
+    /**
+     * @brief Iteratore a un nodo che si trova nella radice, il cui sottoalbero (l'intero albero) non ha limiti
+     *
+     * @param root è la radice dell'albero
+     * @return const_iterator alla radice con i limiti noti
+     */
+    static const_iterator rootIterator(bst<T, CMP, AUG> *root)
+    {
+        const_iterator it{root};
+        it.lowerKnown = true;
+        it.upperKnown = true;
+        return it;
+    }
+
+    /**
+     * @brief Risale da un iteratore fino al primo nodo il cui sottoalbero può contenere value
+     *
+     * L'intervallo di chiavi del sottoalbero di un nodo è (lower, upper], dove lower e upper sono gli antenati più vicini
+     * che hanno il nodo rispettivamente nel sottoalbero destro e in quello sinistro. Se value è maggiore del nodo conta solo
+     * upper: gli antenati raggiunti risalendo da destra hanno lo stesso limite superiore e non vengono considerati, quindi
+     * se il nodo non ha un limite superiore (o value non lo supera) la discesa parte dal nodo stesso; altrimenti si passa
+     * al limite superiore e si ripete (simmetricamente se value è minore o uguale al nodo). I limiti già noti, memorizzati
+     * nell'iteratore restituito dall'operazione precedente, evitano del tutto la risalita.
+     *
+     * @param it è l'iteratore di partenza (non vuoto); al termine indica il nodo da cui scendere, con i suoi limiti
+     * @param value è la chiave da cercare o inserire
+     */
+    static void climb(const_iterator &it, const T &value);
+
+public:
+    friend class multiBst<T, CMP>;
+    friend class splayBst<T, CMP>;
+    friend class balancedBst<T, CMP>;
+    friend class bufferedBst<T, CMP>;
+    template <typename, typename, typename>
+    friend class weightedBst;
+    template <typename, typename, typename>
+    friend class indexedBst;
+    template <typename, typename, typename>
+    friend class filteredBst;
+    template <typename, typename, typename>
+    friend class merkleBst;
+    friend class loggedBst<T, CMP>;
+    template <typename>
+    friend class intervalTree;
+    friend class shardedBst<T, CMP>;
+    friend class lazyBst<T, CMP>;
+
+    /**
+     * @brief Costruttore vuoto
+     *
+     * Il nodo non punta a genitori o figli e la sua condizione di essere un nodo vuoto è espressa dall'inizializzazione di empty a true.
+     * Ovviamente il membro key presenta un certo valore, ma questo non viene reso disponibile dalla funzione getKey()
+     * e quindi di fatto il nodo è come se il nodo non avesse una chiave.
+     */
+    bst() : key{}, parent{nullptr}, left{nullptr}, right{nullptr}, count{0}, empty{true}, aug{AUG::identity()} {}
+
+    /**
+     * @brief Costruttore con passaggio dei parametri per riferimento
+     *
+     * @param inputKey è il riferimento al valore del nodo
+     */
+    bst(const T &inputKey) : key{inputKey}, parent{nullptr}, left{nullptr}, right{nullptr}, count{1}, empty{false}, aug{AUG::lift(inputKey, 1)} {}
+
+    /**
+     * @brief Costruttore con passaggio dei parametri per valore
+     *
+     * @param inputKey è la copia del valore del nodo
+     */
+    bst(const T &&inputKey) : key{inputKey}, parent{nullptr}, left{nullptr}, right{nullptr}, count{1}, empty{false}, aug{AUG::lift(inputKey, 1)} {}
+
+    /**
+     * @brief Costruttore per convertire un array in un albero binario di ricerca
+     *
+     * Gli elementi vengono inseriti in ordine dall'elemento in posizione zero dell'array, quindi è preferibile un array
+     * di input non ordinato in modo da non ottenere un albero completamente sbilanciato.
+     *
+     * @param array che si vuole convertire nell'albero binario di ricerca
+     * @param length è il riferimento alla lunghezza dell'array
+     */
+    bst(const T array[], uint &length) : bst<T, CMP, AUG>()
+    {
+        for (u_int i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    /**
+     * @brief Costruttore per convertire un array in un albero binario di ricerca
+     *
+     * Gli elementi vengono inseriti in ordine dall'elemento in posizione zero dell'array, quindi è preferibile un array
+     * di input non ordinato in modo da non ottenere un albero completamente sbilanciato.
+     *
+     * @param array che si vuole convertire nell'albero binario di ricerca
+     * @param length è la lunghezza dell'array (rvalue)
+     */
+    bst(const T array[], uint &&length) : bst<T, CMP, AUG>()
+    {
+        for (u_int i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    /**
+     * @brief Costruttore di copia
+     * Viene costruito un albero uguale all'albero puntato da orig
+     *
+     * @param orig è il nodo radice dell'albero che si vuole copiare
+     */
+    bst(const bst<T, CMP, AUG> &orig) : bst<T, CMP, AUG>()
+    {
+        if (!orig.isEmpty())
+        {
+            key = orig.getKey();
+            empty = false;
+            count = orig.count;
+            if (orig.left == nullptr) // Se il figlio sinistro non c'è non serve usare l'operatore di copia
+            {
+                left = nullptr;
+            }
+            else
+            {
+                setLeft(new bst<T, CMP, AUG>(*(orig.left))); // La copia del figlio deve puntare alla copia del genitore
+            }
+            if (orig.right == nullptr) // Se il figlio destro non c'è non serve usare l'operatore di copia
+            {
+                right = nullptr;
+            }
+            else
+            {
+                setRight(new bst<T, CMP, AUG>(*(orig.right)));
+            }
+            updateAug(this);
+        }
+    }
+
+    /**
+     * @brief Costruttore di spostamento
+     * L'albero orig cede tutti i suoi nodi e diventa vuoto
+     *
+     * @param orig è l'albero da cui spostare i nodi
+     */
+    bst(bst<T, CMP, AUG> &&orig) : bst<T, CMP, AUG>()
+    {
+        swap(orig);
+    }
+
+    /**
+     * @brief Operatore di assegnamento (per copia o per spostamento a seconda di come viene costruito other)
+     *
+     * @param other è l'albero da assegnare
+     * @return bst<T, CMP, AUG>& è il riferimento all'albero assegnato
+     */
+    bst<T, CMP, AUG> &operator=(bst<T, CMP, AUG> other)
+    {
+        swap(other);
+        return *this;
+    }
+
+    /**
+     * @brief Scambia il contenuto di due alberi
+     * Vengono scambiati la radice e i sottoalberi, aggiornando i puntatori al genitore dei figli
+     *
+     * @param other è l'albero con cui scambiare il contenuto
+     */
+    void swap(bst<T, CMP, AUG> &other)
+    {
+        swapPayload(this, &other);
+        std::swap(empty, other.empty);
+        bst<T, CMP, AUG> *otherLeft{other.left};
+        bst<T, CMP, AUG> *otherRight{other.right};
+        other.setLeft(left);
+        other.setRight(right);
+        setLeft(otherLeft);
+        setRight(otherRight);
+    }
+
+    /**
+     * @brief Ribilancia l'albero in tempo O(n) senza memoria aggiuntiva (algoritmo di Day-Stout-Warren)
+     *
+     * Utile per riparare un albero degenerato, per esempio dopo l'inserimento di dati ordinati. I nodi non vengono
+     * riallocati, ma le chiavi vengono spostate tra i nodi: i puntatori ai nodi ottenuti in precedenza possono
+     * riferirsi a chiavi diverse.
+     */
+    inline void rebalance()
+    {
+        if (!isEmpty())
+        {
+            rebalanceSubtree(this);
+        }
+    }
+
     /**
-     * @brief Costruttore vuoto
+     * @brief Riorganizza in memoria i nodi dell'albero secondo l'ordine richiesto
      *
-     * Il nodo non punta a genitori o figli e la sua condizione di essere un nodo vuoto è espressa dall'inizializzazione di empty a true.
-     * Ovviamente il membro key presenta un certo valore, ma questo non viene reso disponibile dalla funzione getKey()
-     * e quindi di fatto il nodo è come se il nodo non avesse una chiave.
+     * I nodi già posseduti dall'albero si scambiano di posto in memoria (contenuto e archi parent/left/right) in modo che
+     * il k-esimo nodo nell'ordine richiesto occupi il k-esimo indirizzo più basso (la radice resta al suo posto).
+     * La forma dell'albero non cambia e non vengono allocati nuovi nodi: la memoria aggiuntiva è un puntatore per nodo
+     * (gli indirizzi ordinati). Dopo l'operazione i puntatori ai nodi ottenuti in precedenza possono riferirsi a chiavi diverse.
+     *
+     * @param order è l'ordine da utilizzare
      */
-    bst() : parent{nullptr}, left{nullptr}, right{nullptr}, empty{true} {}
+    void relayout(layoutOrder order);
 
     /**
-     * @brief Costruttore con passaggio dei parametri per riferimento
-     *
-     * @param inputKey è il riferimento al valore del nodo
+     * @brief Compatta i nodi in memoria nell'ordine della visita simmetrica
      */
-    bst(const T &inputKey) : key{inputKey}, parent{nullptr}, left{nullptr}, right{nullptr}, empty{false} {}
+    inline void compact()
+    {
+        relayout(layoutOrder::inorder);
+    }
 
     /**
-     * @brief Costruttore con passaggio dei parametri per valore
+     * @brief Divide l'albero in corrispondenza di una chiave
      *
-     * @param inputKey è la copia del valore del nodo
+     * I nodi vengono ricollegati lungo il cammino di ricerca della chiave senza copiarne i valori,
+     * quindi il costo è O(h). L'albero su cui è invocato il metodo rimane vuoto.
+     *
+     * @param value è la chiave di divisione
+     * @return coppia di alberi: il primo con le chiavi minori di value, il secondo con quelle maggiori o uguali
      */
-    bst(const T &&inputKey) : key{inputKey}, parent{nullptr}, left{nullptr}, right{nullptr}, empty{false} {}
+    std::pair<bst<T, CMP, AUG>, bst<T, CMP, AUG>> split(const T &value)
+    {
+        bst<T, CMP, AUG> *less;
+        bst<T, CMP, AUG> *greaterEqual;
+        splitSubtree(release(), value, less, greaterEqual);
+        std::pair<bst<T, CMP, AUG>, bst<T, CMP, AUG>> result;
+        result.first.adopt(less);
+        result.second.adopt(greaterEqual);
+        return result;
+    }
 
     /**
-     * @brief Costruttore per convertire un array in un albero binario di ricerca
+     * @brief Concatena due alberi in cui tutte le chiavi di a precedono quelle di b
      *
-     * Gli elementi vengono inseriti in ordine dall'elemento in posizione zero dell'array, quindi è preferibile un array
-     * di input non ordinato in modo da non ottenere un albero completamente sbilanciato.
+     * Il minimo di b diventa la nuova radice, quindi il costo è O(h) e l'altezza del risultato supera di al più uno quella
+     * del più alto dei due alberi. bst non ha una politica di bilanciamento: una sequenza di split() e join() può far crescere
+     * l'altezza e va seguita da rebalance(), mentre balancedBst::join() ribilancia il risultato quando serve a mantenere
+     * il limite di altezza. I due alberi forniti rimangono vuoti.
      *
-     * @param array che si vuole convertire nell'albero binario di ricerca
-     * @param length è il riferimento alla lunghezza dell'array
+     * @param a è l'albero con le chiavi minori
+     * @param b è l'albero con le chiavi maggiori
+     * @return bst<T, CMP, AUG> è l'albero concatenato
      */
-    bst(const T array[], uint &length) : bst<T, CMP>()
+    static bst<T, CMP, AUG> join(bst<T, CMP, AUG> &&a, bst<T, CMP, AUG> &&b)
     {
-        for (u_int i{0}; i < length; ++i)
-        {
-            insertValue(array[i]);
-        }
+        bst<T, CMP, AUG> result;
+        result.adopt(joinSubtrees(a.release(), b.release()));
+        return result;
     }
 
     /**
-     * @brief Costruttore per convertire un array in un albero binario di ricerca
+     * @brief Concatena due alberi separati da una chiave pivot
      *
-     * Gli elementi vengono inseriti in ordine dall'elemento in posizione zero dell'array, quindi è preferibile un array
-     * di input non ordinato in modo da non ottenere un albero completamente sbilanciato.
+     * Il pivot diventa la radice con a come sottoalbero sinistro e b come sottoalbero destro, quindi il costo è O(1) e
+     * l'altezza supera di uno quella del più alto dei due alberi; come per join(a, b) il bilanciamento è mantenuto solo
+     * da balancedBst::join().
+     * Tutte le chiavi di a devono essere minori o uguali al pivot e quelle di b maggiori. I due alberi forniti rimangono vuoti.
      *
-     * @param array che si vuole convertire nell'albero binario di ricerca
-     * @param length è la lunghezza dell'array (rvalue)
+     * @param a è l'albero con le chiavi minori
+     * @param pivot è la chiave che separa i due alberi
+     * @param b è l'albero con le chiavi maggiori
+     * @return bst<T, CMP, AUG> è l'albero concatenato
      */
-    bst(const T array[], uint &&length) : bst<T, CMP>()
+    static bst<T, CMP, AUG> join(bst<T, CMP, AUG> &&a, const T &pivot, bst<T, CMP, AUG> &&b)
     {
-        for (u_int i{0}; i < length; ++i)
+        bst<T, CMP, AUG> result(pivot);
+        result.setLeft(a.release());
+        result.setRight(b.release());
+        return result;
+    }
+
+    /**
+     * @brief Allocazione dei nodi tramite nodePool
+     * I nodi vengono ricavati da blocchi contigui invece che da singole allocazioni sullo heap
+     *
+     * @param size è la dimensione dell'oggetto da allocare
+     * @return void* è il puntatore alla memoria allocata
+     */
+    static void *operator new(std::size_t size)
+    {
+        if (size != sizeof(bst<T, CMP, AUG>)) // Classi derivate con membri aggiuntivi usano l'allocatore globale
         {
-            insertValue(array[i]);
+            return ::operator new(size);
         }
+        return nodePool<sizeof(bst<T, CMP, AUG>), alignof(bst<T, CMP, AUG>)>::instance().allocate();
     }
 
     /**
-     * @brief Costruttore di copia
-     * Viene costruito un albero uguale all'albero puntato da orig
+     * @brief Deallocazione dei nodi tramite nodePool
      *
-     * @param orig è il nodo radice dell'albero che si vuole copiare
+     * @param p è il puntatore alla memoria da liberare
+     * @param size è la dimensione dell'oggetto da liberare
      */
-    bst(const bst<T, CMP> &orig) : bst<T, CMP>()
+    static void operator delete(void *p, std::size_t size)
     {
-        if (!orig.isEmpty())
+        if (size != sizeof(bst<T, CMP, AUG>))
         {
-            key = orig.getKey();
-            empty = false;
-            parent = orig.parent;
-            if (orig.left == nullptr) // Se il figlio sinistro non c'è non serve usare l'operatore di copia
-            {
-                left = nullptr;
-            }
-            else
-            {
-                left = new bst<T, CMP>(*(orig.left));
-            }
-            if (orig.right == nullptr) // Se il figlio destro non c'è non serve usare l'operatore di copia
-            {
-                right = nullptr;
-            }
-            else
-            {
-                right = new bst<T, CMP>(*(orig.right));
-            }
+            ::operator delete(p);
+            return;
         }
+        nodePool<sizeof(bst<T, CMP, AUG>), alignof(bst<T, CMP, AUG>)>::instance().deallocate(p);
     }
 
     /**
@@ -325,12 +1650,32 @@ public:
         return key;
     }
 
+    /**
+     * @brief Restituisce il numero di occorrenze della chiave memorizzate nel nodo
+     *
+     * @return naturale che rappresenta la molteplicità della chiave (1 se l'albero non è un multiset)
+     */
+    inline uint getCount() const
+    {
+        return count;
+    }
+
     /**
      * @brief Restituisce un puntatore al genitore
      *
      * @return puntatore al nodo genitore
      */
-    inline bst<T, CMP> *const getParent() const
+    inline bst<T, CMP, AUG> *const getParent()
+    {
+        return parent;
+    }
+
+    /**
+     * @brief Versione costante di getParent(): da un nodo costante si raggiungono solo nodi costanti
+     *
+     * @return puntatore costante al nodo genitore
+     */
+    inline const bst<T, CMP, AUG> *getParent() const
     {
         return parent;
     }
@@ -340,7 +1685,17 @@ public:
      *
      * @return puntatore al nodo figlio sinistro
      */
-    inline bst<T, CMP> *const getLeft() const
+    inline bst<T, CMP, AUG> *const getLeft()
+    {
+        return left;
+    }
+
+    /**
+     * @brief Versione costante di getLeft(): da un nodo costante si raggiungono solo nodi costanti
+     *
+     * @return puntatore costante al nodo figlio sinistro
+     */
+    inline const bst<T, CMP, AUG> *getLeft() const
     {
         return left;
     }
@@ -350,7 +1705,17 @@ public:
      *
      * @return puntatore al nodo figlio destro
      */
-    inline bst<T, CMP> *const getRight() const
+    inline bst<T, CMP, AUG> *const getRight()
+    {
+        return right;
+    }
+
+    /**
+     * @brief Versione costante di getRight(): da un nodo costante si raggiungono solo nodi costanti
+     *
+     * @return puntatore costante al nodo figlio destro
+     */
+    inline const bst<T, CMP, AUG> *getRight() const
     {
         return right;
     }
@@ -377,7 +1742,7 @@ public:
      *
      * @return puntatore al nodo con valore minimo
      */
-    bst<T, CMP> *const min()
+    bst<T, CMP, AUG> *const min()
     {
         if (left == nullptr) // Se siamo alla fine del ramo sinistro (dove ci sono i numeri minori per definizione di bst)
         {
@@ -394,7 +1759,7 @@ public:
      *
      * @return puntatore al nodo con valore massimo
      */
-    bst<T, CMP> *const max()
+    bst<T, CMP, AUG> *const max()
     {
         if (right == nullptr) // Se siamo alla fine del ramo destro (dove ci sono i numeri maggiori per definizione di bst)
         {
@@ -411,23 +1776,23 @@ public:
      *
      * @return puntatore al nuovo albero
      */
-    bst<T, CMP> *insertValue(const T &value);
+    bst<T, CMP, AUG> *insertValue(const T &value);
 
     /**
      * @brief Inserisce un valore nell'albero (passaggio per valore)
      *
      * @return puntatore al nuovo albero
      */
-    bst<T, CMP> *insertValue(const T &&value);
+    bst<T, CMP, AUG> *insertValue(const T &&value);
 
     /**
      * @brief Funzione ausiliaria di insertValue() per inserire un nodo nel sottoalbero sinistro di un nodo
      *
      * @param node è l'albero su cui si sta aggiungendo il nodo
      * @param value è il valore del nodo da aggiungere
-     * @return bst<T, CMP>* puntatore all'albero aggiornato con il nuovo nodo
+     * @return bst<T, CMP, AUG>* puntatore all'albero aggiornato con il nuovo nodo
      */
-    static bst<T, CMP> *insertLeft(bst<T, CMP> *node, const T &value);
+    static bst<T, CMP, AUG> *insertLeft(bst<T, CMP, AUG> *node, const T &value);
 
     /**
      * @brief Funzione ausiliaria di insertValue() per inserire un nodo nel sottoalbero destro di un nodo
@@ -436,9 +1801,60 @@ public:
      *
      * @param node è l'albero su cui si sta aggiungendo il nodo
      * @param value è il valore del nodo da aggiungere
-     * @return bst<T, CMP>* puntatore all'albero aggiornato con il nuovo nodo
+     * @return bst<T, CMP, AUG>* puntatore all'albero aggiornato con il nuovo nodo
+     */
+    static bst<T, CMP, AUG> *insertRight(bst<T, CMP, AUG> *node, const T &value);
+
+    /**
+     * @brief Inserisce un lotto di valori non ordinati usando più thread
+     *
+     * Il lotto viene copiato e ordinato in parallelo, poi diviso secondo le chiavi dei nodi scendendo dalla radice:
+     * le parti destinate a sottoalberi disgiunti vengono inserite in parallelo con una sola discesa per sottoalbero
+     * (i valori che finiscono sotto un figlio mancante formano un sottoalbero bilanciato). Il lavoro viene diviso in
+     * compiti eseguiti dai thread di workerPool, creati una sola volta e limitati dal numero di core; ogni thread alloca
+     * i nodi dalla propria lista di nodePool. Il risultato è lo stesso di insertValue() chiamato su ogni valore.
+     *
+     * @tparam IT è il tipo degli iteratori del lotto
+     * @param first è l'iteratore al primo valore
+     * @param last è l'iteratore successivo all'ultimo valore
+     * @param threadCount è il numero massimo di compiti paralleli (arrotondato alla potenza di due successiva)
+     */
+    template <typename IT>
+    void insertBatch(IT first, IT last, uint threadCount = std::thread::hardware_concurrency())
+    {
+        mergeBatch(std::vector<T>(first, last), threadCount);
+    }
+
+    /**
+     * @brief Inserisce un valore partendo da un nodo vicino (finger) invece che dalla radice
+     *
+     * Dal nodo indicato da hint si risale solo fino al primo nodo il cui sottoalbero può contenere value
+     * (vedi climb()), poi si scende come in un normale inserimento, con lo stesso risultato di insertValue(value).
+     * L'iteratore restituito memorizza gli antenati che delimitano il sottoalbero del nuovo nodo: con input ordinato
+     * o raggruppato, usando come hint l'iteratore restituito dall'inserimento precedente, la risalita non visita alcun
+     * nodo e ogni inserimento costa O(1) ammortizzato più la discesa verso il nodo vicino.
+     * Gli antenati memorizzati restano validi finché l'albero viene modificato solo con inserimenti: dopo cancellazioni,
+     * rotazioni o ribilanciamenti un iteratore ottenuto in precedenza non va usato come hint.
+     *
+     * @param hint è l'iteratore al nodo da cui partire (se vuoto si parte dalla radice)
+     * @param value è il valore da inserire
+     * @return const_iterator al nodo appena inserito
      */
-    static bst<T, CMP> *insertRight(bst<T, CMP> *node, const T &value);
+    const_iterator insertValue(const_iterator hint, const T &value);
+
+    /**
+     * @brief Ricerca di una chiave partendo da un nodo vicino (finger) invece che dalla radice
+     *
+     * Si risale da it fino al primo nodo il cui sottoalbero può contenere la chiave (vedi climb()) e si scende da lì.
+     * Il costo dipende dalla distanza d tra it e il nodo cercato (O(log d) se l'albero è bilanciato); come per
+     * insertValue(hint, value) l'iteratore restituito memorizza i limiti del sottoalbero del nodo trovato, quindi una
+     * sequenza di ricerche in ordine crescente costa O(1) ammortizzato per ricerca.
+     *
+     * @param it è l'iteratore al nodo da cui partire (se vuoto si parte dalla radice)
+     * @param value è la chiave da cercare
+     * @return const_iterator al nodo trovato o iteratore vuoto se la chiave non è presente
+     */
+    const_iterator findFrom(const_iterator it, const T &value);
 
     /**
      * @brief Visita simmetrica
@@ -488,7 +1904,7 @@ public:
      *
      * @return puntatore al nodo successore
      */
-    bst<T, CMP> *const successor()
+    bst<T, CMP, AUG> *const successor()
     {
         if (right != nullptr)
         {
@@ -498,8 +1914,8 @@ public:
         {
             throw NonExistingValueException();
         }
-        bst<T, CMP> *y = parent;
-        bst<T, CMP> *x = this;
+        bst<T, CMP, AUG> *y = parent;
+        bst<T, CMP, AUG> *x = this;
         while ((y != nullptr) && (x == y->right))
         {
             x = y;
@@ -514,7 +1930,7 @@ public:
      *
      * @return puntatore al nodo successore
      */
-    bst<T, CMP> *const predecessor()
+    bst<T, CMP, AUG> *const predecessor()
     {
         if (left != nullptr)
         {
@@ -524,8 +1940,8 @@ public:
         {
             throw NonExistingValueException();
         }
-        bst<T, CMP> *y = parent;
-        bst<T, CMP> *x = this;
+        bst<T, CMP, AUG> *y = parent;
+        bst<T, CMP, AUG> *x = this;
         while ((y != nullptr) && (x == y->left))
         {
             x = y;
@@ -586,7 +2002,7 @@ public:
      *
      * @return puntatore al nodo che presenta la chiave desiderata
      */
-    bst<T, CMP> *const binarySearch(const T value)
+    bst<T, CMP, AUG> *const binarySearch(const T value)
     {
         if (isEmpty()) // Se l'albero/sottoalbero è vuoto
         {
@@ -594,7 +2010,7 @@ public:
         }
         else
         {
-            if (value == key) // Nodo trovato
+            if (equivalent(value, key)) // Nodo trovato
             {
                 return this;
             }
@@ -613,21 +2029,49 @@ public:
     }
 
     /**
-     * @brief Metodo che informa se è presente nell'albero un nodo (almeno uno) con un determinato valore della chiave
+     * @brief Ricerca iterativa di un valore nell'albero binario
      *
-     * @return true se il nodo è presente nell'albero
-     * @return false se il nodo non è presente nell'albero
+     * A differenza di binarySearch() non viene lanciata un'eccezione se la chiave non è presente,
+     * ma viene restituito nullptr.
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore al nodo che presenta la chiave desiderata o nullptr se non è presente
      */
-    bool isPresent(const T value) const
+    bst<T, CMP, AUG> *find(const T &value) const
     {
-        if (binarySearch(value) == nullptr)
+        if (isEmpty())
         {
-            return false;
+            return nullptr;
         }
-        else
+        const bst<T, CMP, AUG> *node{this};
+        while (node != nullptr)
         {
-            return true;
+            if (cmp(value, node->key)) // I valori maggiori si trovano a destra
+            {
+                node = node->right;
+            }
+            else if (cmp(node->key, value)) // I valori minori si trovano a sinistra
+            {
+                node = node->left;
+            }
+            else // Nodo trovato
+            {
+                return const_cast<bst<T, CMP, AUG> *>(node);
+            }
         }
+        return nullptr;
+    }
+
+    /**
+     * @brief Metodo che informa se è presente nell'albero un nodo (almeno uno) con un determinato valore della chiave
+     * A differenza di binarySearch() non lancia eccezioni se la chiave non è presente.
+     *
+     * @return true se il nodo è presente nell'albero
+     * @return false se il nodo non è presente nell'albero
+     */
+    bool isPresent(const T value) const
+    {
+        return find(value) != nullptr;
     }
 
     /**
@@ -638,6 +2082,7 @@ public:
      */
     void remove()
     {
+        bst<T, CMP, AUG> *up{parent}; // Gli antenati perdono il sottoalbero e vanno aggiornati
         if (parent != nullptr) // Se la radice del sottoalbero ha il genitore
         {
             if (this == parent->left) // Se il nodo radice è il figlio sinistro
@@ -650,6 +2095,7 @@ public:
             }
         }
         delete this;
+        fixUpward(up);
     }
 
     /**
@@ -665,6 +2111,126 @@ public:
         deleteKey(binarySearch(key)); // viene chiamata una funzione ausiliaria che eliminerà effettivamente il nodo corrispondente alla chiave fornita
     }
 
+    /**
+     * @brief Eliminazione di tutte le chiavi comprese in un intervallo chiuso [a, b]
+     *
+     * Si scende solo lungo i due cammini che delimitano l'intervallo: i sottoalberi compresi interamente
+     * nell'intervallo vengono staccati e liberati in un solo passo e il nodo che separa i due cammini è sostituito
+     * dall'unione dei sottoalberi rimasti, quindi il costo è O(h + k) per k nodi eliminati invece di k ricerche dalla radice.
+     * L'unione non aumenta l'altezza ma nemmeno la riduce: se i nodi eliminati sono più di quelli rimasti l'albero viene
+     * ribilanciato con rebalance(), che costa O(n) sui meno di k nodi rimasti. In questo caso i puntatori ai nodi ottenuti
+     * in precedenza possono riferirsi a chiavi diverse.
+     *
+     * @param a è l'estremo sinistro dell'intervallo
+     * @param b è l'estremo destro dell'intervallo
+     * @return numero di nodi eliminati
+     */
+    u_int eraseRange(const T &a, const T &b)
+    {
+        auto aboveLow{[this, &a](const T &k)
+                      { return !cmp(a, k); }};
+        auto belowHigh{[this, &b](const T &k)
+                       { return !cmp(k, b); }};
+        return eraseBetween(aboveLow, belowHigh);
+    }
+
+    /**
+     * @brief Eliminazione dei nodi compresi tra due iteratori
+     *
+     * Vengono eliminate le chiavi comprese tra quella di first (inclusa) e quella di last (esclusa);
+     * se last è un iteratore vuoto si elimina fino al massimo dell'albero.
+     *
+     * @param first è l'iteratore al primo nodo da eliminare
+     * @param last è l'iteratore al primo nodo da non eliminare
+     * @return numero di nodi eliminati
+     */
+    u_int erase(const_iterator first, const_iterator last)
+    {
+        if (first.ptr == nullptr || first == last)
+        {
+            return 0;
+        }
+        const T a{first.ptr->key};
+        if (last.ptr == nullptr)
+        {
+            auto aboveLow{[this, &a](const T &k)
+                          { return !cmp(a, k); }};
+            auto unbounded{[](const T &)
+                           { return true; }};
+            return eraseBetween(aboveLow, unbounded);
+        }
+        const T b{last.ptr->key};
+        auto aboveLow{[this, &a](const T &k)
+                      { return !cmp(a, k); }};
+        auto belowHigh{[this, &b](const T &k)
+                       { return cmp(b, k); }};
+        return eraseBetween(aboveLow, belowHigh);
+    }
+
+    /**
+     * @brief Eliminazione di tutti i nodi la cui chiave soddisfa un predicato
+     *
+     * L'albero viene visitato una sola volta in ordine posticipato e ogni nodo eliminato viene sostituito
+     * dall'unione dei suoi sottoalberi già filtrati, quindi il costo è O(n). Come in eraseRange(), se i nodi eliminati
+     * sono più di quelli rimasti l'albero viene ribilanciato con rebalance().
+     *
+     * @tparam PRED è il tipo del predicato
+     * @param pred è il predicato che indica le chiavi da eliminare
+     * @return numero di nodi eliminati
+     */
+    template <typename PRED>
+    u_int eraseIf(PRED pred)
+    {
+        u_int erased{0};
+        if (isEmpty())
+        {
+            return erased;
+        }
+        setLeft(pruneIf(left, pred, erased));
+        setRight(pruneIf(right, pred, erased));
+        if (pred(key))
+        {
+            deleteRoot();
+            ++erased;
+        }
+        return rebalanceAfterErase(erased);
+    }
+
+    /**
+     * @brief Aggregato di tutte le chiavi dell'albero secondo l'aumento AUG
+     *
+     * @return typename AUG::value_type è l'aumento della radice (AUG::identity() se l'albero è vuoto)
+     */
+    inline typename AUG::value_type aggregate() const
+    {
+        static_assert(AUG::enabled, "aggregate() richiede un aumento");
+        return isEmpty() ? AUG::identity() : aug;
+    }
+
+    /**
+     * @brief Aggregato delle chiavi comprese in un intervallo chiuso [a, b] secondo l'aumento AUG
+     *
+     * Per i sottoalberi compresi interamente nell'intervallo si usa l'aumento memorizzato nella radice, quindi il costo
+     * è O(h) (O(log n) in un albero bilanciato) invece di una visita di tutte le chiavi dell'intervallo.
+     *
+     * @param a è l'estremo sinistro dell'intervallo
+     * @param b è l'estremo destro dell'intervallo
+     * @return typename AUG::value_type è l'aggregato (AUG::identity() se nessuna chiave è nell'intervallo)
+     */
+    typename AUG::value_type aggregate(const T &a, const T &b) const
+    {
+        static_assert(AUG::enabled, "aggregate() richiede un aumento");
+        if (isEmpty())
+        {
+            return AUG::identity();
+        }
+        auto aboveLow{[this, &a](const T &k)
+                      { return !cmp(a, k); }};
+        auto belowHigh{[this, &b](const T &k)
+                       { return !cmp(k, b); }};
+        return aggregateRange(this, false, false, aboveLow, belowHigh);
+    }
+
     /**
      * @brief Metodo per ottenere l'altezza dell'albero
      *
@@ -722,6 +2288,20 @@ public:
         return const_iterator{max()};
     }
 
+    /**
+     * @brief Metodo che restituisce l'iteratore successivo all'ultimo valore dell'albero
+     * A differenza di end(), che per compatibilità punta al massimo, cend() è la sentinella su cui termina una visita
+     * completa ed è lo stesso iteratore restituito da findFrom() quando la chiave non è presente (find() invece restituisce
+     * un puntatore, nullptr se la chiave manca). btree e vebTree hanno lo stesso metodo, quindi il codice generico scorre
+     * le chiavi con `for (it = t.begin(); it != t.cend(); ++it)`.
+     *
+     * @return const_iterator vuoto, successivo all'ultimo valore dell'albero
+     */
+    inline const_iterator cend() const
+    {
+        return const_iterator{};
+    }
+
     ~bst()
     {
         delete left;
@@ -729,8 +2309,8 @@ public:
     }
 };
 
-template <typename T, typename CMP>
-bst<T, CMP> *bst<T, CMP>::insertValue(const T &value)
+template <typename T, typename CMP, typename AUG>
+bst<T, CMP, AUG> *bst<T, CMP, AUG>::insertValue(const T &value)
 {
     if (isEmpty())
     {
@@ -738,11 +2318,13 @@ bst<T, CMP> *bst<T, CMP>::insertValue(const T &value)
         {
             empty = false; // Non è più vuoto
             key = value;   // inizializza valore della chiave
+            count = 1;
+            updateAug(this);
             return this;
         }
         else // Se l'albero è vuoto e non punta a nulla
         {
-            return new bst<T, CMP>(value); // Restituisce un albero creato con value come chiave associata alla radice
+            return new bst<T, CMP, AUG>(value); // Restituisce un albero creato con value come chiave associata alla radice
         }
     }
     else
@@ -754,8 +2336,8 @@ bst<T, CMP> *bst<T, CMP>::insertValue(const T &value)
     }
 }
 
-template <typename T, typename CMP>
-bst<T, CMP> *bst<T, CMP>::insertValue(const T &&value)
+template <typename T, typename CMP, typename AUG>
+bst<T, CMP, AUG> *bst<T, CMP, AUG>::insertValue(const T &&value)
 {
     if (isEmpty())
     {
@@ -763,11 +2345,13 @@ bst<T, CMP> *bst<T, CMP>::insertValue(const T &&value)
         {
             empty = false;
             key = value; // inizializza valore della chiave
+            count = 1;
+            updateAug(this);
             return this;
         }
         else // Se l'albero è vuoto e non punta a nulla
         {
-            return new bst<T, CMP>(value); // Restituisce un albero creato con il value come radice
+            return new bst<T, CMP, AUG>(value); // Restituisce un albero creato con il value come radice
         }
     }
     else
@@ -779,25 +2363,232 @@ bst<T, CMP> *bst<T, CMP>::insertValue(const T &&value)
     }
 }
 
-template <typename T, typename CMP>
-bst<T, CMP> *bst<T, CMP>::insertLeft(bst<T, CMP> *node, const T &value)
+template <typename T, typename CMP, typename AUG>
+bst<T, CMP, AUG> *bst<T, CMP, AUG>::insertLeft(bst<T, CMP, AUG> *node, const T &value)
 {
     node->left = node->left->insertValue(value); // Inserisci valore nel sottoalbero sinistro
     node->left->parent = node;
+    updateAug(node);
     return node;
 }
 
-template <typename T, typename CMP>
-bst<T, CMP> *bst<T, CMP>::insertRight(bst<T, CMP> *node, const T &value)
+template <typename T, typename CMP, typename AUG>
+bst<T, CMP, AUG> *bst<T, CMP, AUG>::insertRight(bst<T, CMP, AUG> *node, const T &value)
 {
     node->right = node->right->insertValue(value); // Inserisci valore nel sottoalbero destro
     node->right->parent = node;
+    updateAug(node);
     return node;
 }
 
-template <typename T, typename CMP>
-void bst<T, CMP>::deleteKey(bst<T, CMP> *keyNode)
+template <typename T, typename CMP, typename AUG>
+void bst<T, CMP, AUG>::relayout(layoutOrder order)
+{
+    if (isEmpty())
+    {
+        return;
+    }
+    // Indirizzi posseduti dall'albero (radice esclusa) in ordine crescente: sono l'unica memoria aggiuntiva
+    std::vector<bst<T, CMP, AUG> *> addresses;
+    for (bst<T, CMP, AUG> *node{min()}; node != nullptr; node = nextNode(node))
+    {
+        if (node != this)
+        {
+            addresses.push_back(node);
+        }
+    }
+    std::sort(addresses.begin(), addresses.end(), std::less<bst<T, CMP, AUG> *>());
+
+    // Il k-esimo nodo collocato si scambia di posto con quello che occupa il k-esimo indirizzo. I primi k indirizzi
+    // contengono sempre i nodi già collocati, quindi lo scambio sposta solo nodi ancora da collocare.
+    std::size_t placed{0};
+    auto place{[&](bst<T, CMP, AUG> *node)
+               {
+                   if (node == this)
+                   {
+                       return node;
+                   }
+                   bst<T, CMP, AUG> *destination{addresses[placed++]};
+                   if (destination != node)
+                   {
+                       exchangeNodes(node, destination);
+                   }
+                   return destination;
+               }};
+
+    if (order == layoutOrder::inorder)
+    {
+        for (bst<T, CMP, AUG> *node{min()}; node != nullptr; node = nextNode(node))
+        {
+            node = place(node);
+        }
+    }
+    else
+    {
+        // Visita in ordine di van Emde Boas: prima il sottoalbero superiore di altezza h/2, poi quelli inferiori.
+        // I nodi ancora da collocare possono cambiare indirizzo, quindi vengono sempre riletti dai genitori già collocati.
+        std::function<bst<T, CMP, AUG> *(bst<T, CMP, AUG> *, uint)> vebPlace;
+        std::function<void(bst<T, CMP, AUG> *, uint, uint)> placeBottoms{[&](bst<T, CMP, AUG> *node, uint depth, uint levels)
+                                                                         {
+                                                                             if (depth == 1)
+                                                                             {
+                                                                                 if (node->left != nullptr)
+                                                                                 {
+                                                                                     vebPlace(node->left, levels);
+                                                                                 }
+                                                                                 if (node->right != nullptr) // Riletto dopo aver collocato il sottoalbero sinistro
+                                                                                 {
+                                                                                     vebPlace(node->right, levels);
+                                                                                 }
+                                                                                 return;
+                                                                             }
+                                                                             if (node->left != nullptr)
+                                                                             {
+                                                                                 placeBottoms(node->left, depth - 1, levels);
+                                                                             }
+                                                                             if (node->right != nullptr)
+                                                                             {
+                                                                                 placeBottoms(node->right, depth - 1, levels);
+                                                                             }
+                                                                         }};
+        vebPlace = [&](bst<T, CMP, AUG> *node, uint levels)
+        {
+            if (levels == 1)
+            {
+                return place(node);
+            }
+            uint top{levels / 2};
+            node = vebPlace(node, top);
+            placeBottoms(node, top, levels - top);
+            return node;
+        };
+        vebPlace(this, height());
+    }
+}
+
+template <typename T, typename CMP, typename AUG>
+void bst<T, CMP, AUG>::climb(const_iterator &it, const T &value)
+{
+    bst<T, CMP, AUG> *node{it.ptr};
+    while (true)
+    {
+        if (node->cmp(value, node->key)) // value è maggiore del nodo: conta solo il limite superiore
+        {
+            if (!it.upperKnown) // Gli antenati raggiunti risalendo da destra hanno lo stesso limite superiore del nodo
+            {
+                bst<T, CMP, AUG> *x{node};
+                while (x->parent != nullptr && x == x->parent->right)
+                {
+                    if (!it.lowerKnown) // Il primo di essi è il limite inferiore del nodo
+                    {
+                        it.lower = x->parent;
+                        it.lowerKnown = true;
+                    }
+                    x = x->parent;
+                }
+                it.upper = x->parent;
+                it.upperKnown = true;
+            }
+            if (it.upper == nullptr || !node->cmp(value, it.upper->key)) // value <= upper: appartiene al sottoalbero del nodo
+            {
+                break;
+            }
+            node = it.upper;
+        }
+        else // value è minore o uguale al nodo: conta solo il limite inferiore
+        {
+            if (!it.lowerKnown)
+            {
+                bst<T, CMP, AUG> *x{node};
+                while (x->parent != nullptr && x == x->parent->left)
+                {
+                    if (!it.upperKnown)
+                    {
+                        it.upper = x->parent;
+                        it.upperKnown = true;
+                    }
+                    x = x->parent;
+                }
+                it.lower = x->parent;
+                it.lowerKnown = true;
+            }
+            if (it.lower == nullptr || node->cmp(value, it.lower->key)) // value > lower: appartiene al sottoalbero del nodo
+            {
+                break;
+            }
+            node = it.lower;
+        }
+        it.forget(); // I limiti del nuovo nodo vanno determinati di nuovo
+    }
+    it.ptr = node;
+}
+
+template <typename T, typename CMP, typename AUG>
+typename bst<T, CMP, AUG>::const_iterator bst<T, CMP, AUG>::insertValue(const_iterator hint, const T &value)
+{
+    if (isEmpty())
+    {
+        return rootIterator(insertNode(value));
+    }
+    if (hint.ptr == nullptr)
+    {
+        hint = rootIterator(this);
+    }
+    climb(hint, value);
+    return insertBelow(hint, value);
+}
+
+template <typename T, typename CMP, typename AUG>
+typename bst<T, CMP, AUG>::const_iterator bst<T, CMP, AUG>::findFrom(const_iterator it, const T &value)
+{
+    if (isEmpty())
+    {
+        return const_iterator{};
+    }
+    if (it.ptr == nullptr)
+    {
+        it = rootIterator(this);
+    }
+    if (equivalent(value, it.ptr->key))
+    {
+        return it;
+    }
+    climb(it, value);
+    if (it.upper != nullptr && equivalent(value, it.upper->key)) // Il limite superiore non appartiene al sottoalbero
+    {
+        return const_iterator{it.upper};
+    }
+    for (bst<T, CMP, AUG> *node{it.ptr}; node != nullptr;)
+    {
+        if (cmp(value, node->key))
+        {
+            it.lower = node;
+            it.lowerKnown = true;
+            node = node->right;
+        }
+        else if (cmp(node->key, value))
+        {
+            it.upper = node;
+            it.upperKnown = true;
+            node = node->left;
+        }
+        else
+        {
+            return const_iterator{node, it};
+        }
+    }
+    return const_iterator{};
+}
+
+template <typename T, typename CMP, typename AUG>
+void bst<T, CMP, AUG>::deleteKey(bst<T, CMP, AUG> *keyNode)
 {
+    if (keyNode->parent == nullptr) // La radice non può essere sostituita con un altro nodo
+    {
+        keyNode->deleteRoot();
+        return;
+    }
+    bst<T, CMP, AUG> *changed{keyNode->parent}; // Nodo più profondo il cui sottoalbero cambia
     if (keyNode->left == nullptr) // Se non ha un figlio sinistro
     {
         nodeChange(keyNode, keyNode->right); // Il figlio destro prende il suo posto
@@ -808,7 +2599,8 @@ void bst<T, CMP>::deleteKey(bst<T, CMP> *keyNode)
     }
     else // Se ha entrambi i figli
     {
-        bst<T, CMP> *S{keyNode->successor()};
+        bst<T, CMP, AUG> *S{keyNode->successor()};
+        changed = S->parent == keyNode ? S : S->parent;
         if (S->parent != keyNode) // Se il successore non è il figlio del nodo da eliminare
         {
             nodeChange(S, S->right);   // Il figlio destro sostituisce il successore
@@ -822,10 +2614,11 @@ void bst<T, CMP>::deleteKey(bst<T, CMP> *keyNode)
     keyNode->left = nullptr;  // È necessario eliminare i puntatori ai figli (che adesso non riconoscono più keyNode come padre)
     keyNode->right = nullptr; // altrimenti verrano erroneamente eliminati dal distruttore
     delete keyNode;
+    fixUpward(changed);
 }
 
-template <typename T, typename CMP>
-void bst<T, CMP>::nodeChange(bst<T, CMP> *nodeA, bst<T, CMP> *nodeB)
+template <typename T, typename CMP, typename AUG>
+void bst<T, CMP, AUG>::nodeChange(bst<T, CMP, AUG> *nodeA, bst<T, CMP, AUG> *nodeB)
 {
     if (nodeA->parent == nullptr) // Se nodeA è la root
     {
@@ -858,12 +2651,13 @@ void bst<T, CMP>::nodeChange(bst<T, CMP> *nodeA, bst<T, CMP> *nodeB)
  *
  * @tparam T è il tipo di elementi dell'albero
  * @tparam CMP è la relazione d'ordine degli elementi dell'albero
+ * @tparam AUG è l'aumento mantenuto nei nodi
  * @param os è lo stream su cui stampare
  * @param tree è l'albero da stampare
  * @return std::ostream& è un riferimento allo stream su cui abbiamo stampato
  */
-template <typename T, typename CMP>
-std::ostream &operator<<(std::ostream &os, const bst<T, CMP> &tree)
+template <typename T, typename CMP, typename AUG>
+std::ostream &operator<<(std::ostream &os, const bst<T, CMP, AUG> &tree)
 {
     if (tree.isEmpty())
     {
@@ -60,4 +60,46 @@ public:
     }
 };
 
+/**
+ * @brief Classe per la gestione degli errori di lettura e scrittura dei file di log e delle istantanee di un albero
+ *
+ * @param file è il percorso del file che ha provocato l'errore
+ * @param reason è la descrizione dell'errore
+ */
+class LogIOException : public std::exception
+{
+private:
+    std::string file;
+    std::string reason;
+
+public:
+    /**
+     * @brief Costruttore per l'eccezione con informazioni sul file
+     *
+     * @param inputFile è il percorso del file
+     * @param inputReason è la descrizione dell'errore
+     */
+    LogIOException(const std::string &inputFile, const std::string &inputReason) : file{inputFile}, reason{inputReason} {}
+
+    /**
+     * @brief Resituisce informazioni sull'errore
+     *
+     * @return stringa con le informazioni sull'errore
+     */
+    const char *what() const throw()
+    {
+        return "Error while accessing the log of the tree";
+    }
+
+    /**
+     * @brief Resituisce informazioni sul file che ha generato l'errore
+     *
+     * @return stringa con il file e la descrizione dell'errore
+     */
+    std::string getInfo() const
+    {
+        return ("The file that throw the exception is " + file + ": " + reason);
+    }
+};
+
 #endif
\ No newline at end of file
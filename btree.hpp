@@ -0,0 +1,802 @@
+#ifndef __btree_hpp__
+#define __btree_hpp__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include "bstException.hpp"
+
+/**
+ * @class btree
+ *
+ * @brief B+-tree con nodi grandi alcune linee di cache e la stessa interfaccia pubblica di bst (insertValue, binarySearch,
+ * find, isPresent, deleteKey, min, max, const_iterator).
+ * Tutte le chiavi sono memorizzate nelle foglie, collegate in una lista per le visite; i nodi interni contengono solo
+ * chiavi separatrici e puntatori ai figli. Ogni nodo contiene decine di chiavi contigue, quindi una ricerca accede a
+ * log_B(n) nodi (ciascuno di poche linee di cache) invece che a log_2(n) nodi sparsi in memoria.
+ * Come in bst le chiavi duplicate sono ammesse e deleteKey() ne elimina una sola occorrenza.
+ *
+ * I metodi che in bst restituiscono un nodo restituiscono qui un puntatore a un elemento di una foglia, che ha il metodo
+ * getKey(); il puntatore resta valido fino alla modifica successiva dell'albero. A differenza di bst, end() è l'iteratore
+ * successivo all'ultimo elemento e non il massimo: il codice scritto per entrambe le classi deve terminare le visite con
+ * cend(), che in tutte e due è l'iteratore successivo all'ultimo elemento.
+ *
+ * @tparam T è il tipo di dato delle chiavi (deve avere il costruttore vuoto)
+ * @tparam CMP è la relazione d'ordine del tipo T (relazione di "maggiore" come in bst)
+ * @tparam NODE_BYTES è la dimensione indicativa di un nodo in byte (per default 4 linee di cache)
+ */
+template <typename T, typename CMP = std::greater<T>, std::size_t NODE_BYTES = 256>
+class btree
+{
+public:
+    /**
+     * @brief Elemento di una foglia: contiene una chiave
+     */
+    struct entry
+    {
+        T key;
+
+        /**
+         * @brief Restituisce la chiave dell'elemento
+         *
+         * @return const T& è il riferimento alla chiave
+         */
+        inline const T &getKey() const
+        {
+            return key;
+        }
+    };
+
+private:
+    static constexpr std::size_t leafCapacity{std::max<std::size_t>(4, (NODE_BYTES - 24) / sizeof(entry))};
+    static constexpr std::size_t innerCapacity{std::max<std::size_t>(4, (NODE_BYTES - 16) / (sizeof(T) + sizeof(void *)))};
+    static constexpr std::size_t leafMinimum{leafCapacity / 2};
+    static constexpr std::size_t innerMinimum{innerCapacity / 2};
+
+    /**
+     * @brief Intestazione comune a foglie e nodi interni
+     */
+    struct node
+    {
+        uint32_t size; // numero di chiavi del nodo
+        bool leaf;     // true se il nodo è una foglia
+    };
+
+    struct alignas(64) leafNode : node
+    {
+        leafNode *prev;               // foglia precedente nell'ordine delle chiavi
+        leafNode *next;               // foglia successiva nell'ordine delle chiavi
+        entry entries[leafCapacity]; // chiavi ordinate
+    };
+
+    struct alignas(64) innerNode : node
+    {
+        T keys[innerCapacity];             // separatori: le chiavi di children[i] sono comprese tra keys[i - 1] e keys[i]
+        node *children[innerCapacity + 1]; // figli
+    };
+
+    node *root;        // radice (nullptr se l'albero è vuoto)
+    std::size_t count; // numero di chiavi
+    CMP cmp;           // comparatore
+
+    /**
+     * @brief Relazione "minore" ricavata da CMP
+     */
+    inline bool less(const T &a, const T &b) const
+    {
+        return cmp(b, a);
+    }
+
+    /**
+     * @brief Numero di chiavi di un array minori di value (posizione della prima chiave non minore)
+     */
+    inline std::size_t lowerBound(const T *keys, std::size_t size, const T &value) const
+    {
+        return std::lower_bound(keys, keys + size, value, [this](const T &a, const T &b)
+                                { return less(a, b); }) -
+               keys;
+    }
+
+    /**
+     * @brief Numero di chiavi di un array non maggiori di value (posizione della prima chiave maggiore)
+     */
+    inline std::size_t upperBound(const T *keys, std::size_t size, const T &value) const
+    {
+        return std::upper_bound(keys, keys + size, value, [this](const T &a, const T &b)
+                                { return less(a, b); }) -
+               keys;
+    }
+
+    /**
+     * @brief Posizione della prima chiave di una foglia non minore di value
+     */
+    inline std::size_t leafLowerBound(const leafNode *leaf, const T &value) const
+    {
+        return std::lower_bound(leaf->entries, leaf->entries + leaf->size, value, [this](const entry &a, const T &b)
+                                { return less(a.key, b); }) -
+               leaf->entries;
+    }
+
+    /**
+     * @brief Posizione della prima chiave di una foglia maggiore di value
+     */
+    inline std::size_t leafUpperBound(const leafNode *leaf, const T &value) const
+    {
+        return std::upper_bound(leaf->entries, leaf->entries + leaf->size, value, [this](const T &a, const entry &b)
+                                { return less(a, b.key); }) -
+               leaf->entries;
+    }
+
+    /**
+     * @brief Libera la memoria di un sottoalbero
+     *
+     * @param n è la radice del sottoalbero (può essere nullptr)
+     */
+    static void destroy(node *n)
+    {
+        if (n == nullptr)
+        {
+            return;
+        }
+        if (n->leaf)
+        {
+            delete static_cast<leafNode *>(n);
+            return;
+        }
+        innerNode *inner{static_cast<innerNode *>(n)};
+        for (std::size_t i{0}; i <= inner->size; ++i)
+        {
+            destroy(inner->children[i]);
+        }
+        delete inner;
+    }
+
+    /**
+     * @brief Foglia più a sinistra di un sottoalbero
+     */
+    static leafNode *leftmost(node *n)
+    {
+        while (!n->leaf)
+        {
+            n = static_cast<innerNode *>(n)->children[0];
+        }
+        return static_cast<leafNode *>(n);
+    }
+
+    /**
+     * @brief Foglia più a destra di un sottoalbero
+     */
+    static leafNode *rightmost(node *n)
+    {
+        while (!n->leaf)
+        {
+            innerNode *inner{static_cast<innerNode *>(n)};
+            n = inner->children[inner->size];
+        }
+        return static_cast<leafNode *>(n);
+    }
+
+    /**
+     * @brief Inserisce un valore in un sottoalbero
+     * Se il nodo è pieno viene diviso in due: la metà destra e la chiave separatrice vengono restituite al genitore.
+     *
+     * @param n è la radice del sottoalbero
+     * @param value è il valore da inserire
+     * @param upKey è la chiave separatrice della divisione
+     * @param upNode è il nuovo nodo destro della divisione (nullptr se il nodo non è stato diviso)
+     */
+    void insertInto(node *n, const T &value, T &upKey, node *&upNode)
+    {
+        upNode = nullptr;
+        if (n->leaf)
+        {
+            leafNode *leaf{static_cast<leafNode *>(n)};
+            std::size_t pos{leafUpperBound(leaf, value)}; // I duplicati vengono inseriti dopo le occorrenze già presenti
+            if (leaf->size == leafCapacity)
+            {
+                leafNode *right{new leafNode()};
+                right->leaf = true;
+                std::size_t mid{leafCapacity / 2};
+                right->size = leafCapacity - mid;
+                std::move(leaf->entries + mid, leaf->entries + leafCapacity, right->entries);
+                leaf->size = mid;
+                right->next = leaf->next;
+                right->prev = leaf;
+                if (leaf->next != nullptr)
+                {
+                    leaf->next->prev = right;
+                }
+                leaf->next = right;
+                if (pos > mid)
+                {
+                    leaf = right;
+                    pos -= mid;
+                }
+                upNode = right;
+            }
+            std::move_backward(leaf->entries + pos, leaf->entries + leaf->size, leaf->entries + leaf->size + 1);
+            leaf->entries[pos].key = value;
+            ++leaf->size;
+            if (upNode != nullptr)
+            {
+                upKey = static_cast<leafNode *>(upNode)->entries[0].key;
+            }
+            return;
+        }
+
+        innerNode *inner{static_cast<innerNode *>(n)};
+        std::size_t i{upperBound(inner->keys, inner->size, value)};
+        T childKey;
+        node *childNode;
+        insertInto(inner->children[i], value, childKey, childNode);
+        if (childNode == nullptr)
+        {
+            return;
+        }
+        if (inner->size < innerCapacity)
+        {
+            std::move_backward(inner->keys + i, inner->keys + inner->size, inner->keys + inner->size + 1);
+            std::copy_backward(inner->children + i + 1, inner->children + inner->size + 1, inner->children + inner->size + 2);
+            inner->keys[i] = std::move(childKey);
+            inner->children[i + 1] = childNode;
+            ++inner->size;
+            return;
+        }
+
+        T keys[innerCapacity + 1]; // Divisione di un nodo interno pieno: si costruisce la sequenza completa e la si divide a metà
+        node *children[innerCapacity + 2];
+        std::move(inner->keys, inner->keys + i, keys);
+        keys[i] = std::move(childKey);
+        std::move(inner->keys + i, inner->keys + innerCapacity, keys + i + 1);
+        std::copy(inner->children, inner->children + i + 1, children);
+        children[i + 1] = childNode;
+        std::copy(inner->children + i + 1, inner->children + innerCapacity + 1, children + i + 2);
+
+        std::size_t mid{(innerCapacity + 1) / 2};
+        innerNode *right{new innerNode()};
+        right->leaf = false;
+        inner->size = mid;
+        std::move(keys, keys + mid, inner->keys);
+        std::copy(children, children + mid + 1, inner->children);
+        right->size = innerCapacity - mid;
+        std::move(keys + mid + 1, keys + innerCapacity + 1, right->keys);
+        std::copy(children + mid + 1, children + innerCapacity + 2, right->children);
+        upKey = std::move(keys[mid]);
+        upNode = right;
+    }
+
+    /**
+     * @brief Elimina un'occorrenza di un valore da un sottoalbero
+     * Le occorrenze di una chiave uguale a un separatore possono trovarsi in più figli consecutivi, che vengono provati in ordine.
+     *
+     * @param n è la radice del sottoalbero
+     * @param value è il valore da eliminare
+     * @return true se il valore è stato trovato ed eliminato
+     */
+    bool eraseFrom(node *n, const T &value)
+    {
+        if (n->leaf)
+        {
+            leafNode *leaf{static_cast<leafNode *>(n)};
+            std::size_t pos{leafLowerBound(leaf, value)};
+            if (pos == leaf->size || less(value, leaf->entries[pos].key))
+            {
+                return false;
+            }
+            std::move(leaf->entries + pos + 1, leaf->entries + leaf->size, leaf->entries + pos);
+            --leaf->size;
+            return true;
+        }
+        innerNode *inner{static_cast<innerNode *>(n)};
+        for (std::size_t i{lowerBound(inner->keys, inner->size, value)}; i <= inner->size; ++i)
+        {
+            if (eraseFrom(inner->children[i], value))
+            {
+                rebalanceChild(inner, i);
+                return true;
+            }
+            if (i == inner->size || less(value, inner->keys[i])) // I figli successivi hanno chiavi maggiori di value
+            {
+                break;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Ripristina il riempimento minimo di un figlio prendendo una chiave da un fratello o fondendolo con esso
+     *
+     * @param parent è il nodo genitore
+     * @param i è la posizione del figlio
+     */
+    void rebalanceChild(innerNode *parent, std::size_t i)
+    {
+        node *child{parent->children[i]};
+        std::size_t minimum{child->leaf ? leafMinimum : innerMinimum};
+        if (child->size >= minimum)
+        {
+            return;
+        }
+        node *left{i > 0 ? parent->children[i - 1] : nullptr};
+        node *right{i < parent->size ? parent->children[i + 1] : nullptr};
+        if (left != nullptr && left->size > minimum)
+        {
+            borrowFromLeft(parent, i);
+        }
+        else if (right != nullptr && right->size > minimum)
+        {
+            borrowFromRight(parent, i);
+        }
+        else if (left != nullptr)
+        {
+            merge(parent, i - 1);
+        }
+        else
+        {
+            merge(parent, i);
+        }
+    }
+
+    /**
+     * @brief Sposta l'ultima chiave del fratello sinistro nel figlio in posizione i
+     */
+    void borrowFromLeft(innerNode *parent, std::size_t i)
+    {
+        node *child{parent->children[i]};
+        node *left{parent->children[i - 1]};
+        if (child->leaf)
+        {
+            leafNode *c{static_cast<leafNode *>(child)}, *l{static_cast<leafNode *>(left)};
+            std::move_backward(c->entries, c->entries + c->size, c->entries + c->size + 1);
+            c->entries[0] = std::move(l->entries[l->size - 1]);
+            parent->keys[i - 1] = c->entries[0].key;
+        }
+        else
+        {
+            innerNode *c{static_cast<innerNode *>(child)}, *l{static_cast<innerNode *>(left)};
+            std::move_backward(c->keys, c->keys + c->size, c->keys + c->size + 1);
+            std::copy_backward(c->children, c->children + c->size + 1, c->children + c->size + 2);
+            c->keys[0] = std::move(parent->keys[i - 1]);
+            c->children[0] = l->children[l->size];
+            parent->keys[i - 1] = std::move(l->keys[l->size - 1]);
+        }
+        ++child->size;
+        --left->size;
+    }
+
+    /**
+     * @brief Sposta la prima chiave del fratello destro nel figlio in posizione i
+     */
+    void borrowFromRight(innerNode *parent, std::size_t i)
+    {
+        node *child{parent->children[i]};
+        node *right{parent->children[i + 1]};
+        if (child->leaf)
+        {
+            leafNode *c{static_cast<leafNode *>(child)}, *r{static_cast<leafNode *>(right)};
+            c->entries[c->size] = std::move(r->entries[0]);
+            std::move(r->entries + 1, r->entries + r->size, r->entries);
+            parent->keys[i] = r->entries[0].key;
+        }
+        else
+        {
+            innerNode *c{static_cast<innerNode *>(child)}, *r{static_cast<innerNode *>(right)};
+            c->keys[c->size] = std::move(parent->keys[i]);
+            c->children[c->size + 1] = r->children[0];
+            parent->keys[i] = std::move(r->keys[0]);
+            std::move(r->keys + 1, r->keys + r->size, r->keys);
+            std::copy(r->children + 1, r->children + r->size + 1, r->children);
+        }
+        ++child->size;
+        --right->size;
+    }
+
+    /**
+     * @brief Fonde il figlio in posizione i con il figlio in posizione i + 1
+     */
+    void merge(innerNode *parent, std::size_t i)
+    {
+        node *left{parent->children[i]};
+        node *right{parent->children[i + 1]};
+        if (left->leaf)
+        {
+            leafNode *l{static_cast<leafNode *>(left)}, *r{static_cast<leafNode *>(right)};
+            std::move(r->entries, r->entries + r->size, l->entries + l->size);
+            l->size += r->size;
+            l->next = r->next;
+            if (r->next != nullptr)
+            {
+                r->next->prev = l;
+            }
+            delete r;
+        }
+        else
+        {
+            innerNode *l{static_cast<innerNode *>(left)}, *r{static_cast<innerNode *>(right)};
+            l->keys[l->size] = std::move(parent->keys[i]);
+            std::move(r->keys, r->keys + r->size, l->keys + l->size + 1);
+            std::copy(r->children, r->children + r->size + 1, l->children + l->size + 1);
+            l->size += r->size + 1;
+            delete r;
+        }
+        std::move(parent->keys + i + 1, parent->keys + parent->size, parent->keys + i);
+        std::copy(parent->children + i + 2, parent->children + parent->size + 1, parent->children + i + 1);
+        --parent->size;
+    }
+
+    /**
+     * @brief Copia un sottoalbero collegando le foglie copiate in ordine
+     *
+     * @param n è la radice del sottoalbero da copiare
+     * @param last è l'ultima foglia copiata finora (aggiornata)
+     * @return node* è la radice della copia
+     */
+    static node *clone(const node *n, leafNode *&last)
+    {
+        if (n->leaf)
+        {
+            leafNode *copy{new leafNode(*static_cast<const leafNode *>(n))};
+            copy->prev = last;
+            copy->next = nullptr;
+            if (last != nullptr)
+            {
+                last->next = copy;
+            }
+            last = copy;
+            return copy;
+        }
+        const innerNode *inner{static_cast<const innerNode *>(n)};
+        innerNode *copy{new innerNode()};
+        copy->leaf = false;
+        copy->size = inner->size;
+        std::copy(inner->keys, inner->keys + inner->size, copy->keys);
+        for (std::size_t i{0}; i <= inner->size; ++i)
+        {
+            copy->children[i] = clone(inner->children[i], last);
+        }
+        return copy;
+    }
+
+public:
+    /**
+     * @class const_iterator
+     *
+     * @brief Iteratore costante bidirezionale sulle chiavi in ordine crescente
+     */
+    class const_iterator
+    {
+    private:
+        const leafNode *leaf; // foglia corrente (nullptr per end())
+        std::size_t index;    // posizione nella foglia
+        const btree *tree;    // albero (per decrementare end())
+
+        const_iterator(const leafNode *inputLeaf, std::size_t inputIndex, const btree *inputTree) : leaf{inputLeaf}, index{inputIndex}, tree{inputTree} {}
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = entry;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        /**
+         * @brief Costruttore vuoto pubblico
+         */
+        const_iterator() : leaf{nullptr}, index{0}, tree{nullptr} {}
+
+        const_iterator &operator++()
+        {
+            if (++index == leaf->size)
+            {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator current{*this};
+            ++(*this);
+            return current;
+        }
+
+        const_iterator &operator--()
+        {
+            if (leaf == nullptr)
+            {
+                leaf = rightmost(tree->root);
+                index = leaf->size;
+            }
+            else if (index == 0)
+            {
+                leaf = leaf->prev;
+                index = leaf->size;
+            }
+            --index;
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator current{*this};
+            --(*this);
+            return current;
+        }
+
+        inline reference operator*() const
+        {
+            return leaf->entries[index];
+        }
+
+        inline pointer operator->() const
+        {
+            return &leaf->entries[index];
+        }
+
+        inline bool operator==(const const_iterator &it) const
+        {
+            return leaf == it.leaf && index == it.index;
+        }
+
+        inline bool operator!=(const const_iterator &it) const
+        {
+            return !(*this == it);
+        }
+
+        friend class btree<T, CMP, NODE_BYTES>;
+    };
+
+    /**
+     * @brief Costruttore vuoto
+     */
+    btree() : root{nullptr}, count{0} {}
+
+    /**
+     * @brief Costruttore per convertire un array in un albero
+     *
+     * @param array che si vuole convertire nell'albero
+     * @param length è la lunghezza dell'array
+     */
+    btree(const T array[], uint length) : btree()
+    {
+        for (uint i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    /**
+     * @brief Costruttore di copia
+     *
+     * @param orig è l'albero da copiare
+     */
+    btree(const btree<T, CMP, NODE_BYTES> &orig) : root{nullptr}, count{orig.count}
+    {
+        leafNode *last{nullptr};
+        root = orig.root == nullptr ? nullptr : clone(orig.root, last);
+    }
+
+    /**
+     * @brief Costruttore di spostamento
+     *
+     * @param orig è l'albero da spostare (rimane vuoto)
+     */
+    btree(btree<T, CMP, NODE_BYTES> &&orig) : root{orig.root}, count{orig.count}
+    {
+        orig.root = nullptr;
+        orig.count = 0;
+    }
+
+    /**
+     * @brief Operatore di assegnazione (per copia o per spostamento)
+     *
+     * @param other è l'albero da assegnare
+     * @return btree& è il riferimento all'albero
+     */
+    btree<T, CMP, NODE_BYTES> &operator=(btree<T, CMP, NODE_BYTES> other)
+    {
+        std::swap(root, other.root);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    ~btree()
+    {
+        destroy(root);
+    }
+
+    /**
+     * @brief Metodo che informa se l'albero è vuoto
+     */
+    inline bool isEmpty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * @brief Restituisce il numero di chiavi (come bst::nodesCount())
+     */
+    inline std::size_t nodesCount() const
+    {
+        return count;
+    }
+
+    /**
+     * @brief Restituisce il numero di livelli dell'albero
+     */
+    uint height() const
+    {
+        uint levels{0};
+        for (const node *n{root}; n != nullptr; n = n->leaf ? nullptr : static_cast<const innerNode *>(n)->children[0])
+        {
+            ++levels;
+        }
+        return levels;
+    }
+
+    /**
+     * @brief Inserisce un valore nell'albero
+     *
+     * @param value è il valore da inserire
+     * @return puntatore all'albero
+     */
+    btree<T, CMP, NODE_BYTES> *insertValue(const T &value)
+    {
+        if (root == nullptr)
+        {
+            leafNode *leaf{new leafNode()};
+            leaf->leaf = true;
+            leaf->prev = nullptr;
+            leaf->next = nullptr;
+            root = leaf;
+        }
+        T upKey;
+        node *upNode;
+        insertInto(root, value, upKey, upNode);
+        if (upNode != nullptr) // La radice è stata divisa: l'albero cresce di un livello
+        {
+            innerNode *newRoot{new innerNode()};
+            newRoot->leaf = false;
+            newRoot->size = 1;
+            newRoot->keys[0] = std::move(upKey);
+            newRoot->children[0] = root;
+            newRoot->children[1] = upNode;
+            root = newRoot;
+        }
+        ++count;
+        return this;
+    }
+
+    /**
+     * @brief Ricerca di una chiave
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore all'elemento trovato o nullptr se la chiave non è presente
+     */
+    const entry *find(const T &value) const
+    {
+        if (root == nullptr)
+        {
+            return nullptr;
+        }
+        const node *n{root};
+        while (!n->leaf)
+        {
+            const innerNode *inner{static_cast<const innerNode *>(n)};
+            n = inner->children[lowerBound(inner->keys, inner->size, value)];
+        }
+        const leafNode *leaf{static_cast<const leafNode *>(n)};
+        std::size_t pos{leafLowerBound(leaf, value)};
+        if (pos == leaf->size) // La prima occorrenza può essere all'inizio della foglia successiva
+        {
+            leaf = leaf->next;
+            pos = 0;
+        }
+        return (leaf == nullptr || less(value, leaf->entries[pos].key)) ? nullptr : &leaf->entries[pos];
+    }
+
+    /**
+     * @brief Metodo che informa se una chiave è presente (senza lanciare eccezioni)
+     *
+     * @param value è la chiave da cercare
+     * @return true se la chiave è presente
+     * @return false se la chiave non è presente
+     */
+    inline bool isPresent(const T &value) const
+    {
+        return find(value) != nullptr;
+    }
+
+    /**
+     * @brief Ricerca di una chiave
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore all'elemento trovato
+     */
+    const entry *binarySearch(const T &value) const
+    {
+        const entry *found{find(value)};
+        if (found == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        return found;
+    }
+
+    /**
+     * @brief Eliminazione di un'occorrenza di una chiave
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da eliminare
+     */
+    void deleteKey(const T &value)
+    {
+        if (root == nullptr || !eraseFrom(root, value))
+        {
+            throw NonExistingValueException(value);
+        }
+        --count;
+        if (!root->leaf && root->size == 0) // La radice con un solo figlio viene sostituita dal figlio
+        {
+            innerNode *old{static_cast<innerNode *>(root)};
+            root = old->children[0];
+            delete old;
+        }
+        else if (root->leaf && root->size == 0)
+        {
+            delete static_cast<leafNode *>(root);
+            root = nullptr;
+        }
+    }
+
+    /**
+     * @brief Restituisce l'elemento con la chiave minima
+     *
+     * @return puntatore all'elemento (nullptr se l'albero è vuoto)
+     */
+    const entry *min() const
+    {
+        return root == nullptr ? nullptr : &leftmost(root)->entries[0];
+    }
+
+    /**
+     * @brief Restituisce l'elemento con la chiave massima
+     *
+     * @return puntatore all'elemento (nullptr se l'albero è vuoto)
+     */
+    const entry *max() const
+    {
+        if (root == nullptr)
+        {
+            return nullptr;
+        }
+        leafNode *leaf{rightmost(root)};
+        return &leaf->entries[leaf->size - 1];
+    }
+
+    inline const_iterator begin() const
+    {
+        return root == nullptr ? end() : const_iterator{leftmost(root), 0, this};
+    }
+
+    inline const_iterator end() const
+    {
+        return const_iterator{nullptr, 0, this};
+    }
+
+    /**
+     * @brief Iteratore successivo all'ultimo elemento, come bst::cend() (qui coincide con end())
+     */
+    inline const_iterator cend() const
+    {
+        return end();
+    }
+};
+
+#endif
@@ -0,0 +1,482 @@
+#ifndef __bufferedBst_hpp__
+#define __bufferedBst_hpp__
+
+#include <algorithm>
+#include <vector>
+
+#include "bst.hpp"
+
+/**
+ * @class bufferedBst
+ *
+ * @brief Albero binario di ricerca ottimizzato per le scritture (inserimenti a lotti).
+ * Gli inserimenti e le cancellazioni vengono accumulati in due piccoli buffer e applicati all'albero
+ * quando il buffer è pieno (o con flush()). Un lotto di inserimenti viene fuso nell'albero visitando ogni sottoalbero
+ * interessato una sola volta, invece di una discesa completa dalla radice per ogni valore.
+ * Le ricerche (find(), binarySearch(), isPresent()) e nodesCount() tengono conto dei buffer, quindi restituiscono sempre
+ * il risultato corretto; le visite, le cancellazioni di intervalli e le operazioni che dipendono dalla forma o dall'ordine
+ * (min(), max(), iteratori, height(), ...) applicano prima i buffer. L'ereditarietà da bst è privata: le operazioni di bst
+ * che non sono riesportate (split, join, swap, remove, insertBatch, inserimento con hint, ...) ignorerebbero i buffer, e per
+ * lo stesso motivo i nodi restituiti sono costanti e insertValue() restituisce l'albero stesso.
+ *
+ * @tparam T è il tipo di dato delle chiavi associate ai nodi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ */
+template <typename T, typename CMP = std::greater<T>>
+class bufferedBst : private bst<T, CMP>
+{
+private:
+    mutable std::vector<T> pendingInserts; // inserimenti non ancora applicati (ordinati fino a sortedInserts)
+    mutable std::size_t sortedInserts;     // lunghezza del prefisso ordinato di pendingInserts
+    std::vector<T> pendingDeletes;         // cancellazioni non ancora applicate (in ordine crescente)
+    std::size_t capacity;                  // dimensione massima dei buffer
+
+    /**
+     * @brief Relazione "minore" ricavata da CMP per ordinare i buffer in modo crescente
+     */
+    struct ascending
+    {
+        CMP cmp;
+        inline bool operator()(const T &a, const T &b) const
+        {
+            return cmp(b, a);
+        }
+    };
+
+    /**
+     * @brief Ordina il buffer degli inserimenti
+     * I nuovi inserimenti vengono accodati senza ordinamento; prima di una lettura la coda viene ordinata e fusa con il prefisso già ordinato.
+     */
+    void sortInserts() const
+    {
+        if (sortedInserts < pendingInserts.size())
+        {
+            std::sort(pendingInserts.begin() + sortedInserts, pendingInserts.end(), ascending{});
+            std::inplace_merge(pendingInserts.begin(), pendingInserts.begin() + sortedInserts, pendingInserts.end(), ascending{});
+            sortedInserts = pendingInserts.size();
+        }
+    }
+
+    /**
+     * @brief Conta le occorrenze di una chiave in un buffer
+     *
+     * @param buffer è il buffer ordinato
+     * @param value è la chiave da contare
+     * @return numero di occorrenze
+     */
+    static std::size_t occurrences(const std::vector<T> &buffer, const T &value)
+    {
+        auto range{std::equal_range(buffer.begin(), buffer.end(), value, ascending{})};
+        return range.second - range.first;
+    }
+
+    /**
+     * @brief Conta le occorrenze di una chiave nel sottoalbero con radice node
+     *
+     * @param node è la radice del sottoalbero
+     * @param value è la chiave da contare
+     * @return numero di nodi con chiave equivalente a value
+     */
+    static std::size_t treeOccurrences(const bst<T, CMP> *node, const T &value)
+    {
+        std::size_t found{0};
+        while (node != nullptr)
+        {
+            if (node->cmp(value, node->key))
+            {
+                node = node->right;
+            }
+            else if (node->cmp(node->key, value))
+            {
+                node = node->left;
+            }
+            else // I duplicati possono trovarsi in entrambi i sottoalberi
+            {
+                return found + 1 + treeOccurrences(node->left, value) + treeOccurrences(node->right, value);
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief Elimina dal sottoalbero con radice node un nodo per ogni chiave di un intervallo ordinato in modo crescente
+     * Come la fusione del lotto di inserimenti, la cancellazione visita ogni sottoalbero interessato una sola volta: le
+     * chiavi minori della radice proseguono a sinistra e quelle maggiori a destra. I duplicati possono trovarsi in entrambi
+     * i sottoalberi, quindi le occorrenze della chiave della radice che non si trovano a sinistra proseguono a destra.
+     * Un nodo viene eliminato dopo i suoi sottoalberi, così le modifiche fatte da bst::deleteKey() non riguardano nodi ancora da visitare.
+     *
+     * @param node è la radice del sottoalbero (può essere nullptr)
+     * @param first è il puntatore alla prima chiave
+     * @param last è il puntatore successivo all'ultima chiave
+     * @return numero di chiavi in coda all'intervallo che non sono state trovate nel sottoalbero
+     */
+    std::size_t eraseSorted(bst<T, CMP> *node, const T *first, const T *last)
+    {
+        if (first == last || node == nullptr)
+        {
+            return last - first;
+        }
+        const T *equal{std::partition_point(first, last, [node](const T &value)
+                                            { return node->cmp(node->key, value); })}; // Chiavi minori della radice
+        const T *greater{std::partition_point(equal, last, [node](const T &value)
+                                              { return !node->cmp(value, node->key); })};
+        bool found{equal != greater}; // Una delle occorrenze è la radice stessa
+        std::size_t missing{eraseSorted(node->left, first, found ? greater - 1 : greater)};
+        missing = eraseSorted(node->right, greater - missing, last);
+        if (found)
+        {
+            bst<T, CMP>::deleteKey(node);
+        }
+        return missing;
+    }
+
+public:
+    using typename bst<T, CMP>::const_iterator;
+    using bst<T, CMP>::operator new;
+    using bst<T, CMP>::operator delete;
+
+    /**
+     * @brief Costruttore vuoto
+     *
+     * @param inputCapacity è la dimensione massima dei buffer
+     */
+    bufferedBst(std::size_t inputCapacity = 1024) : bst<T, CMP>(), sortedInserts{0}, capacity{inputCapacity}
+    {
+        pendingInserts.reserve(capacity);
+    }
+
+    /**
+     * @brief Inserisce un valore nel buffer
+     * Se il valore annulla una cancellazione in attesa, la cancellazione viene rimossa.
+     *
+     * @param value è il valore da inserire
+     * @return bufferedBst& è l'albero stesso, così anche gli inserimenti concatenati passano dal buffer
+     */
+    bufferedBst<T, CMP> &insertValue(const T &value)
+    {
+        auto pending{std::lower_bound(pendingDeletes.begin(), pendingDeletes.end(), value, ascending{})};
+        if (pending != pendingDeletes.end() && this->equivalent(*pending, value))
+        {
+            pendingDeletes.erase(pending);
+            return *this;
+        }
+        pendingInserts.push_back(value);
+        if (pendingInserts.size() >= capacity)
+        {
+            flush();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Elimina un'occorrenza di una chiave
+     * Se la chiave è in attesa di inserimento viene tolta dal buffer, altrimenti la cancellazione viene accodata.
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value chiave da eliminare
+     */
+    void deleteKey(const T &value)
+    {
+        sortInserts();
+        auto pending{std::lower_bound(pendingInserts.begin(), pendingInserts.end(), value, ascending{})};
+        if (pending != pendingInserts.end() && this->equivalent(*pending, value))
+        {
+            pendingInserts.erase(pending);
+            --sortedInserts;
+            return;
+        }
+        if (treeOccurrences(bst<T, CMP>::isEmpty() ? nullptr : this, value) <= occurrences(pendingDeletes, value))
+        {
+            throw NonExistingValueException(value);
+        }
+        pendingDeletes.insert(std::upper_bound(pendingDeletes.begin(), pendingDeletes.end(), value, ascending{}), value);
+        if (pendingDeletes.size() >= capacity)
+        {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Ricerca di una chiave tenendo conto delle operazioni in attesa
+     * Una chiave che si trova solo nel buffer degli inserimenti non ha ancora un nodo: in quel caso i buffer vengono
+     * applicati prima della ricerca. Una chiave le cui occorrenze nell'albero sono tutte in attesa di cancellazione non viene trovata.
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore costante a un nodo con la chiave cercata o nullptr se la chiave non è presente
+     */
+    const bst<T, CMP> *find(const T &value)
+    {
+        sortInserts();
+        if (std::binary_search(pendingInserts.begin(), pendingInserts.end(), value, ascending{}))
+        {
+            flush();
+            return bst<T, CMP>::find(value);
+        }
+        const bst<T, CMP> *node{bst<T, CMP>::find(value)};
+        std::size_t deleted{occurrences(pendingDeletes, value)};
+        return node == nullptr || deleted == 0 || treeOccurrences(this, value) > deleted ? node : nullptr;
+    }
+
+    /**
+     * @brief Ricerca di una chiave tenendo conto delle operazioni in attesa (vedi find())
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore costante a un nodo con la chiave cercata
+     */
+    const bst<T, CMP> *binarySearch(const T &value)
+    {
+        const bst<T, CMP> *node{find(value)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Metodo che informa se una chiave è presente tenendo conto delle operazioni in attesa
+     *
+     * @param value è la chiave da cercare
+     * @return true se la chiave è presente
+     * @return false se la chiave non è presente
+     */
+    bool isPresent(const T &value) const
+    {
+        sortInserts();
+        if (std::binary_search(pendingInserts.begin(), pendingInserts.end(), value, ascending{}))
+        {
+            return true;
+        }
+        if (bst<T, CMP>::find(value) == nullptr)
+        {
+            return false;
+        }
+        std::size_t deleted{occurrences(pendingDeletes, value)};
+        return deleted == 0 || treeOccurrences(this, value) > deleted;
+    }
+
+    /**
+     * @brief Applica all'albero tutte le operazioni in attesa
+     * Prima le cancellazioni (che riguardano solo chiavi già nell'albero) con una sola visita dei sottoalberi interessati,
+     * poi la fusione del lotto di inserimenti.
+     */
+    void flush()
+    {
+        if (!pendingDeletes.empty())
+        {
+            eraseSorted(this, pendingDeletes.data(), pendingDeletes.data() + pendingDeletes.size());
+            pendingDeletes.clear();
+        }
+        sortInserts();
+        this->insertSorted(pendingInserts.data(), pendingInserts.data() + pendingInserts.size());
+        pendingInserts.clear();
+        sortedInserts = 0;
+    }
+
+    /**
+     * @brief Restituisce il numero di operazioni in attesa
+     *
+     * @return numero di inserimenti e cancellazioni non ancora applicati
+     */
+    inline std::size_t pending() const
+    {
+        return pendingInserts.size() + pendingDeletes.size();
+    }
+
+    /**
+     * @brief Informa se l'albero è vuoto tenendo conto delle operazioni in attesa
+     *
+     * @return true se non ci sono inserimenti in attesa e le chiavi dell'albero sono assenti o tutte in attesa di cancellazione
+     * @return false altrimenti
+     */
+    bool isEmpty() const
+    {
+        if (!pendingInserts.empty())
+        {
+            return false;
+        }
+        if (bst<T, CMP>::isEmpty())
+        {
+            return true;
+        }
+        // Ogni cancellazione in attesa riguarda un nodo diverso: l'albero si svuota solo se i nodi non sono più delle cancellazioni
+        const bst<T, CMP> *node{this};
+        while (node->left != nullptr)
+        {
+            node = node->left;
+        }
+        std::size_t nodes{0};
+        for (; node != nullptr && nodes <= pendingDeletes.size(); node = bst<T, CMP>::nextNode(node))
+        {
+            ++nodes;
+        }
+        return nodes <= pendingDeletes.size();
+    }
+
+    /**
+     * @brief Contatore dei nodi che tiene conto delle operazioni in attesa
+     * Ogni cancellazione in attesa riguarda un nodo già presente nell'albero.
+     *
+     * @return numero di nodi dell'albero dopo l'applicazione dei buffer
+     */
+    u_int nodesCount() const
+    {
+        return bst<T, CMP>::nodesCount() + pendingInserts.size() - pendingDeletes.size();
+    }
+
+    /**
+     * @brief Contatore delle foglie dopo aver applicato le operazioni in attesa
+     *
+     * @return numero di foglie dell'albero
+     */
+    u_int leavesCount()
+    {
+        flush();
+        return bst<T, CMP>::leavesCount();
+    }
+
+    /**
+     * @brief Altezza dell'albero dopo aver applicato le operazioni in attesa
+     *
+     * @return altezza dell'albero
+     */
+    uint height()
+    {
+        flush();
+        return bst<T, CMP>::height();
+    }
+
+    /**
+     * @brief Visita simmetrica dopo aver applicato le operazioni in attesa
+     */
+    void inorder()
+    {
+        flush();
+        bst<T, CMP>::inorder();
+    }
+
+    /**
+     * @brief Visita anticipata dopo aver applicato le operazioni in attesa
+     */
+    void preorder()
+    {
+        flush();
+        bst<T, CMP>::preorder();
+    }
+
+    /**
+     * @brief Visita posticipata dopo aver applicato le operazioni in attesa
+     */
+    void postorder()
+    {
+        flush();
+        bst<T, CMP>::postorder();
+    }
+
+    /**
+     * @brief Eliminazione delle chiavi di un intervallo chiuso [a, b] dopo aver applicato le operazioni in attesa
+     *
+     * @param a è l'estremo sinistro dell'intervallo
+     * @param b è l'estremo destro dell'intervallo
+     * @return numero di nodi eliminati
+     */
+    u_int eraseRange(const T &a, const T &b)
+    {
+        flush();
+        return bst<T, CMP>::eraseRange(a, b);
+    }
+
+    /**
+     * @brief Eliminazione dei nodi compresi tra due iteratori dopo aver applicato le operazioni in attesa
+     *
+     * @param first è l'iteratore al primo nodo da eliminare
+     * @param last è l'iteratore al primo nodo da non eliminare
+     * @return numero di nodi eliminati
+     */
+    u_int erase(const_iterator first, const_iterator last)
+    {
+        flush();
+        return bst<T, CMP>::erase(first, last);
+    }
+
+    /**
+     * @brief Eliminazione dei nodi la cui chiave soddisfa un predicato dopo aver applicato le operazioni in attesa
+     *
+     * @tparam PRED è il tipo del predicato
+     * @param pred è il predicato che indica le chiavi da eliminare
+     * @return numero di nodi eliminati
+     */
+    template <typename PRED>
+    u_int eraseIf(PRED pred)
+    {
+        flush();
+        return bst<T, CMP>::eraseIf(pred);
+    }
+
+    /**
+     * @brief Ribilancia l'albero (vedi bst::rebalance()) dopo aver applicato le operazioni in attesa
+     */
+    void rebalance()
+    {
+        flush();
+        bst<T, CMP>::rebalance();
+    }
+
+    /**
+     * @brief Riorganizza in memoria i nodi (vedi bst::relayout()) dopo aver applicato le operazioni in attesa
+     *
+     * @param order è l'ordine da utilizzare
+     */
+    void relayout(layoutOrder order)
+    {
+        flush();
+        bst<T, CMP>::relayout(order);
+    }
+
+    /**
+     * @brief Restituisce il puntatore al nodo minimo dopo aver applicato le operazioni in attesa
+     *
+     * @return puntatore costante al nodo con valore minimo
+     */
+    const bst<T, CMP> *min()
+    {
+        flush();
+        return bst<T, CMP>::min();
+    }
+
+    /**
+     * @brief Restituisce il puntatore al nodo massimo dopo aver applicato le operazioni in attesa
+     *
+     * @return puntatore costante al nodo con valore massimo
+     */
+    const bst<T, CMP> *max()
+    {
+        flush();
+        return bst<T, CMP>::max();
+    }
+
+    /**
+     * @brief Iteratore al primo valore dopo aver applicato le operazioni in attesa
+     *
+     * @return const_iterator corrispondente al primo valore dell'albero
+     */
+    const_iterator begin()
+    {
+        flush();
+        return bst<T, CMP>::begin();
+    }
+
+    /**
+     * @brief Iteratore all'ultimo valore dopo aver applicato le operazioni in attesa
+     *
+     * @return const_iterator corrispondente all'ultimo valore dell'albero
+     */
+    const_iterator end()
+    {
+        flush();
+        return bst<T, CMP>::end();
+    }
+};
+
+#endif
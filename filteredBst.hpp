@@ -0,0 +1,332 @@
+#ifndef __filteredBst_hpp__
+#define __filteredBst_hpp__
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <math.h>
+
+#include "bst.hpp"
+
+/**
+ * @class filteredBst
+ *
+ * @brief Albero binario di ricerca preceduto da un filtro di Bloom per rispondere rapidamente alle ricerche senza esito.
+ * Il filtro è un Bloom filter a blocchi con contatori da 4 bit (quindi supporta le cancellazioni): ogni chiave
+ * sceglie un blocco da 64 byte (una linea di cache) e vi incrementa k contatori. Se uno dei contatori è nullo la chiave
+ * non è sicuramente presente e l'albero non viene visitato; altrimenti la ricerca prosegue nell'albero.
+ * Il filtro viene dimensionato in base al numero di chiavi previsto e alla probabilità di falso positivo desiderata,
+ * eventualmente limitato da un budget di memoria; se le chiavi superano quelle previste il filtro viene raddoppiato
+ * (finché il budget lo consente) e ricostruito dalle chiavi dell'albero.
+ *
+ * @tparam T è il tipo di dato delle chiavi associate ai nodi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ * @tparam HASH è la funzione hash del tipo T (chiavi equivalenti secondo CMP devono avere lo stesso hash)
+ */
+template <typename T, typename CMP = std::greater<T>, typename HASH = std::hash<T>>
+class filteredBst : public bst<T, CMP>
+{
+private:
+    /**
+     * @brief Blocco del filtro: 128 contatori da 4 bit in una linea di cache
+     */
+    struct alignas(64) block
+    {
+        uint64_t words[8];
+    };
+
+    static const uint countersPerBlock{128};
+    static const uint64_t saturated{15}; // Un contatore saturo non viene più decrementato
+
+    std::vector<block> blocks; // contatori del filtro
+    uint probes;               // numero k di contatori per chiave
+    std::size_t expectedKeys;  // numero di chiavi per cui è dimensionato il filtro
+    std::size_t keys;          // numero di chiavi inserite nel filtro
+    double falsePositiveRate;  // probabilità di falso positivo richiesta
+    std::size_t memoryBudget;  // memoria massima del filtro in byte (0 se illimitata)
+    HASH hasher;               // funzione hash
+
+    /**
+     * @brief Rimescola i bit dell'hash (finalizzatore di splitmix64): std::hash degli interi è spesso l'identità
+     *
+     * @param value è la chiave
+     * @return uint64_t è l'hash rimescolato
+     */
+    inline uint64_t mix(const T &value) const
+    {
+        uint64_t h{(uint64_t)hasher(value) + 0x9e3779b97f4a7c15ULL};
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+
+    /**
+     * @brief Rimescolamento successivo di un hash (moltiplicazione per la costante di Fibonacci e xorshift)
+     *
+     * @param h è l'hash da rimescolare
+     * @return uint64_t è il nuovo hash
+     */
+    static inline uint64_t remix(uint64_t h)
+    {
+        h *= 0x9e3779b97f4a7c15ULL;
+        return h ^ (h >> 29);
+    }
+
+    /**
+     * @brief Applica una funzione ai k contatori di una chiave
+     * Il blocco è scelto con i 32 bit alti dell'hash; le posizioni nel blocco sono gruppi di 7 bit di un secondo hash
+     * (9 per ogni rimescolamento).
+     *
+     * @tparam F è il tipo della funzione, che riceve la parola e lo scostamento del contatore e restituisce false per interrompere
+     * @param value è la chiave
+     * @param f è la funzione da applicare
+     * @return true se f non ha interrotto la scansione
+     */
+    template <typename F>
+    bool forEachCounter(const T &value, F f) const
+    {
+        uint64_t h{mix(value)};
+        block &b{const_cast<block &>(blocks[((h >> 32) * blocks.size()) >> 32])};
+        uint64_t bits{h};
+        for (uint i{0}; i < probes; ++i)
+        {
+            if (i % 9 == 0)
+            {
+                bits = remix(bits);
+            }
+            uint index{(uint)(bits >> (7 * (i % 9))) & (countersPerBlock - 1)};
+            if (!f(b.words[index / 16], (index % 16) * 4))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Probabilità di falso positivo di un filtro a blocchi
+     * Il numero di chiavi in un blocco segue una distribuzione di Poisson di media n / b; un blocco con j chiavi
+     * ha probabilità di falso positivo (1 - (1 - 1/128)^(k·j))^k.
+     *
+     * @param blockCount è il numero b di blocchi
+     * @param keyCount è il numero n di chiavi
+     * @param k è il numero di contatori per chiave
+     * @return double è la probabilità di falso positivo
+     */
+    static double blockedRate(std::size_t blockCount, std::size_t keyCount, uint k)
+    {
+        double mean{(double)keyCount / blockCount};
+        double term{exp(-mean)}; // Probabilità di Poisson di j chiavi nel blocco
+        double rate{0};
+        for (uint j{0}; j <= mean + 10 * sqrt(mean) + 10; ++j)
+        {
+            rate += term * pow(1 - pow(1 - 1.0 / countersPerBlock, (double)k * j), k);
+            term *= mean / (j + 1);
+        }
+        return rate;
+    }
+
+    /**
+     * @brief Dimensiona il filtro per le chiavi previste, rispettando il budget di memoria
+     * Si parte dalla dimensione di un Bloom filter classico, m = -n ln(p) / ln²(2) contatori, e la si aumenta finché
+     * il filtro a blocchi (un po' meno preciso a parità di memoria) raggiunge la probabilità richiesta.
+     * Il numero di contatori per chiave è k = (m / n) ln(2).
+     */
+    void resize()
+    {
+        std::size_t n{expectedKeys == 0 ? 1 : expectedKeys};
+        double counters{-(double)n * log(falsePositiveRate) / (log(2.0) * log(2.0))};
+        std::size_t count{(std::size_t)ceil(counters / countersPerBlock)};
+        count = count == 0 ? 1 : count;
+        auto choose{[&]()
+                    {
+                        probes = (uint)round((double)count * countersPerBlock / n * log(2.0));
+                        probes = probes < 1 ? 1 : (probes > 16 ? 16 : probes);
+                    }};
+        for (choose(); blockedRate(count, n, probes) > falsePositiveRate; choose())
+        {
+            count += count / 16 + 1;
+        }
+        if (memoryBudget != 0 && count * sizeof(block) > memoryBudget)
+        {
+            count = memoryBudget / sizeof(block);
+            count = count == 0 ? 1 : count;
+            choose();
+        }
+        blocks.assign(count, block{});
+    }
+
+    /**
+     * @brief Inserisce una chiave nel filtro
+     *
+     * @param value è la chiave da inserire
+     */
+    void add(const T &value)
+    {
+        forEachCounter(value, [](uint64_t &word, uint shift)
+                       {
+                           if (((word >> shift) & saturated) != saturated)
+                           {
+                               word += uint64_t{1} << shift;
+                           }
+                           return true;
+                       });
+        ++keys;
+    }
+
+    /**
+     * @brief Toglie una chiave dal filtro
+     *
+     * @param value è la chiave da togliere
+     */
+    void subtract(const T &value)
+    {
+        forEachCounter(value, [](uint64_t &word, uint shift)
+                       {
+                           uint64_t counter{(word >> shift) & saturated};
+                           if (counter != saturated && counter != 0)
+                           {
+                               word -= uint64_t{1} << shift;
+                           }
+                           return true;
+                       });
+        --keys;
+    }
+
+public:
+    /**
+     * @brief Costruttore vuoto
+     *
+     * @param inputExpectedKeys è il numero di chiavi previsto
+     * @param inputFalsePositiveRate è la probabilità di falso positivo desiderata
+     * @param inputMemoryBudget è la memoria massima del filtro in byte (0 se illimitata)
+     */
+    filteredBst(std::size_t inputExpectedKeys = 1024, double inputFalsePositiveRate = 0.01, std::size_t inputMemoryBudget = 0)
+        : bst<T, CMP>(), expectedKeys{inputExpectedKeys}, keys{0}, falsePositiveRate{inputFalsePositiveRate}, memoryBudget{inputMemoryBudget}
+    {
+        resize();
+    }
+
+    /**
+     * @brief Inserisce un valore nell'albero e nel filtro
+     * Se le chiavi superano quelle previste il filtro viene raddoppiato, se il budget di memoria lo consente.
+     *
+     * @param value è il valore da inserire
+     * @return puntatore alla radice dell'albero
+     */
+    bst<T, CMP> *insertValue(const T &value)
+    {
+        this->insertNode(value);
+        add(value);
+        if (keys > expectedKeys && (memoryBudget == 0 || 2 * blocks.size() * sizeof(block) <= memoryBudget))
+        {
+            expectedKeys *= 2;
+            refilter();
+        }
+        return this;
+    }
+
+    /**
+     * @brief Elimina il nodo associato a una chiave e la toglie dal filtro
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value chiave corrispondente al nodo da eliminare
+     */
+    void deleteKey(const T &value)
+    {
+        bst<T, CMP>::deleteKey(value);
+        subtract(value);
+    }
+
+    /**
+     * @brief Consulta solo il filtro
+     *
+     * @param value è la chiave da cercare
+     * @return true se la chiave potrebbe essere presente
+     * @return false se la chiave non è sicuramente presente
+     */
+    inline bool mayContain(const T &value) const
+    {
+        return forEachCounter(value, [](uint64_t &word, uint shift)
+                              { return ((word >> shift) & saturated) != 0; });
+    }
+
+    /**
+     * @brief Ricerca di una chiave che visita l'albero solo se il filtro non la esclude
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore al nodo trovato o nullptr se la chiave non è presente
+     */
+    bst<T, CMP> *find(const T &value) const
+    {
+        return mayContain(value) ? bst<T, CMP>::find(value) : nullptr;
+    }
+
+    /**
+     * @brief Metodo che informa se una chiave è presente (senza lanciare eccezioni)
+     *
+     * @param value è la chiave da cercare
+     * @return true se la chiave è presente
+     * @return false se la chiave non è presente
+     */
+    inline bool isPresent(const T &value) const
+    {
+        return find(value) != nullptr;
+    }
+
+    /**
+     * @brief Ricerca di una chiave
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore al nodo trovato
+     */
+    bst<T, CMP> *const binarySearch(const T &value) const
+    {
+        bst<T, CMP> *node{find(value)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Ricostruisce il filtro dalle chiavi dell'albero
+     * Da usare dopo le operazioni che tolgono chiavi senza aggiornare il filtro (eraseRange, split, ...), che lasciano solo falsi positivi.
+     */
+    void refilter()
+    {
+        resize();
+        keys = 0;
+        if (!this->isEmpty())
+        {
+            for (bst<T, CMP> *node{this->min()}; node != nullptr; node = bst<T, CMP>::nextNode(node))
+            {
+                add(node->key);
+            }
+        }
+    }
+
+    /**
+     * @brief Restituisce la memoria occupata dal filtro
+     *
+     * @return std::size_t è il numero di byte del filtro
+     */
+    inline std::size_t filterBytes() const
+    {
+        return blocks.size() * sizeof(block);
+    }
+
+    /**
+     * @brief Stima la probabilità di falso positivo con le chiavi attuali
+     *
+     * @return double è la probabilità stimata
+     */
+    inline double estimatedFalsePositiveRate() const
+    {
+        return blockedRate(blocks.size(), keys, probes);
+    }
+};
+
+#endif
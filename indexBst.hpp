@@ -0,0 +1,583 @@
+#ifndef __indexBst_hpp__
+#define __indexBst_hpp__
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+
+#include "bstException.hpp"
+
+/**
+ * @brief Nodo di indexBst con indice del genitore
+ *
+ * @tparam T è il tipo della chiave
+ * @tparam PARENT indica se il nodo memorizza l'indice del genitore
+ */
+template <typename T, bool PARENT>
+struct indexNode
+{
+    T key;           // valore del nodo
+    uint32_t left;   // indice del figlio sinistro
+    uint32_t right;  // indice del figlio destro
+    uint32_t parent; // indice del genitore
+};
+
+/**
+ * @brief Nodo di indexBst senza indice del genitore
+ *
+ * @tparam T è il tipo della chiave
+ */
+template <typename T>
+struct indexNode<T, false>
+{
+    T key;          // valore del nodo
+    uint32_t left;  // indice del figlio sinistro
+    uint32_t right; // indice del figlio destro
+};
+
+/**
+ * @class indexBst
+ *
+ * @brief Albero binario di ricerca con i nodi in un'arena e archi a 32 bit.
+ * Tutti i nodi sono memorizzati in un unico vettore e gli archi sono indici a 32 bit invece di puntatori a 64 bit;
+ * il comparatore e lo stato di nodo vuoto sono memorizzati una sola volta nell'albero invece che in ogni nodo.
+ * Per un bst<int> un nodo passa da 40 a 16 byte (12 byte senza indice del genitore).
+ *
+ * Senza indice del genitore (PARENT = false) gli iteratori mantengono la pila degli antenati del nodo corrente.
+ * find() e isPresent() scendono senza costruire la pila: l'iteratore restituito da find() la ricostruisce (O(h)) solo
+ * al primo spostamento.
+ *
+ * @tparam T è il tipo di dato delle chiavi associate ai nodi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ * @tparam PARENT indica se i nodi memorizzano l'indice del genitore
+ */
+template <typename T, typename CMP = std::greater<T>, bool PARENT = true>
+class indexBst
+{
+private:
+    using node = indexNode<T, PARENT>;
+
+    static const uint32_t nil{UINT32_MAX}; // indice che rappresenta l'assenza di un nodo
+
+    std::vector<node> nodes; // arena dei nodi
+    uint32_t root;           // indice della radice
+    uint32_t freeList;       // primo nodo libero (i nodi liberi sono collegati tramite left)
+    u_int size;              // numero di nodi dell'albero
+    CMP cmp;                 // comparatore
+
+    /**
+     * @brief Restituisce un nodo libero dell'arena con la chiave fornita
+     *
+     * @param value è il valore del nodo
+     * @return uint32_t è l'indice del nodo
+     */
+    uint32_t newNode(const T &value)
+    {
+        uint32_t idx;
+        if (freeList != nil)
+        {
+            idx = freeList;
+            freeList = nodes[idx].left;
+        }
+        else
+        {
+            idx = nodes.size();
+            nodes.emplace_back();
+        }
+        nodes[idx].key = value;
+        nodes[idx].left = nil;
+        nodes[idx].right = nil;
+        return idx;
+    }
+
+    /**
+     * @brief Imposta il genitore di un nodo (solo se i nodi memorizzano il genitore)
+     *
+     * @param idx è l'indice del nodo (può essere nil)
+     * @param parentIdx è l'indice del genitore
+     */
+    inline void setParent(uint32_t idx, uint32_t parentIdx)
+    {
+        if constexpr (PARENT)
+        {
+            if (idx != nil)
+            {
+                nodes[idx].parent = parentIdx;
+            }
+        }
+    }
+
+    /**
+     * @brief Discesa dalla radice fino al primo nodo con la chiave cercata
+     *
+     * @param value è la chiave da cercare
+     * @return indice del nodo trovato o nil se la chiave non è presente
+     */
+    uint32_t locate(const T &value) const
+    {
+        uint32_t current{root};
+        while (current != nil)
+        {
+            const node &n{nodes[current]};
+            if (cmp(value, n.key))
+            {
+                current = n.right;
+            }
+            else if (cmp(n.key, value))
+            {
+                current = n.left;
+            }
+            else
+            {
+                return current;
+            }
+        }
+        return nil;
+    }
+
+public:
+    /**
+     * @brief Iteratore costante per indexBst
+     *
+     * Come per bst, l'iteratore fornisce direttamente il metodo getKey() e può essere usato come riferimento al nodo.
+     */
+    class const_iterator
+    {
+    private:
+        const indexBst<T, CMP, PARENT> *tree; // albero su cui si itera
+        uint32_t current;                     // indice del nodo corrente (nil dopo l'ultimo)
+        std::vector<uint32_t> path;           // antenati del nodo corrente (solo senza indice del genitore)
+        bool pathKnown;                       // false se path non è ancora stato costruito (iteratori di find())
+
+        const_iterator(const indexBst<T, CMP, PARENT> *inputTree, uint32_t idx) : tree{inputTree}, current{idx}, pathKnown{true} {}
+
+        /**
+         * @brief Costruisce la pila degli antenati del nodo corrente ripetendo la discesa di find() dalla radice
+         */
+        void buildPath()
+        {
+            path.clear();
+            for (uint32_t idx{tree->root}; idx != current;)
+            {
+                path.push_back(idx);
+                idx = tree->cmp(tree->nodes[current].key, tree->nodes[idx].key) ? tree->nodes[idx].right : tree->nodes[idx].left;
+            }
+            pathKnown = true;
+        }
+
+        /**
+         * @brief Scende lungo il ramo indicato a partire dal nodo corrente
+         *
+         * @param toLeft indica se scendere a sinistra (minimo) o a destra (massimo)
+         */
+        void descend(bool toLeft)
+        {
+            while (true)
+            {
+                uint32_t child{toLeft ? tree->nodes[current].left : tree->nodes[current].right};
+                if (child == nil)
+                {
+                    return;
+                }
+                if constexpr (!PARENT)
+                {
+                    path.push_back(current);
+                }
+                current = child;
+            }
+        }
+
+        /**
+         * @brief Sposta l'iteratore sul nodo successivo (forward = true) o precedente
+         *
+         * @param forward indica la direzione dello spostamento
+         */
+        void step(bool forward)
+        {
+            if constexpr (!PARENT)
+            {
+                if (!pathKnown)
+                {
+                    buildPath();
+                }
+            }
+            uint32_t child{forward ? tree->nodes[current].right : tree->nodes[current].left};
+            if (child != nil) // Si scende nel sottoalbero e poi all'estremo opposto
+            {
+                if constexpr (!PARENT)
+                {
+                    path.push_back(current);
+                }
+                current = child;
+                descend(forward);
+                return;
+            }
+            while (true) // Si risale finché si arriva da un figlio del lato opposto
+            {
+                uint32_t up;
+                if constexpr (PARENT)
+                {
+                    up = tree->nodes[current].parent;
+                }
+                else
+                {
+                    up = path.empty() ? nil : path.back();
+                    if (!path.empty())
+                    {
+                        path.pop_back();
+                    }
+                }
+                if (up == nil)
+                {
+                    current = nil;
+                    return;
+                }
+                bool fromOpposite{forward ? tree->nodes[up].left == current : tree->nodes[up].right == current};
+                current = up;
+                if (fromOpposite)
+                {
+                    return;
+                }
+            }
+        }
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag; // categoria di iteratore
+        using difference_type = std::ptrdiff_t;                    // il tipo della differenza tra iteratori
+        using value_type = const_iterator;                         // il valore trattato dall'iteratore
+        using pointer = const value_type *;                        // il tipo puntatore
+        using reference = const value_type &;                      // il tipo riferimento
+
+        /**
+         * @brief Costruttore vuoto pubblico
+         */
+        const_iterator() : tree{nullptr}, current{nil}, pathKnown{true} {}
+
+        /**
+         * @brief Restituisce la chiave del nodo corrente
+         *
+         * @return const T& è il valore della chiave
+         */
+        inline const T &getKey() const
+        {
+            return tree->nodes[current].key;
+        }
+
+        const_iterator &operator++()
+        {
+            step(true);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator previous{*this};
+            step(true);
+            return previous;
+        }
+
+        const_iterator &operator--()
+        {
+            step(false);
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator previous{*this};
+            step(false);
+            return previous;
+        }
+
+        inline reference operator*() const
+        {
+            return *this;
+        }
+
+        inline pointer operator->() const
+        {
+            return this;
+        }
+
+        inline bool operator==(const const_iterator &it) const
+        {
+            return current == it.current;
+        }
+
+        inline bool operator!=(const const_iterator &it) const
+        {
+            return current != it.current;
+        }
+
+        friend class indexBst<T, CMP, PARENT>;
+    };
+
+    /**
+     * @brief Costruttore vuoto
+     */
+    indexBst() : root{nil}, freeList{nil}, size{0} {}
+
+    /**
+     * @brief Costruttore per convertire un array in un albero binario di ricerca
+     *
+     * @param array che si vuole convertire nell'albero binario di ricerca
+     * @param length è la lunghezza dell'array
+     */
+    indexBst(const T array[], uint length) : indexBst()
+    {
+        nodes.reserve(length);
+        for (u_int i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    /**
+     * @brief Restituisce true se l'albero è vuoto
+     *
+     * @return true se l'albero non ha nodi
+     * @return false se l'albero ha almeno un nodo
+     */
+    inline bool isEmpty() const
+    {
+        return root == nil;
+    }
+
+    /**
+     * @brief Contatore dei nodi dell'albero
+     *
+     * @return naturale che esprime il numero di nodi dell'albero
+     */
+    inline u_int nodesCount() const
+    {
+        return size;
+    }
+
+    /**
+     * @brief Memoria occupata dall'arena dei nodi
+     *
+     * @return numero di byte riservati per i nodi
+     */
+    inline std::size_t memoryUsage() const
+    {
+        return nodes.capacity() * sizeof(node);
+    }
+
+    /**
+     * @brief Inserisce un valore nell'albero
+     * Come in bst, i valori maggiori vanno a destra e quelli minori o uguali a sinistra
+     *
+     * @param value è il valore da inserire
+     */
+    void insertValue(const T &value)
+    {
+        uint32_t idx{newNode(value)}; // Allocato prima della discesa: l'arena può essere riallocata
+        if (root == nil)
+        {
+            root = idx;
+            setParent(idx, nil);
+            ++size;
+            return;
+        }
+        uint32_t current{root};
+        while (true)
+        {
+            uint32_t &child{cmp(value, nodes[current].key) ? nodes[current].right : nodes[current].left};
+            if (child == nil)
+            {
+                child = idx;
+                setParent(idx, current);
+                ++size;
+                return;
+            }
+            current = child;
+        }
+    }
+
+    /**
+     * @brief Ricerca di un valore nell'albero senza eccezioni
+     *
+     * @param value è la chiave da cercare
+     * @return const_iterator al nodo trovato o end() se non è presente
+     */
+    const_iterator find(const T &value) const
+    {
+        const_iterator it{this, locate(value)};
+        it.pathKnown = it.current == nil || it.current == root; // Altrimenti la pila viene costruita al primo spostamento
+        return it;
+    }
+
+    /**
+     * @brief Ricerca di un valore nell'albero
+     * Se la chiave non è presente nell'albero viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da cercare
+     * @return const_iterator al nodo che presenta la chiave desiderata
+     */
+    const_iterator binarySearch(const T &value) const
+    {
+        const_iterator it{find(value)};
+        if (it.current == nil)
+        {
+            throw NonExistingValueException(value);
+        }
+        return it;
+    }
+
+    /**
+     * @brief Metodo che informa se è presente nell'albero un nodo con un determinato valore della chiave
+     *
+     * @return true se il nodo è presente nell'albero
+     * @return false se il nodo non è presente nell'albero
+     */
+    inline bool isPresent(const T &value) const
+    {
+        return locate(value) != nil;
+    }
+
+    /**
+     * @brief Eliminazione del nodo associato a una determinata chiave
+     * La discesa mantiene il riferimento all'arco entrante, quindi non serve l'indice del genitore.
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value chiave corrispondente al nodo da eliminare
+     */
+    void deleteKey(const T &value)
+    {
+        uint32_t *link{&root};
+        uint32_t parentIdx{nil};
+        while (*link != nil)
+        {
+            node &n{nodes[*link]};
+            if (cmp(value, n.key))
+            {
+                parentIdx = *link;
+                link = &n.right;
+            }
+            else if (cmp(n.key, value))
+            {
+                parentIdx = *link;
+                link = &n.left;
+            }
+            else
+            {
+                break;
+            }
+        }
+        if (*link == nil)
+        {
+            throw NonExistingValueException(value);
+        }
+        uint32_t target{*link};
+        if (nodes[target].left == nil || nodes[target].right == nil) // Il figlio unico (o nessuno) prende il suo posto
+        {
+            uint32_t child{nodes[target].left == nil ? nodes[target].right : nodes[target].left};
+            *link = child;
+            setParent(child, parentIdx);
+        }
+        else // Il successore prende il posto del nodo eliminato
+        {
+            uint32_t successorParent{target};
+            uint32_t *successorLink{&nodes[target].right};
+            while (nodes[*successorLink].left != nil)
+            {
+                successorParent = *successorLink;
+                successorLink = &nodes[*successorLink].left;
+            }
+            uint32_t successor{*successorLink};
+            *successorLink = nodes[successor].right; // Il figlio destro sostituisce il successore
+            setParent(nodes[successor].right, successorParent);
+            nodes[successor].left = nodes[target].left;
+            nodes[successor].right = nodes[target].right;
+            setParent(nodes[successor].left, successor);
+            setParent(nodes[successor].right, successor);
+            *link = successor;
+            setParent(successor, parentIdx);
+        }
+        nodes[target].left = freeList; // Il nodo torna nella lista libera
+        freeList = target;
+        --size;
+    }
+
+    /**
+     * @brief Restituisce l'iteratore al nodo con l'elemento più piccolo dell'albero
+     *
+     * @return const_iterator al minimo (end() se l'albero è vuoto)
+     */
+    const_iterator min() const
+    {
+        const_iterator it{this, root};
+        if (root != nil)
+        {
+            it.descend(true);
+        }
+        return it;
+    }
+
+    /**
+     * @brief Restituisce l'iteratore al nodo con l'elemento più grande dell'albero
+     *
+     * @return const_iterator al massimo (end() se l'albero è vuoto)
+     */
+    const_iterator max() const
+    {
+        const_iterator it{this, root};
+        if (root != nil)
+        {
+            it.descend(false);
+        }
+        return it;
+    }
+
+    /**
+     * @brief Metodo per ottenere l'altezza dell'albero
+     *
+     * @return naturale che rappresenta il numero di livelli dell'albero
+     */
+    uint height() const
+    {
+        uint h{0};
+        std::vector<std::pair<uint32_t, uint>> stack;
+        if (root != nil)
+        {
+            stack.push_back({root, 1});
+        }
+        while (!stack.empty())
+        {
+            std::pair<uint32_t, uint> current{stack.back()};
+            stack.pop_back();
+            h = current.second > h ? current.second : h;
+            if (nodes[current.first].left != nil)
+            {
+                stack.push_back({nodes[current.first].left, current.second + 1});
+            }
+            if (nodes[current.first].right != nil)
+            {
+                stack.push_back({nodes[current.first].right, current.second + 1});
+            }
+        }
+        return h;
+    }
+
+    /**
+     * @brief Iteratore al primo valore dell'albero
+     *
+     * @return const_iterator al minimo
+     */
+    inline const_iterator begin() const
+    {
+        return min();
+    }
+
+    /**
+     * @brief Iteratore successivo all'ultimo valore dell'albero
+     *
+     * @return const_iterator che indica la fine della visita
+     */
+    inline const_iterator end() const
+    {
+        return const_iterator{this, nil};
+    }
+};
+
+#endif
@@ -0,0 +1,548 @@
+#ifndef __indexedBst_hpp__
+#define __indexedBst_hpp__
+
+#include <functional>
+#include <vector>
+
+#include "bst.hpp"
+
+/**
+ * @class indexedBst
+ *
+ * @brief Albero binario di ricerca affiancato da un indice hash per le ricerche esatte.
+ * L'indice è una tabella a indirizzamento aperto (scansione lineare, cancellazione con spostamento all'indietro) che associa
+ * ogni chiave a un nodo dell'albero. find(), contains() e binarySearch() costano O(1) atteso, mentre le operazioni
+ * che dipendono dall'ordine (iteratori, min(), max(), successor(), ...) continuano a usare l'albero.
+ * L'indice viene mantenuto da insertValue(), deleteKey() e remove(); eraseRange(), eraseIf(), rebalance() e relayout()
+ * lo ricostruiscono. L'ereditarietà da bst è privata: le altre operazioni di bst che spostano chiavi tra i nodi o nodi tra
+ * alberi (split, join, swap, insertBatch, inserimento con hint, ...) lascerebbero nell'indice puntatori non validi, e per
+ * lo stesso motivo i nodi restituiti sono costanti e insertValue() restituisce l'albero stesso.
+ * Per le chiavi duplicate l'indice punta a una sola delle occorrenze.
+ *
+ * @tparam T è il tipo di dato delle chiavi associate ai nodi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ * @tparam HASH è la funzione hash del tipo T (chiavi equivalenti secondo CMP devono avere lo stesso hash)
+ */
+template <typename T, typename CMP = std::greater<T>, typename HASH = std::hash<T>>
+class indexedBst : private bst<T, CMP>
+{
+private:
+    /**
+     * @brief Posizione della tabella: nodo indicizzato (nullptr se libera) e hash della sua chiave
+     */
+    struct slot
+    {
+        bst<T, CMP> *node;
+        std::size_t hash;
+    };
+
+    std::vector<slot> table; // tabella con dimensione potenza di 2
+    std::size_t used;        // numero di posizioni occupate
+    HASH hasher;             // funzione hash
+
+    /**
+     * @brief Hash di una chiave rimescolato con il finalizzatore di splitmix64
+     * std::hash degli interi è l'identità: senza rimescolare, chiavi con gli stessi bit bassi (per esempio multipli di 4096)
+     * finirebbero tutte nello stesso gruppo della tabella.
+     *
+     * @param value è la chiave
+     * @return std::size_t è l'hash rimescolato
+     */
+    inline std::size_t mix(const T &value) const
+    {
+        uint64_t h{(uint64_t)hasher(value) + 0x9e3779b97f4a7c15ULL};
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+
+    /**
+     * @brief Posizione ideale di un hash nella tabella
+     *
+     * @param hash è l'hash rimescolato della chiave (vedi mix())
+     * @return std::size_t è la prima posizione da esaminare
+     */
+    inline std::size_t home(std::size_t hash) const
+    {
+        return hash & (table.size() - 1);
+    }
+
+    /**
+     * @brief Cerca la posizione della chiave value
+     *
+     * @param value è la chiave da cercare
+     * @param hash è l'hash di value
+     * @return std::size_t è la posizione della chiave o della prima posizione libera incontrata
+     */
+    std::size_t probe(const T &value, std::size_t hash) const
+    {
+        std::size_t i{home(hash)};
+        while (table[i].node != nullptr && (table[i].hash != hash || !this->equivalent(table[i].node->key, value)))
+        {
+            i = (i + 1) & (table.size() - 1);
+        }
+        return i;
+    }
+
+    /**
+     * @brief Cerca la posizione che punta a un determinato nodo
+     * Serve quando la chiave del nodo è già stata spostata o il nodo è già stato liberato.
+     *
+     * @param node è il nodo indicizzato
+     * @param hash è l'hash della chiave con cui il nodo è stato indicizzato
+     * @return std::size_t è la posizione del nodo o della prima posizione libera incontrata
+     */
+    std::size_t probeNode(const bst<T, CMP> *node, std::size_t hash) const
+    {
+        std::size_t i{home(hash)};
+        while (table[i].node != nullptr && table[i].node != node)
+        {
+            i = (i + 1) & (table.size() - 1);
+        }
+        return i;
+    }
+
+    /**
+     * @brief Libera una posizione spostando all'indietro gli elementi successivi dello stesso gruppo
+     *
+     * @param i è la posizione da liberare
+     */
+    void eraseSlot(std::size_t i)
+    {
+        const std::size_t mask{table.size() - 1};
+        std::size_t j{i};
+        while (true)
+        {
+            j = (j + 1) & mask;
+            if (table[j].node == nullptr)
+            {
+                break;
+            }
+            std::size_t ideal{home(table[j].hash)};
+            if (((j - ideal) & mask) >= ((j - i) & mask)) // L'elemento in j può occupare il buco in i
+            {
+                table[i] = table[j];
+                i = j;
+            }
+        }
+        table[i].node = nullptr;
+        --used;
+    }
+
+    /**
+     * @brief Indicizza un nodo se la sua chiave non è ancora presente nell'indice
+     *
+     * @param node è il nodo da indicizzare
+     */
+    void indexNode(bst<T, CMP> *node)
+    {
+        if (2 * (used + 1) > table.size()) // Fattore di carico massimo 1/2
+        {
+            grow();
+        }
+        std::size_t hash{mix(node->key)};
+        std::size_t i{probe(node->key, hash)};
+        if (table[i].node == nullptr)
+        {
+            table[i] = {node, hash};
+            ++used;
+        }
+    }
+
+    /**
+     * @brief Raddoppia la dimensione della tabella
+     */
+    void grow()
+    {
+        std::vector<slot> old(table.size() < 16 ? 16 : 2 * table.size(), slot{nullptr, 0});
+        old.swap(table);
+        for (const slot &entry : old)
+        {
+            if (entry.node != nullptr)
+            {
+                std::size_t i{home(entry.hash)};
+                while (table[i].node != nullptr)
+                {
+                    i = (i + 1) & (table.size() - 1);
+                }
+                table[i] = entry;
+            }
+        }
+    }
+
+    /**
+     * @brief Dopo la rimozione di un nodo indicizzato con la chiave value, fa puntare l'indice a un'altra occorrenza (se esiste)
+     *
+     * @param value è la chiave rimossa
+     * @param hash è l'hash di value
+     * @param node è il nodo rimosso (o la radice, se la chiave le è stata tolta)
+     */
+    void unindex(const T &value, std::size_t hash, const bst<T, CMP> *node)
+    {
+        std::size_t i{probeNode(node, hash)};
+        if (table[i].node == node)
+        {
+            bst<T, CMP> *other{this->isEmpty() ? nullptr : bst<T, CMP>::find(value)};
+            if (other != nullptr)
+            {
+                table[i].node = other;
+            }
+            else
+            {
+                eraseSlot(i);
+            }
+        }
+    }
+
+public:
+    using typename bst<T, CMP>::const_iterator;
+    using bst<T, CMP>::operator new;
+    using bst<T, CMP>::operator delete;
+    using bst<T, CMP>::getKey;
+    using bst<T, CMP>::getCount;
+    using bst<T, CMP>::isEmpty;
+    using bst<T, CMP>::findFrom;
+    using bst<T, CMP>::nodesCount;
+    using bst<T, CMP>::leavesCount;
+    using bst<T, CMP>::height;
+    using bst<T, CMP>::inorder;
+    using bst<T, CMP>::preorder;
+    using bst<T, CMP>::postorder;
+    using bst<T, CMP>::begin;
+    using bst<T, CMP>::end;
+    using bst<T, CMP>::cend;
+
+    /**
+     * @brief Costruttore vuoto
+     */
+    indexedBst() : bst<T, CMP>(), used{0} {}
+
+    /**
+     * @brief Costruttore per convertire un array in un albero
+     *
+     * @param array che si vuole convertire nell'albero binario di ricerca
+     * @param length è la lunghezza dell'array
+     */
+    indexedBst(const T array[], uint length) : indexedBst()
+    {
+        for (uint i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    /**
+     * @brief Costruttore di copia
+     * L'indice viene ricostruito sui nodi della copia
+     *
+     * @param orig è l'albero da copiare
+     */
+    indexedBst(const indexedBst<T, CMP, HASH> &orig) : bst<T, CMP>(orig), used{0}, hasher{orig.hasher}
+    {
+        reindex();
+    }
+
+    /**
+     * @brief Operatore di assegnamento
+     *
+     * @param other è l'albero da assegnare
+     * @return indexedBst<T, CMP, HASH>& è il riferimento all'albero assegnato
+     */
+    indexedBst<T, CMP, HASH> &operator=(const indexedBst<T, CMP, HASH> &other)
+    {
+        bst<T, CMP>::operator=(other);
+        hasher = other.hasher;
+        reindex();
+        return *this;
+    }
+
+    /**
+     * @brief Restituisce il sottoalbero sinistro
+     *
+     * @return puntatore costante al nodo figlio sinistro
+     */
+    inline const bst<T, CMP> *getLeft() const
+    {
+        return bst<T, CMP>::getLeft();
+    }
+
+    /**
+     * @brief Restituisce il sottoalbero destro
+     *
+     * @return puntatore costante al nodo figlio destro
+     */
+    inline const bst<T, CMP> *getRight() const
+    {
+        return bst<T, CMP>::getRight();
+    }
+
+    /**
+     * @brief Restituisce il nodo con la chiave più piccola
+     *
+     * @return puntatore costante al nodo con valore minimo
+     */
+    inline const bst<T, CMP> *min()
+    {
+        return bst<T, CMP>::min();
+    }
+
+    /**
+     * @brief Restituisce il nodo con la chiave più grande
+     *
+     * @return puntatore costante al nodo con valore massimo
+     */
+    inline const bst<T, CMP> *max()
+    {
+        return bst<T, CMP>::max();
+    }
+
+    /**
+     * @brief Inserisce un valore nell'albero e nell'indice
+     *
+     * @param value è il valore da inserire
+     * @return indexedBst& è l'albero stesso
+     */
+    indexedBst<T, CMP, HASH> &insertValue(const T &value)
+    {
+        indexNode(this->insertNode(value));
+        return *this;
+    }
+
+    /**
+     * @brief Ricerca di una chiave tramite l'indice in tempo O(1) atteso
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore costante al nodo trovato o nullptr se la chiave non è presente
+     */
+    const bst<T, CMP> *find(const T &value) const
+    {
+        if (used == 0)
+        {
+            return nullptr;
+        }
+        return table[probe(value, mix(value))].node;
+    }
+
+    /**
+     * @brief Metodo che informa se una chiave è presente
+     *
+     * @param value è la chiave da cercare
+     * @return true se la chiave è presente
+     * @return false se la chiave non è presente
+     */
+    inline bool contains(const T &value) const
+    {
+        return find(value) != nullptr;
+    }
+
+    /**
+     * @brief Metodo che informa se una chiave è presente (come contains())
+     *
+     * @param value è la chiave da cercare
+     * @return true se la chiave è presente
+     * @return false se la chiave non è presente
+     */
+    inline bool isPresent(const T &value) const
+    {
+        return contains(value);
+    }
+
+    /**
+     * @brief Ricerca di una chiave tramite l'indice
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore costante al nodo trovato
+     */
+    const bst<T, CMP> *binarySearch(const T &value) const
+    {
+        const bst<T, CMP> *node{find(value)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Elimina un nodo associato a una chiave aggiornando l'indice
+     * Se si elimina la radice l'oggetto radice riceve la chiave di un altro nodo, che viene reindicizzata.
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value chiave corrispondente al nodo da eliminare
+     */
+    void deleteKey(const T &value)
+    {
+        bst<T, CMP> *node{used == 0 ? nullptr : table[probe(value, mix(value))].node};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        bst<T, CMP> *moved{nullptr}; // Nodo la cui chiave viene spostata nella radice
+        if (node == this)
+        {
+            if (this->left == nullptr || this->right == nullptr)
+            {
+                moved = this->left != nullptr ? this->left : this->right;
+            }
+            else
+            {
+                moved = this->right->min();
+            }
+        }
+        std::size_t hash{mix(value)};
+        bst<T, CMP>::deleteKey(node);
+        unindex(value, hash, node);
+        if (moved != nullptr)
+        {
+            std::size_t i{probeNode(moved, mix(this->key))};
+            if (table[i].node == moved)
+            {
+                table[i].node = this;
+            }
+        }
+    }
+
+    /**
+     * @brief Elimina il sottoalbero con radice node aggiornando l'indice
+     * Se node è la radice l'albero diventa vuoto.
+     *
+     * @param node è la radice del sottoalbero da eliminare
+     */
+    void remove(const bst<T, CMP> *node)
+    {
+        std::vector<std::pair<T, std::size_t>> removed; // Chiavi indicizzate con un nodo del sottoalbero
+        std::vector<const bst<T, CMP> *> pending{node};
+        while (!pending.empty())
+        {
+            const bst<T, CMP> *current{pending.back()};
+            pending.pop_back();
+            std::size_t hash{mix(current->key)};
+            std::size_t i{probeNode(current, hash)};
+            if (table[i].node == current)
+            {
+                removed.emplace_back(current->key, hash);
+                eraseSlot(i);
+            }
+            for (const bst<T, CMP> *child : {current->left, current->right})
+            {
+                if (child != nullptr)
+                {
+                    pending.push_back(child);
+                }
+            }
+        }
+        if (node == this) // La radice non può essere deallocata: si eliminano i figli e la si svuota
+        {
+            if (this->left != nullptr)
+            {
+                this->left->remove();
+            }
+            if (this->right != nullptr)
+            {
+                this->right->remove();
+            }
+            this->empty = true;
+            this->count = 0;
+        }
+        else
+        {
+            const_cast<bst<T, CMP> *>(node)->remove(); // Il nodo appartiene a questo albero, di cui si ha accesso in scrittura
+        }
+        for (const std::pair<T, std::size_t> &entry : removed) // Le occorrenze rimaste fuori dal sottoalbero restano cercabili
+        {
+            bst<T, CMP> *other{this->isEmpty() ? nullptr : bst<T, CMP>::find(entry.first)};
+            if (other != nullptr)
+            {
+                indexNode(other);
+            }
+        }
+    }
+
+    /**
+     * @brief Ricostruisce l'indice a partire dai nodi dell'albero
+     * Da usare dopo le operazioni che spostano le chiavi tra i nodi senza aggiornare l'indice.
+     */
+    void reindex()
+    {
+        table.assign(table.size(), slot{nullptr, 0});
+        used = 0;
+        if (!this->isEmpty())
+        {
+            for (bst<T, CMP> *node{bst<T, CMP>::min()}; node != nullptr; node = bst<T, CMP>::nextNode(node))
+            {
+                indexNode(node);
+            }
+        }
+    }
+
+    /**
+     * @brief Eliminazione delle chiavi di un intervallo chiuso [a, b] (vedi bst::eraseRange())
+     * La cancellazione può spostare chiavi tra i nodi rimasti, quindi l'indice viene ricostruito.
+     *
+     * @param a è l'estremo sinistro dell'intervallo
+     * @param b è l'estremo destro dell'intervallo
+     * @return numero di nodi eliminati
+     */
+    u_int eraseRange(const T &a, const T &b)
+    {
+        u_int erased{bst<T, CMP>::eraseRange(a, b)};
+        reindex();
+        return erased;
+    }
+
+    /**
+     * @brief Eliminazione dei nodi la cui chiave soddisfa un predicato (vedi bst::eraseIf()) e ricostruzione dell'indice
+     *
+     * @tparam PRED è il tipo del predicato
+     * @param pred è il predicato che indica le chiavi da eliminare
+     * @return numero di nodi eliminati
+     */
+    template <typename PRED>
+    u_int eraseIf(PRED pred)
+    {
+        u_int erased{bst<T, CMP>::eraseIf(pred)};
+        reindex();
+        return erased;
+    }
+
+    /**
+     * @brief Ribilancia l'albero (algoritmo di Day-Stout-Warren) e ricostruisce l'indice
+     */
+    void rebalance()
+    {
+        bst<T, CMP>::rebalance();
+        reindex();
+    }
+
+    /**
+     * @brief Riorganizza in memoria i nodi dell'albero e ricostruisce l'indice
+     *
+     * @param order è l'ordine da utilizzare
+     */
+    void relayout(layoutOrder order)
+    {
+        bst<T, CMP>::relayout(order);
+        reindex();
+    }
+
+    /**
+     * @brief Compatta i nodi in memoria nell'ordine della visita simmetrica e ricostruisce l'indice
+     */
+    inline void compact()
+    {
+        relayout(layoutOrder::inorder);
+    }
+
+    /**
+     * @brief Restituisce il numero di chiavi distinte indicizzate
+     *
+     * @return std::size_t è il numero di chiavi nell'indice
+     */
+    inline std::size_t indexedKeys() const
+    {
+        return used;
+    }
+};
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef __intervalTree_hpp__
+#define __intervalTree_hpp__
+
+#include <string>
+#include <vector>
+
+#include "bst.hpp"
+
+/**
+ * @brief Intervallo chiuso [low, high]
+ *
+ * @tparam V è il tipo degli estremi (deve avere l'operatore <)
+ */
+template <typename V>
+struct interval
+{
+    V low;
+    V high;
+
+    inline bool operator==(const interval<V> &other) const
+    {
+        return !(low < other.low) && !(other.low < low) && !(high < other.high) && !(other.high < high);
+    }
+};
+
+/**
+ * @brief Relazione d'ordine degli intervalli nel ruolo di std::greater: per estremo sinistro e, a parità, per estremo destro
+ *
+ * @tparam V è il tipo degli estremi
+ */
+template <typename V>
+struct intervalOrder
+{
+    inline bool operator()(const interval<V> &a, const interval<V> &b) const
+    {
+        return b.low < a.low || (!(a.low < b.low) && b.high < a.high);
+    }
+};
+
+/**
+ * @brief Proiezione dell'estremo destro di un intervallo, per l'aumento di intervalTree
+ */
+struct intervalEnd
+{
+    template <typename V>
+    inline const V &operator()(const interval<V> &range) const
+    {
+        return range.high;
+    }
+};
+
+/**
+ * @class intervalTree
+ *
+ * @brief Albero di intervalli: le chiavi sono intervalli chiusi ordinati per estremo sinistro e ogni nodo memorizza
+ * il massimo estremo destro del proprio sottoalbero (aumento monoidAugmentation con maxMonoid).
+ * La ricerca degli intervalli che si sovrappongono a [x, y] scarta i sottoalberi in cui nessun intervallo termina dopo x
+ * e quelli in cui tutti gli intervalli iniziano dopo y, quindi visita O(h) nodi per ogni intervallo trovato invece di tutti i nodi.
+ *
+ * @tparam V è il tipo degli estremi degli intervalli
+ */
+template <typename V>
+class intervalTree : public bst<interval<V>, intervalOrder<V>, monoidAugmentation<interval<V>, intervalEnd, maxMonoid<V>>>
+{
+private:
+    using node_type = bst<interval<V>, intervalOrder<V>, monoidAugmentation<interval<V>, intervalEnd, maxMonoid<V>>>;
+
+    /**
+     * @brief Raccoglie in ordine gli intervalli di un sottoalbero che si sovrappongono a [x, y]
+     *
+     * @param node è la radice del sottoalbero (può essere nullptr)
+     * @param x è l'estremo sinistro dell'intervallo cercato
+     * @param y è l'estremo destro dell'intervallo cercato
+     * @param result sono gli intervalli trovati
+     */
+    static void collect(const node_type *node, const V &x, const V &y, std::vector<interval<V>> &result)
+    {
+        if (node == nullptr || node->aug < x) // Nessun intervallo del sottoalbero termina dopo x
+        {
+            return;
+        }
+        collect(node->left, x, y, result);
+        if (y < node->key.low) // Il nodo e il sottoalbero destro iniziano dopo y
+        {
+            return;
+        }
+        if (!(node->key.high < x))
+        {
+            result.insert(result.end(), node->count, node->key);
+        }
+        collect(node->right, x, y, result);
+    }
+
+public:
+    /**
+     * @brief Costruttore vuoto
+     */
+    intervalTree() : node_type() {}
+
+    /**
+     * @brief Costruttore per convertire un array di intervalli in un albero
+     *
+     * @param array che si vuole convertire nell'albero (ogni intervallo deve avere low <= high)
+     * @param length è la lunghezza dell'array
+     */
+    intervalTree(const interval<V> array[], uint length) : node_type(array, length) {}
+
+    /**
+     * @brief Intervalli che si sovrappongono a [x, y], cioè con low <= y e high >= x
+     * Il costo è O(h) per ogni intervallo restituito (O(log n + k) nei casi tipici) invece di O(n).
+     *
+     * @param x è l'estremo sinistro
+     * @param y è l'estremo destro
+     * @return std::vector<interval<V>> sono gli intervalli trovati, ordinati per estremo sinistro
+     */
+    std::vector<interval<V>> overlaps(const V &x, const V &y) const
+    {
+        std::vector<interval<V>> result;
+        if (!this->isEmpty())
+        {
+            collect(this, x, y, result);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Ricerca di un intervallo qualsiasi che si sovrappone a [x, y] in O(h)
+     * Se il sottoalbero sinistro contiene un intervallo che termina dopo x e nessuno di essi si sovrappone a [x, y],
+     * allora tutti iniziano dopo y, e così anche quelli del sottoalbero destro: basta quindi seguire un solo cammino.
+     *
+     * @param x è l'estremo sinistro
+     * @param y è l'estremo destro
+     * @return puntatore al nodo trovato o nullptr se nessun intervallo si sovrappone a [x, y]
+     */
+    const node_type *findOverlap(const V &x, const V &y) const
+    {
+        const node_type *node{this->isEmpty() ? nullptr : this};
+        while (node != nullptr && !(!(y < node->key.low) && !(node->key.high < x)))
+        {
+            node = (node->left != nullptr && !(node->left->aug < x)) ? node->left : node->right;
+        }
+        return node;
+    }
+};
+
+/**
+ * Stampa un intervallo su uno stream
+ *
+ * @param os è lo stream di output
+ * @param range è l'intervallo da stampare
+ * @return è il riferimento allo stream di output
+ */
+template <typename V>
+std::ostream &operator<<(std::ostream &os, const interval<V> &range)
+{
+    os << "[" << range.low << ", " << range.high << "]";
+    return os;
+}
+
+/**
+ * @brief Metodo per ottenere una rappresentazione mediante stringa di un intervallo
+ *
+ * @param range è l'intervallo di cui si vuole ricavare una rappresentazione mediante stringa
+ * @return std::string
+ */
+template <typename V>
+inline std::string to_string(const interval<V> &range)
+{
+    return "[" + to_string_adl(range.low) + ", " + to_string_adl(range.high) + "]";
+}
+
+#endif
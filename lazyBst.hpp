@@ -0,0 +1,517 @@
+#ifndef __lazyBst_hpp__
+#define __lazyBst_hpp__
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "bst.hpp"
+
+/**
+ * @brief Aumento di lazyBst: numero di nodi e di tombstone del sottoalbero
+ * Una tombstone è un nodo con 0 occorrenze, quindi entrambi i contatori si ricavano dalla chiave e dalle occorrenze.
+ */
+struct tombstoneAugmentation
+{
+    struct value_type
+    {
+        uint32_t nodes; // nodi del sottoalbero
+        uint32_t dead;  // tombstone del sottoalbero
+    };
+
+    static constexpr bool enabled{true};
+
+    static inline value_type identity()
+    {
+        return {0, 0};
+    }
+
+    template <typename T>
+    static inline value_type lift(const T &, unsigned int count)
+    {
+        return {1, count == 0 ? 1u : 0u};
+    }
+
+    static inline value_type combine(const value_type &a, const value_type &b)
+    {
+        return {a.nodes + b.nodes, a.dead + b.dead};
+    }
+};
+
+/**
+ * @class lazyBst
+ *
+ * @brief Albero binario di ricerca con cancellazione pigra.
+ * deleteKey() non modifica la struttura dell'albero: trova un'occorrenza della chiave in O(h) e la marca come cancellata
+ * (tombstone) portando a 0 il numero di occorrenze del nodo. Ricerche, min(), max() e iteratori ignorano le tombstone e
+ * un inserimento che incontra una tombstone con la stessa chiave la riutilizza. Ogni nodo conta i nodi e le tombstone del
+ * proprio sottoalbero (tombstoneAugmentation), quindi le ricerche saltano i sottoalberi senza chiavi valide.
+ * Come nello scapegoat tree la ricostruzione è locale: risalendo dalla nuova tombstone si cerca il sottoalbero più basso
+ * in cui le tombstone sono almeno rebuildMinimum e almeno la frazione threshold dei nodi, e solo quel sottoalbero viene
+ * ricostruito bilanciato con le sole chiavi valide. Una ricostruzione di m nodi elimina almeno threshold·m tombstone,
+ * quindi il costo ammortizzato di una cancellazione resta O(h + 1/threshold), e cancellazioni sparse nell'albero
+ * ricostruiscono sottoalberi piccoli invece di bloccare l'albero per una ricostruzione completa.
+ * Il prezzo è il tempo totale: marcare la tombstone, aggiornare i contatori del cammino e ricostruire i sottoalberi costa
+ * più della cancellazione di bst (su chiavi casuali circa il 10-20% in più con threshold 0.5 e fino al doppio con 0.1),
+ * in cambio di un tempo massimo per cancellazione limitato e di nessuna modifica strutturale durante le cancellazioni.
+ * L'ereditarietà da bst è privata: i metodi di bst che modificano l'albero (deleteKey, insertBatch, eraseRange, split,
+ * join, ...) non aggiornerebbero i contatori delle chiavi valide e delle tombstone, e le visite di bst vedrebbero anche
+ * le tombstone. Per lo stesso motivo i nodi restituiti sono costanti.
+ *
+ * @tparam T è il tipo di dato delle chiavi associate ai nodi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ */
+template <typename T, typename CMP = std::greater<T>>
+class lazyBst : private bst<T, CMP, tombstoneAugmentation>
+{
+private:
+    using node_type = bst<T, CMP, tombstoneAugmentation>;
+
+    static const std::size_t rebuildMinimum{64}; // numero di tombstone sotto cui un sottoalbero non viene mai ricostruito
+
+    std::size_t live;       // numero di chiavi valide
+    std::size_t tombstones; // numero di nodi marcati come cancellati
+    double threshold;       // frazione di tombstone tra i nodi di un sottoalbero che ne provoca la ricostruzione
+
+    /**
+     * @brief Cerca un'occorrenza valida di una chiave in un sottoalbero
+     * Dopo le rotazioni di rebuild() i duplicati possono trovarsi in entrambi i sottoalberi di un nodo con la stessa chiave.
+     *
+     * @param node è la radice del sottoalbero (può essere nullptr)
+     * @param value è la chiave da cercare
+     * @return puntatore al nodo trovato o nullptr se la chiave non ha occorrenze valide
+     */
+    static node_type *findLive(node_type *node, const T &value)
+    {
+        while (node != nullptr && node->aug.dead < node->aug.nodes) // Un sottoalbero di sole tombstone non ha chiavi valide
+        {
+            if (node->cmp(value, node->key))
+            {
+                node = node->right;
+            }
+            else if (node->cmp(node->key, value))
+            {
+                node = node->left;
+            }
+            else if (node->count > 0)
+            {
+                return node;
+            }
+            else
+            {
+                node_type *found{findLive(node->left, value)};
+                return found != nullptr ? found : findLive(node->right, value);
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Primo nodo valido a partire da un nodo nell'ordine della visita simmetrica
+     *
+     * @param node è il nodo di partenza (può essere nullptr)
+     * @return puntatore al nodo valido o nullptr se non esiste
+     */
+    static node_type *skipForward(node_type *node)
+    {
+        while (node != nullptr && node->count == 0)
+        {
+            node = node_type::nextNode(node);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Primo nodo valido a partire da un nodo nell'ordine inverso della visita simmetrica
+     *
+     * @param node è il nodo di partenza (può essere nullptr)
+     * @return puntatore al nodo valido o nullptr se non esiste
+     */
+    static node_type *skipBackward(node_type *node)
+    {
+        while (node != nullptr && node->count == 0)
+        {
+            node = node_type::prevNode(node);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Nodo centrale di un intervallo ordinato di nodi, spostato dopo quelli con la stessa chiave (come in buildSorted())
+     *
+     * @param first è il puntatore al primo nodo
+     * @param last è il puntatore successivo all'ultimo nodo
+     * @return puntatore al nodo che diventa radice del sottoalbero
+     */
+    static node_type **median(node_type **first, node_type **last)
+    {
+        node_type **mid{first + (last - first) / 2};
+        while (mid + 1 != last && !(*mid)->cmp((*(mid + 1))->key, (*mid)->key)) // I duplicati della mediana restano a sinistra
+        {
+            ++mid;
+        }
+        return mid;
+    }
+
+    /**
+     * @brief Collega in un sottoalbero bilanciato un intervallo ordinato di nodi staccati, senza allocare memoria
+     *
+     * @param first è il puntatore al primo nodo
+     * @param last è il puntatore successivo all'ultimo nodo
+     * @return puntatore alla radice del sottoalbero (nullptr se l'intervallo è vuoto)
+     */
+    static node_type *link(node_type **first, node_type **last)
+    {
+        if (first == last)
+        {
+            return nullptr;
+        }
+        node_type **mid{median(first, last)};
+        (*mid)->setLeft(link(first, mid));
+        (*mid)->setRight(link(mid + 1, last));
+        return *mid;
+    }
+
+    /**
+     * @brief Ricostruisce bilanciato un sottoalbero con le sole chiavi valide in O(m), eliminandone le tombstone
+     * I nodi validi vengono ricollegati senza allocare memoria; solo i nodi delle tombstone vengono deallocati.
+     * La radice dell'albero non è allocata con new e deve restare la radice: se il sottoalbero è l'intero albero la sua
+     * chiave viene scambiata con quella della mediana.
+     *
+     * @param top è la radice del sottoalbero (non vuoto)
+     */
+    void rebuild(node_type *top)
+    {
+        node_type *above{top->parent};
+        bool onLeft{above != nullptr && above->left == top};
+        tombstones -= top->aug.dead;
+        if (above == nullptr && top->aug.dead == top->aug.nodes) // Nessuna chiave valida nell'albero
+        {
+            delete this->release();
+            return;
+        }
+        std::vector<node_type *> nodes;
+        std::vector<node_type *> garbage;
+        nodes.reserve(top->aug.nodes - top->aug.dead);
+        garbage.reserve(top->aug.dead);
+        node_type *last{top->node_type::max()};
+        for (node_type *node{top->node_type::min()};; node = node_type::nextNode(node))
+        {
+            (node->count > 0 ? nodes : garbage).push_back(node);
+            if (node == last)
+            {
+                break;
+            }
+        }
+        node_type **root{top == this ? median(nodes.data(), nodes.data() + nodes.size()) : nullptr};
+        if (top == this && *root != this) // La chiave mediana passa nella radice e la chiave della radice nel nodo della mediana
+        {
+            for (std::vector<node_type *> *list : {&nodes, &garbage})
+            {
+                std::replace(list->begin(), list->end(), static_cast<node_type *>(this), *root);
+            }
+            node_type::swapPayload(this, *root);
+            *root = this;
+        }
+        for (std::vector<node_type *> *list : {&nodes, &garbage})
+        {
+            for (node_type *node : *list)
+            {
+                node->parent = node->left = node->right = nullptr;
+            }
+        }
+        for (node_type *node : garbage)
+        {
+            delete node;
+        }
+        if (top == this)
+        {
+            this->setLeft(link(nodes.data(), root));
+            this->setRight(link(root + 1, nodes.data() + nodes.size()));
+            return;
+        }
+        node_type *subtree{link(nodes.data(), nodes.data() + nodes.size())};
+        if (onLeft)
+        {
+            above->setLeft(subtree);
+        }
+        else
+        {
+            above->setRight(subtree);
+        }
+        node_type::fixUpward(above->parent);
+    }
+
+public:
+    using node_type::operator new;
+    using node_type::operator delete;
+    using node_type::height;
+
+    /**
+     * @class const_iterator
+     *
+     * @brief Iteratore costante sulle chiavi valide in ordine crescente; end() segue l'ultima chiave
+     */
+    class const_iterator
+    {
+    private:
+        node_type *ptr; // nodo corrente (nullptr per end())
+
+        const_iterator(node_type *inputPtr) : ptr{inputPtr} {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = node_type;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        /**
+         * @brief Costruttore vuoto pubblico
+         */
+        const_iterator() : ptr{nullptr} {}
+
+        const_iterator &operator++()
+        {
+            ptr = skipForward(node_type::nextNode(ptr));
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator current{*this};
+            ++(*this);
+            return current;
+        }
+
+        inline reference operator*() const
+        {
+            return *ptr;
+        }
+
+        inline pointer operator->() const
+        {
+            return ptr;
+        }
+
+        inline bool operator==(const const_iterator &it) const
+        {
+            return ptr == it.ptr;
+        }
+
+        inline bool operator!=(const const_iterator &it) const
+        {
+            return !(*this == it);
+        }
+
+        friend class lazyBst<T, CMP>;
+    };
+
+    /**
+     * @brief Costruttore vuoto
+     *
+     * @param inputThreshold è la frazione di tombstone oltre la quale l'albero viene ricostruito
+     */
+    lazyBst(double inputThreshold = 0.5) : node_type(), live{0}, tombstones{0}, threshold{inputThreshold} {}
+
+    /**
+     * @brief Costruttore per convertire un array in un albero
+     *
+     * @param array che si vuole convertire nell'albero
+     * @param length è la lunghezza dell'array
+     * @param inputThreshold è la frazione di tombstone oltre la quale l'albero viene ricostruito
+     */
+    lazyBst(const T array[], uint length, double inputThreshold = 0.5) : lazyBst(inputThreshold)
+    {
+        for (uint i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    /**
+     * @brief Inserisce un valore; se il cammino di inserimento attraversa una tombstone con la stessa chiave la riutilizza
+     *
+     * @param value è il valore da inserire
+     * @return lazyBst& è l'albero stesso
+     */
+    lazyBst<T, CMP> &insertValue(const T &value)
+    {
+        ++live;
+        if (tombstones > 0)
+        {
+            for (node_type *node{this}; node != nullptr; node = node->cmp(value, node->key) ? node->right : node->left)
+            {
+                if (node->count == 0 && !node->cmp(node->key, value) && !node->cmp(value, node->key))
+                {
+                    node->count = 1;
+                    --tombstones;
+                    for (; node != nullptr; node = node->parent)
+                    {
+                        --node->aug.dead;
+                    }
+                    return *this;
+                }
+            }
+        }
+        this->insertNode(value);
+        return *this;
+    }
+
+    /**
+     * @brief Ricerca di una chiave valida
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore costante al nodo trovato o nullptr se la chiave non è presente
+     */
+    inline const node_type *find(const T &value) const
+    {
+        return node_type::isEmpty() ? nullptr : findLive(const_cast<lazyBst<T, CMP> *>(this), value);
+    }
+
+    /**
+     * @brief Metodo che informa se una chiave è presente (senza lanciare eccezioni)
+     *
+     * @param value è la chiave da cercare
+     * @return true se la chiave è presente
+     * @return false se la chiave non è presente
+     */
+    inline bool isPresent(const T &value) const
+    {
+        return find(value) != nullptr;
+    }
+
+    /**
+     * @brief Ricerca di una chiave valida
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore costante al nodo trovato
+     */
+    const node_type *binarySearch(const T &value) const
+    {
+        const node_type *node{find(value)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Cancellazione pigra di un'occorrenza di una chiave in O(h): il nodo resta nell'albero come tombstone
+     * Risalendo dal nodo si aggiornano i contatori degli antenati e si ricostruisce il sottoalbero più basso che ha
+     * raggiunto la soglia di tombstone. Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da eliminare
+     */
+    void deleteKey(const T &value)
+    {
+        node_type *node{node_type::isEmpty() ? nullptr : findLive(this, value)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        node->count = 0;
+        --live;
+        ++tombstones;
+        node_type *scapegoat{nullptr};
+        for (; node != nullptr; node = node->parent) // Solo i nodi del cammino, già letti dalla discesa
+        {
+            ++node->aug.dead;
+            if (scapegoat == nullptr && node->aug.dead >= rebuildMinimum && node->aug.dead >= threshold * node->aug.nodes)
+            {
+                scapegoat = node;
+            }
+        }
+        if (scapegoat != nullptr)
+        {
+            rebuild(scapegoat);
+        }
+    }
+
+    /**
+     * @brief Ricostruisce l'albero bilanciato con le sole chiavi valide in O(n), eliminando tutte le tombstone
+     */
+    inline void rebuild()
+    {
+        if (!node_type::isEmpty())
+        {
+            rebuild(this);
+        }
+    }
+
+    /**
+     * @brief Restituisce il nodo con la chiave valida minima
+     *
+     * @return puntatore costante al nodo (nullptr se non ci sono chiavi valide)
+     */
+    inline const node_type *min() const
+    {
+        return begin().ptr;
+    }
+
+    /**
+     * @brief Restituisce il nodo con la chiave valida massima
+     *
+     * @return puntatore costante al nodo (nullptr se non ci sono chiavi valide)
+     */
+    inline const node_type *max() const
+    {
+        return node_type::isEmpty() ? nullptr : skipBackward(const_cast<lazyBst<T, CMP> *>(this)->node_type::max());
+    }
+
+    /**
+     * @brief Contatore delle chiavi valide in tempo costante
+     *
+     * @return std::size_t è il numero di chiavi valide
+     */
+    inline std::size_t nodesCount() const
+    {
+        return live;
+    }
+
+    /**
+     * @brief Informa se l'albero non ha chiavi valide (le tombstone non contano)
+     *
+     * @return true se non ci sono chiavi valide
+     * @return false altrimenti
+     */
+    inline bool isEmpty() const
+    {
+        return live == 0;
+    }
+
+    /**
+     * @brief Restituisce il numero di tombstone in attesa di ricostruzione
+     *
+     * @return std::size_t è il numero di nodi marcati come cancellati
+     */
+    inline std::size_t tombstoneCount() const
+    {
+        return tombstones;
+    }
+
+    inline const_iterator begin() const
+    {
+        return const_iterator{node_type::isEmpty() ? nullptr : skipForward(const_cast<lazyBst<T, CMP> *>(this)->node_type::min())};
+    }
+
+    inline const_iterator end() const
+    {
+        return const_iterator{nullptr};
+    }
+
+    /**
+     * @brief Iteratore successivo all'ultima chiave valida (uguale a end(), come cend() di bst, btree e vebTree)
+     *
+     * @return const_iterator che indica la fine della visita
+     */
+    inline const_iterator cend() const
+    {
+        return const_iterator{nullptr};
+    }
+};
+
+#endif
@@ -0,0 +1,290 @@
+#ifndef __learnedIndex_hpp__
+#define __learnedIndex_hpp__
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "bst.hpp"
+
+/**
+ * @class learnedIndex
+ *
+ * @brief Indice appreso (recursive model index a due livelli) su un'istantanea delle chiavi intere di un albero.
+ * Le chiavi vengono copiate in un array ordinato. Un modello lineare di primo livello sceglie uno dei modelli di
+ * secondo livello, ciascuno dei quali è una retta (minimi quadrati) che stima la posizione della chiave nell'array;
+ * per ogni modello si memorizza l'errore massimo commesso sulle sue chiavi, quindi la ricerca si conclude con una
+ * ricerca binaria in una finestra di dimensione limitata invece che con log n livelli di accessi dipendenti.
+ * L'interfaccia di ricerca (lower_bound, find, contains, min, max, size) è la stessa di staticBst.
+ * L'istantanea non segue le modifiche successive dell'albero.
+ *
+ * @tparam T è il tipo intero delle chiavi (in ordine crescente, come in bst<T> con std::greater)
+ */
+template <typename T>
+class learnedIndex
+{
+    static_assert(std::is_integral<T>::value, "learnedIndex richiede chiavi intere");
+
+private:
+    /**
+     * @brief Modello di secondo livello: retta e finestra di errore sulle posizioni [first, next.first)
+     */
+    struct model
+    {
+        double slope;
+        double intercept;
+        uint32_t first;    // prima posizione delle chiavi assegnate al modello
+        uint32_t errBelow; // massimo scarto tra posizione stimata e posizione reale (stima in eccesso)
+        uint32_t errAbove; // massimo scarto tra posizione reale e posizione stimata (stima in difetto)
+    };
+
+    std::vector<T> keys;       // chiavi ordinate
+    std::vector<model> models; // modelli di secondo livello (più una sentinella)
+    double rootSlope;          // modello di primo livello: indice del modello = (chiave - minimo) * rootSlope
+    T lowest;                  // chiave minima
+
+    /**
+     * @brief Modello di secondo livello a cui è assegnata una chiave (funzione non decrescente della chiave)
+     *
+     * @param value è la chiave
+     * @return std::size_t è l'indice del modello
+     */
+    inline std::size_t route(const T &value) const
+    {
+        double slot{((double)value - (double)lowest) * rootSlope};
+        std::size_t last{models.size() - 2};
+        return slot <= 0 ? 0 : (slot >= last ? last : (std::size_t)slot);
+    }
+
+    /**
+     * @brief Posizione stimata di una chiave da un modello di secondo livello (funzione non decrescente della chiave)
+     *
+     * @param m è il modello
+     * @param value è la chiave
+     * @return int64_t è la posizione stimata
+     */
+    static inline int64_t predict(const model &m, const T &value)
+    {
+        double position{m.slope * (double)value + m.intercept};
+        return position <= -1e18 ? (int64_t)-1e18 : (position >= 1e18 ? (int64_t)1e18 : (int64_t)position);
+    }
+
+    /**
+     * @brief Addestra i modelli sulle chiavi ordinate
+     *
+     * @param keysPerModel è il numero medio di chiavi per modello di secondo livello
+     */
+    void train(std::size_t keysPerModel)
+    {
+        const std::size_t n{keys.size()};
+        const std::size_t count{n / keysPerModel + 1};
+        lowest = n == 0 ? T{} : keys.front();
+        double range{n == 0 ? 0 : (double)keys.back() - (double)keys.front()};
+        rootSlope = range == 0 ? 0 : count / (range + 1); // Interpolazione lineare dal minimo al massimo
+        models.assign(count + 1, model{0, 0, 0, 0, 0});
+
+        std::size_t i{0};
+        for (std::size_t j{0}; j < count; ++j)
+        {
+            model &m{models[j]};
+            m.first = i;
+            std::size_t end{i};
+            while (end < n && route(keys[end]) == j)
+            {
+                ++end;
+            }
+            double sumX{0}, sumY{0}, sumXX{0}, sumXY{0}; // Minimi quadrati su (chiave, posizione) centrati sulla prima chiave
+            for (std::size_t p{i}; p < end; ++p)
+            {
+                double x{(double)keys[p] - (double)keys[i]};
+                sumX += x;
+                sumY += p;
+                sumXX += x * x;
+                sumXY += x * p;
+            }
+            double size = end - i;
+            double variance{size * sumXX - sumX * sumX};
+            m.slope = (size == 0 || variance <= 0) ? 0 : (size * sumXY - sumX * sumY) / variance;
+            m.slope = m.slope < 0 ? 0 : m.slope;
+            m.intercept = size == 0 ? i : (sumY - m.slope * sumX) / size - m.slope * (double)keys[i];
+            for (std::size_t p{i}; p < end; ++p)
+            {
+                int64_t error{predict(m, keys[p]) - (int64_t)p};
+                if (error > 0 && (uint64_t)error > m.errBelow)
+                {
+                    m.errBelow = error;
+                }
+                if (error < 0 && (uint64_t)-error > m.errAbove)
+                {
+                    m.errAbove = -error;
+                }
+            }
+            i = end;
+        }
+        models[count].first = n; // Sentinella: fine dell'ultimo intervallo
+    }
+
+    /**
+     * @brief Posizione della prima chiave non minore di value
+     * Le chiavi assegnate ai modelli precedenti sono minori di value e quelle dei successivi maggiori, quindi la posizione
+     * cercata è nell'intervallo del modello; la finestra di errore la restringe a [stima - errBelow, stima + errAbove + 1].
+     *
+     * @param value è la chiave da cercare
+     * @return std::size_t è la posizione (keys.size() se tutte le chiavi sono minori di value)
+     */
+    std::size_t lowerBoundIndex(const T &value) const
+    {
+        if (keys.empty())
+        {
+            return 0;
+        }
+        std::size_t j{route(value)};
+        const model &m{models[j]};
+        int64_t first{m.first}, last{models[j + 1].first};
+        int64_t guess{predict(m, value)};
+        int64_t low{std::max(first, guess - (int64_t)m.errBelow)};
+        int64_t high{std::min(last, guess + (int64_t)m.errAbove + 1)};
+        low = std::min(low, last);
+        high = std::max(high, low);
+        return std::lower_bound(keys.begin() + low, keys.begin() + high, value) - keys.begin();
+    }
+
+public:
+    /**
+     * @brief Costruttore da un vettore di chiavi (non necessariamente ordinato)
+     *
+     * @param input sono le chiavi dell'indice
+     * @param keysPerModel è il numero medio di chiavi per modello di secondo livello
+     */
+    learnedIndex(std::vector<T> input, std::size_t keysPerModel = 256) : keys{std::move(input)}
+    {
+        std::sort(keys.begin(), keys.end());
+        train(keysPerModel == 0 ? 1 : keysPerModel);
+    }
+
+    /**
+     * @brief Costruttore da un albero: l'istantanea contiene le chiavi nell'ordine della visita simmetrica
+     *
+     * @param tree è l'albero di cui fare l'istantanea
+     * @param keysPerModel è il numero medio di chiavi per modello di secondo livello
+     */
+    learnedIndex(bst<T> &tree, std::size_t keysPerModel = 256) : learnedIndex(inorderKeys(tree), keysPerModel) {}
+
+    /**
+     * @brief Chiavi di un albero nell'ordine della visita simmetrica
+     *
+     * @param tree è l'albero
+     * @return std::vector<T> sono le chiavi ordinate
+     */
+    static std::vector<T> inorderKeys(bst<T> &tree)
+    {
+        std::vector<T> result;
+        if (!tree.isEmpty())
+        {
+            bst<T> *last{tree.max()};
+            for (bst<T> *node{tree.min()};; node = node->successor())
+            {
+                result.push_back(node->getKey());
+                if (node == last)
+                {
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Restituisce il numero di chiavi
+     *
+     * @return std::size_t è il numero di chiavi dell'indice
+     */
+    inline std::size_t size() const
+    {
+        return keys.size();
+    }
+
+    /**
+     * @brief Ricerca della prima chiave non minore di value
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore alla chiave trovata o nullptr se tutte le chiavi sono minori di value
+     */
+    inline const T *lower_bound(const T &value) const
+    {
+        std::size_t k{lowerBoundIndex(value)};
+        return k == keys.size() ? nullptr : &keys[k];
+    }
+
+    /**
+     * @brief Ricerca di una chiave
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore alla chiave trovata o nullptr se non è presente
+     */
+    inline const T *find(const T &value) const
+    {
+        const T *candidate{lower_bound(value)};
+        return (candidate == nullptr || *candidate != value) ? nullptr : candidate;
+    }
+
+    /**
+     * @brief Metodo che informa se una chiave è presente
+     *
+     * @param value è la chiave da cercare
+     * @return true se la chiave è presente
+     * @return false se la chiave non è presente
+     */
+    inline bool contains(const T &value) const
+    {
+        return find(value) != nullptr;
+    }
+
+    /**
+     * @brief Restituisce la chiave minima
+     *
+     * @return const T& è il riferimento alla chiave minima
+     */
+    inline const T &min() const
+    {
+        return keys.front();
+    }
+
+    /**
+     * @brief Restituisce la chiave massima
+     *
+     * @return const T& è il riferimento alla chiave massima
+     */
+    inline const T &max() const
+    {
+        return keys.back();
+    }
+
+    /**
+     * @brief Restituisce la dimensione massima della finestra della ricerca binaria finale
+     *
+     * @return std::size_t è il numero massimo di posizioni esaminate dopo la stima dei modelli
+     */
+    std::size_t maxError() const
+    {
+        std::size_t result{0};
+        for (std::size_t j{0}; j + 1 < models.size(); ++j)
+        {
+            result = std::max<std::size_t>(result, models[j].errBelow + models[j].errAbove + 1);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Restituisce la memoria occupata dai modelli
+     *
+     * @return std::size_t è il numero di byte dei modelli (escluse le chiavi)
+     */
+    inline std::size_t modelBytes() const
+    {
+        return models.size() * sizeof(model);
+    }
+};
+
+#endif
@@ -0,0 +1,681 @@
+#ifndef __loggedBst_hpp__
+#define __loggedBst_hpp__
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "bst.hpp"
+
+/**
+ * @brief Politica con cui loggedBst forza la scrittura su disco del log
+ */
+enum class syncPolicy
+{
+    always, // fdatasync dopo ogni modifica: una modifica completata non viene mai persa
+    group,  // fdatasync a ogni gruppo di record (group commit) e con sync(): si perdono al più le modifiche dell'ultimo gruppo
+    never   // nessun fdatasync: il log sopravvive alla terminazione del processo ma non a quella del sistema operativo
+};
+
+/**
+ * @class loggedBst
+ *
+ * @brief Albero binario di ricerca persistente: ogni modifica viene registrata in un log binario (write-ahead log)
+ * prima di essere applicata all'albero.
+ * I record di insertValue(), deleteKey() e remove() vengono accumulati in un buffer e scritti nel log a gruppi
+ * (group commit), quindi l'inserimento costa in media una copia di pochi byte; la politica syncPolicy stabilisce quando
+ * il log viene forzato su disco. Alla costruzione l'albero viene ricostruito caricando l'ultima istantanea e rieseguendo
+ * i record dei log successivi; un record incompleto in coda (scrittura interrotta) viene scartato.
+ * checkpoint() scrive una nuova istantanea in un thread separato e poi elimina i log che essa rende inutili.
+ *
+ * File usati (path è il percorso fornito al costruttore):
+ * - path.snapshot: istantanea delle chiavi in ordine crescente, con la generazione del primo log da rieseguire;
+ * - path.log.N: log della generazione N, che contiene le modifiche successive all'avvio del checkpoint N.
+ *
+ * L'ereditarietà da bst è privata: sono disponibili solo le modifiche registrate e le operazioni che non cambiano
+ * le chiavi (ricerche, visite, iteratori, rebalance(), relayout()). Le altre operazioni che modificano l'albero
+ * (eraseRange, erase, eraseIf, split, join, swap, insertBatch, inserimento con hint, ...) non sono registrate nel log
+ * e quindi non sono accessibili. Per lo stesso motivo ricerche e visite restituiscono nodi costanti e insertValue()
+ * restituisce l'albero stesso: da un nodo non si può raggiungere un metodo che modifichi l'albero senza passare dal log.
+ *
+ * @tparam T è il tipo di dato delle chiavi, che vengono scritte byte per byte (deve essere trivially copyable)
+ * @tparam CMP è la relazione d'ordine del tipo T
+ */
+template <typename T, typename CMP = std::greater<T>>
+class loggedBst : private bst<T, CMP>
+{
+    static_assert(std::is_trivially_copyable<T>::value, "loggedBst richiede chiavi trivially copyable");
+
+private:
+    static const uint32_t logMagic{0x474f4c42};      // "BLOG"
+    static const uint32_t snapshotMagic{0x50414e53}; // "SNAP"
+    static const std::size_t logHeaderSize{8};       // magic e dimensione della chiave
+    static const std::size_t snapshotHeaderSize{24}; // magic, dimensione della chiave, generazione e numero di chiavi
+    static const std::size_t recordSize{1 + sizeof(T) + 4}; // operazione, chiave e checksum
+    static const char insertRecord{'I'};
+    static const char deleteRecord{'D'};
+
+    std::string path;              // prefisso dei file del log e dell'istantanea
+    syncPolicy policy;             // politica di scrittura su disco
+    std::size_t groupBytes;        // dimensione di un gruppo di record
+    std::vector<char> pending;     // record non ancora scritti nel log
+    int fd;                        // descrittore del log corrente
+    std::size_t logBytes;          // lunghezza del log corrente fino all'ultimo gruppo scritto per intero
+    uint64_t generation;           // generazione del log corrente
+    uint64_t firstGeneration;      // generazione del primo log non coperto dall'istantanea
+    std::thread worker;            // thread che scrive l'istantanea
+    uint64_t checkpointGeneration; // generazione dell'istantanea in scrittura
+    bool checkpointSucceeded;      // esito dell'ultima istantanea (letto solo dopo la join del thread)
+
+    /**
+     * @brief Checksum FNV-1a a 32 bit
+     *
+     * @param data sono i byte di cui calcolare il checksum
+     * @param size è il numero di byte
+     * @param h è il valore da cui partire (per calcolare il checksum a pezzi)
+     * @return uint32_t è il checksum
+     */
+    static uint32_t checksum(const char *data, std::size_t size, uint32_t h = 2166136261u)
+    {
+        for (std::size_t i{0}; i < size; ++i)
+        {
+            h = (h ^ (unsigned char)data[i]) * 16777619u;
+        }
+        return h;
+    }
+
+    inline std::string logName(uint64_t gen) const
+    {
+        return path + ".log." + std::to_string(gen);
+    }
+
+    inline std::string snapshotName() const
+    {
+        return path + ".snapshot";
+    }
+
+    /**
+     * @brief Scrive tutti i byte di un buffer, ripetendo le scritture parziali
+     *
+     * @param out è il descrittore del file
+     * @param data sono i byte da scrivere
+     * @param size è il numero di byte
+     * @return true se la scrittura è riuscita
+     */
+    static bool writeAll(int out, const char *data, std::size_t size)
+    {
+        while (size > 0)
+        {
+            ssize_t written{::write(out, data, size)};
+            if (written < 0 && errno != EINTR)
+            {
+                return false;
+            }
+            if (written > 0)
+            {
+                data += written;
+                size -= written;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Legge un file intero
+     *
+     * @param name è il percorso del file
+     * @param data è il contenuto letto
+     * @return true se il file esiste
+     */
+    static bool readFile(const std::string &name, std::vector<char> &data)
+    {
+        int in{::open(name.c_str(), O_RDONLY)};
+        if (in < 0)
+        {
+            if (errno == ENOENT)
+            {
+                return false;
+            }
+            throw LogIOException(name, std::strerror(errno));
+        }
+        data.clear();
+        char chunk[65536];
+        for (;;)
+        {
+            ssize_t got{::read(in, chunk, sizeof(chunk))};
+            if (got < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (got < 0)
+            {
+                int error{errno};
+                ::close(in);
+                throw LogIOException(name, std::strerror(error));
+            }
+            if (got == 0)
+            {
+                break;
+            }
+            data.insert(data.end(), chunk, chunk + got);
+        }
+        ::close(in);
+        return true;
+    }
+
+    /**
+     * @brief Forza su disco la directory che contiene un file, per rendere persistenti creazioni e rinomine
+     *
+     * @param name è il percorso del file
+     */
+    static void syncDirectory(const std::string &name)
+    {
+        std::size_t slash{name.rfind('/')};
+        std::string directory{slash == std::string::npos ? "." : (slash == 0 ? "/" : name.substr(0, slash))};
+        int dir{::open(directory.c_str(), O_RDONLY)};
+        if (dir >= 0)
+        {
+            ::fsync(dir);
+            ::close(dir);
+        }
+    }
+
+    /**
+     * @brief Scrive nel log i record accumulati
+     *
+     * @param durable indica se il log deve essere anche forzato su disco
+     */
+    void flush(bool durable)
+    {
+        if (!pending.empty())
+        {
+            if (!writeAll(fd, pending.data(), pending.size()))
+            {
+                // Una scrittura parziale lascerebbe nel log record già scritti (duplicati dal prossimo flush) o un record
+                // incompleto (che fermerebbe il ripristino): si torna all'ultima lunghezza valida e i record restano nel buffer
+                int error{errno};
+                if (::ftruncate(fd, logBytes) != 0)
+                {
+                    error = errno;
+                }
+                throw LogIOException(logName(generation), std::strerror(error));
+            }
+            logBytes += pending.size();
+            pending.clear();
+        }
+        if (durable && ::fdatasync(fd) != 0)
+        {
+            throw LogIOException(logName(generation), std::strerror(errno));
+        }
+    }
+
+    /**
+     * @brief Accoda un record al buffer
+     *
+     * @param op è il tipo del record (insertRecord o deleteRecord)
+     * @param value è la chiave
+     */
+    void append(char op, const T &value)
+    {
+        std::size_t offset{pending.size()};
+        pending.resize(offset + recordSize);
+        char *record{pending.data() + offset};
+        record[0] = op;
+        std::memcpy(record + 1, &value, sizeof(T));
+        uint32_t sum{checksum(record, 1 + sizeof(T))};
+        std::memcpy(record + 1 + sizeof(T), &sum, sizeof(sum));
+    }
+
+    /**
+     * @brief Conclude una modifica applicando la politica di scrittura
+     * Con syncPolicy::always il record viene scritto e forzato su disco subito; altrimenti solo quando il gruppo è pieno.
+     */
+    inline void commit()
+    {
+        if (policy == syncPolicy::always || pending.size() >= groupBytes)
+        {
+            flush(policy != syncPolicy::never);
+        }
+    }
+
+    /**
+     * @brief Apre in scrittura il log di una generazione, scartando i byte successivi all'ultimo record valido
+     *
+     * @param gen è la generazione del log
+     * @param validBytes è la lunghezza della parte valida (0 per creare un log nuovo)
+     */
+    void openLog(uint64_t gen, std::size_t validBytes)
+    {
+        std::string name{logName(gen)};
+        fd = ::open(name.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0)
+        {
+            throw LogIOException(name, std::strerror(errno));
+        }
+        if (::ftruncate(fd, validBytes < logHeaderSize ? 0 : validBytes) != 0)
+        {
+            throw LogIOException(name, std::strerror(errno));
+        }
+        logBytes = validBytes;
+        if (validBytes < logHeaderSize) // Log nuovo (o creato da un checkpoint interrotto prima di scriverne l'intestazione)
+        {
+            uint32_t header[2]{logMagic, (uint32_t)sizeof(T)};
+            if (!writeAll(fd, (const char *)header, logHeaderSize) || ::fdatasync(fd) != 0)
+            {
+                throw LogIOException(name, std::strerror(errno));
+            }
+            syncDirectory(name);
+            logBytes = logHeaderSize;
+        }
+    }
+
+    /**
+     * @brief Riesegue i record di un log
+     * La lettura si ferma al primo record incompleto o con checksum errato (scrittura interrotta da un crash).
+     *
+     * @param gen è la generazione del log
+     * @return std::size_t è la lunghezza della parte valida del log (0 se il log non esiste)
+     */
+    std::size_t replay(uint64_t gen)
+    {
+        std::vector<char> data;
+        if (!readFile(logName(gen), data) || data.size() < logHeaderSize)
+        {
+            return 0;
+        }
+        uint32_t header[2];
+        std::memcpy(header, data.data(), logHeaderSize);
+        if (header[0] != logMagic || header[1] != sizeof(T))
+        {
+            throw LogIOException(logName(gen), "invalid log header");
+        }
+        std::size_t offset{logHeaderSize};
+        for (; offset + recordSize <= data.size(); offset += recordSize)
+        {
+            const char *record{data.data() + offset};
+            uint32_t sum;
+            std::memcpy(&sum, record + 1 + sizeof(T), sizeof(sum));
+            if (sum != checksum(record, 1 + sizeof(T)) || (record[0] != insertRecord && record[0] != deleteRecord))
+            {
+                break;
+            }
+            T value;
+            std::memcpy(&value, record + 1, sizeof(T));
+            if (record[0] == insertRecord)
+            {
+                bst<T, CMP>::insertValue(value);
+            }
+            else
+            {
+                bst<T, CMP> *node{bst<T, CMP>::find(value)};
+                if (node != nullptr)
+                {
+                    bst<T, CMP>::deleteKey(node);
+                }
+            }
+        }
+        return offset;
+    }
+
+    /**
+     * @brief Carica l'istantanea, se esiste, e legge la generazione del primo log da rieseguire
+     */
+    void loadSnapshot()
+    {
+        std::vector<char> data;
+        if (!readFile(snapshotName(), data))
+        {
+            return;
+        }
+        uint32_t header[2];
+        uint64_t counters[2]; // generazione e numero di chiavi
+        if (data.size() >= snapshotHeaderSize)
+        {
+            std::memcpy(header, data.data(), sizeof(header));
+            std::memcpy(counters, data.data() + sizeof(header), sizeof(counters));
+        }
+        uint32_t sum;
+        if (data.size() < snapshotHeaderSize || header[0] != snapshotMagic || header[1] != sizeof(T) ||
+            data.size() != snapshotHeaderSize + counters[1] * sizeof(T) + sizeof(sum))
+        {
+            throw LogIOException(snapshotName(), "invalid snapshot header");
+        }
+        std::memcpy(&sum, data.data() + data.size() - sizeof(sum), sizeof(sum));
+        if (sum != checksum(data.data(), data.size() - sizeof(sum)))
+        {
+            throw LogIOException(snapshotName(), "invalid snapshot checksum");
+        }
+        std::vector<T> keys(counters[1]);
+        std::memcpy((void *)keys.data(), data.data() + snapshotHeaderSize, keys.size() * sizeof(T));
+        this->insertSorted(keys.data(), keys.data() + keys.size()); // Albero bilanciato in O(n)
+        firstGeneration = counters[0];
+    }
+
+    /**
+     * @brief Scrive un'istantanea e, se la scrittura riesce, elimina i log che la precedono
+     * L'istantanea viene scritta in un file temporaneo e poi rinominata, quindi un crash lascia sempre un'istantanea completa.
+     *
+     * @param keys sono le chiavi dell'albero in ordine crescente
+     * @param gen è la generazione del primo log successivo all'istantanea
+     * @param oldest è la generazione del primo log coperto dall'istantanea precedente
+     * @return true se l'istantanea è stata scritta
+     */
+    bool writeSnapshot(const std::vector<T> &keys, uint64_t gen, uint64_t oldest) const
+    {
+        std::string temporary{snapshotName() + ".tmp"};
+        char header[snapshotHeaderSize];
+        uint32_t magic[2]{snapshotMagic, (uint32_t)sizeof(T)};
+        uint64_t counters[2]{gen, keys.size()};
+        std::memcpy(header, magic, sizeof(magic));
+        std::memcpy(header + sizeof(magic), counters, sizeof(counters));
+        const char *payload{(const char *)keys.data()};
+        uint32_t sum{checksum(payload, keys.size() * sizeof(T), checksum(header, snapshotHeaderSize))};
+
+        int out{::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)};
+        if (out < 0)
+        {
+            return false;
+        }
+        bool written{writeAll(out, header, snapshotHeaderSize) && writeAll(out, payload, keys.size() * sizeof(T)) &&
+                     writeAll(out, (const char *)&sum, sizeof(sum)) && ::fsync(out) == 0};
+        ::close(out);
+        if (!written || ::rename(temporary.c_str(), snapshotName().c_str()) != 0)
+        {
+            ::unlink(temporary.c_str());
+            return false;
+        }
+        syncDirectory(snapshotName());
+        for (uint64_t old{oldest}; old < gen; ++old) // In ordine crescente: i log rimasti dopo un crash sono gli ultimi
+        {
+            ::unlink(logName(old).c_str());
+        }
+        return true;
+    }
+
+public:
+    using typename bst<T, CMP>::const_iterator;
+    using bst<T, CMP>::operator new;
+    using bst<T, CMP>::operator delete;
+    using bst<T, CMP>::getKey;
+    using bst<T, CMP>::getCount;
+    using bst<T, CMP>::isEmpty;
+    using bst<T, CMP>::findFrom;
+    using bst<T, CMP>::isPresent;
+    using bst<T, CMP>::nodesCount;
+    using bst<T, CMP>::leavesCount;
+    using bst<T, CMP>::height;
+    using bst<T, CMP>::inorder;
+    using bst<T, CMP>::preorder;
+    using bst<T, CMP>::postorder;
+    using bst<T, CMP>::rebalance;
+    using bst<T, CMP>::relayout;
+    using bst<T, CMP>::compact;
+    using bst<T, CMP>::begin;
+    using bst<T, CMP>::end;
+
+    /**
+     * @brief Costruttore che ricostruisce l'albero dai file del log
+     * Se i file non esistono l'albero è vuoto e viene creato il log della generazione 0.
+     *
+     * @param inputPath è il prefisso dei file del log e dell'istantanea
+     * @param inputPolicy è la politica di scrittura su disco
+     * @param inputGroupBytes è la dimensione in byte di un gruppo di record
+     */
+    loggedBst(const std::string &inputPath, syncPolicy inputPolicy = syncPolicy::group, std::size_t inputGroupBytes = 65536)
+        : bst<T, CMP>(), path{inputPath}, policy{inputPolicy}, groupBytes{inputGroupBytes}, fd{-1}, logBytes{0}, generation{0},
+          firstGeneration{0}, checkpointGeneration{0}, checkpointSucceeded{false}
+    {
+        pending.reserve(groupBytes + recordSize);
+        ::unlink((snapshotName() + ".tmp").c_str()); // Istantanea di un checkpoint interrotto
+        loadSnapshot();
+        for (uint64_t old{firstGeneration}; old > 0 && ::unlink(logName(old - 1).c_str()) == 0; --old) // Log già coperti dall'istantanea
+        {
+        }
+        generation = firstGeneration;
+        std::size_t validBytes{replay(generation)};
+        while (::access(logName(generation + 1).c_str(), F_OK) == 0)
+        {
+            ++generation;
+            validBytes = replay(generation);
+        }
+        openLog(generation, validBytes);
+    }
+
+    loggedBst(const loggedBst<T, CMP> &) = delete;
+    loggedBst<T, CMP> &operator=(const loggedBst<T, CMP> &) = delete;
+
+    /**
+     * @brief Restituisce il sottoalbero sinistro
+     * I nodi sono restituiti costanti: una modifica fatta attraverso di essi non verrebbe registrata nel log.
+     *
+     * @return puntatore costante al nodo figlio sinistro
+     */
+    inline const bst<T, CMP> *getLeft() const
+    {
+        return bst<T, CMP>::getLeft();
+    }
+
+    /**
+     * @brief Restituisce il sottoalbero destro
+     *
+     * @return puntatore costante al nodo figlio destro
+     */
+    inline const bst<T, CMP> *getRight() const
+    {
+        return bst<T, CMP>::getRight();
+    }
+
+    /**
+     * @brief Restituisce il nodo con la chiave più piccola
+     *
+     * @return puntatore costante al nodo con valore minimo
+     */
+    inline const bst<T, CMP> *min()
+    {
+        return bst<T, CMP>::min();
+    }
+
+    /**
+     * @brief Restituisce il nodo con la chiave più grande
+     *
+     * @return puntatore costante al nodo con valore massimo
+     */
+    inline const bst<T, CMP> *max()
+    {
+        return bst<T, CMP>::max();
+    }
+
+    /**
+     * @brief Ricerca iterativa di una chiave
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore costante al nodo con la chiave o nullptr se non è presente
+     */
+    inline const bst<T, CMP> *find(const T &value) const
+    {
+        return bst<T, CMP>::find(value);
+    }
+
+    /**
+     * @brief Ricerca di una chiave che lancia un'eccezione se non è presente
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore costante al nodo con la chiave
+     */
+    inline const bst<T, CMP> *binarySearch(const T &value)
+    {
+        return bst<T, CMP>::binarySearch(value);
+    }
+
+    /**
+     * @brief Distruttore: attende l'eventuale checkpoint e scrive i record rimasti nel buffer
+     */
+    ~loggedBst()
+    {
+        waitCheckpoint();
+        if (fd >= 0)
+        {
+            try
+            {
+                flush(policy != syncPolicy::never);
+            }
+            catch (const LogIOException &) // Un distruttore non può lanciare eccezioni: i record non scritti vanno persi
+            {
+            }
+            ::close(fd);
+        }
+    }
+
+    /**
+     * @brief Registra e inserisce un valore nell'albero
+     *
+     * @param value è il valore da inserire
+     * @return loggedBst& è l'albero stesso, così gli inserimenti concatenati passano tutti dal log
+     */
+    loggedBst<T, CMP> &insertValue(const T &value)
+    {
+        append(insertRecord, value);
+        bst<T, CMP>::insertValue(value);
+        commit();
+        return *this;
+    }
+
+    /**
+     * @brief Registra ed elimina il nodo associato a una chiave
+     * Se la chiave non è presente viene lanciata un'eccezione e non viene registrato nulla.
+     *
+     * @param value chiave corrispondente al nodo da eliminare
+     */
+    void deleteKey(const T &value)
+    {
+        bst<T, CMP> *node{bst<T, CMP>::find(value)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        append(deleteRecord, value);
+        bst<T, CMP>::deleteKey(node);
+        commit();
+    }
+
+    /**
+     * @brief Registra ed elimina il sottoalbero con radice node
+     * Nel log viene scritta la cancellazione di ogni chiave del sottoalbero. Se node è la radice l'albero diventa vuoto.
+     *
+     * @param node è la radice del sottoalbero da eliminare
+     */
+    void remove(const bst<T, CMP> *node)
+    {
+        std::vector<const bst<T, CMP> *> stack{node};
+        while (!stack.empty())
+        {
+            const bst<T, CMP> *current{stack.back()};
+            stack.pop_back();
+            for (uint i{0}; i < current->count; ++i)
+            {
+                append(deleteRecord, current->key);
+            }
+            for (const bst<T, CMP> *child : {current->left, current->right})
+            {
+                if (child != nullptr)
+                {
+                    stack.push_back(child);
+                }
+            }
+        }
+        if (node == this) // La radice non può essere deallocata: si eliminano i figli e la si svuota
+        {
+            if (this->left != nullptr)
+            {
+                this->left->remove();
+            }
+            if (this->right != nullptr)
+            {
+                this->right->remove();
+            }
+            this->empty = true;
+            this->count = 0;
+        }
+        else
+        {
+            const_cast<bst<T, CMP> *>(node)->remove(); // Il nodo appartiene a questo albero, di cui si ha accesso in scrittura
+        }
+        commit();
+    }
+
+    /**
+     * @brief Scrive nel log i record accumulati e lo forza su disco, qualunque sia la politica
+     * Al ritorno tutte le modifiche precedenti sopravvivono a un crash.
+     */
+    void sync()
+    {
+        flush(true);
+    }
+
+    /**
+     * @brief Avvia un checkpoint
+     * Il log corrente viene chiuso e se ne apre uno di una nuova generazione; le chiavi vengono copiate e un thread
+     * separato le scrive in una nuova istantanea ed elimina i log precedenti, mentre l'albero continua a essere modificato.
+     * Se un checkpoint precedente è ancora in corso lo si attende.
+     */
+    void checkpoint()
+    {
+        waitCheckpoint();
+        flush(true);
+        ::close(fd);
+        fd = -1;
+        openLog(generation + 1, 0);
+        ++generation;
+
+        std::vector<T> keys;
+        if (!this->isEmpty())
+        {
+            for (bst<T, CMP> *node{bst<T, CMP>::min()}; node != nullptr; node = bst<T, CMP>::nextNode(node))
+            {
+                keys.insert(keys.end(), node->count, node->key);
+            }
+        }
+        checkpointGeneration = generation;
+        worker = std::thread([this, snapshot{std::move(keys)}, gen{generation}, oldest{firstGeneration}]()
+                             { checkpointSucceeded = writeSnapshot(snapshot, gen, oldest); });
+    }
+
+    /**
+     * @brief Attende la fine dell'eventuale checkpoint in corso
+     * Se la scrittura dell'istantanea non è riuscita i log precedenti vengono conservati e saranno eliminati dal prossimo checkpoint.
+     *
+     * @return true se non c'era un checkpoint in corso o se è terminato correttamente
+     * @return false se la scrittura dell'istantanea non è riuscita
+     */
+    bool waitCheckpoint()
+    {
+        if (!worker.joinable())
+        {
+            return true;
+        }
+        worker.join();
+        if (checkpointSucceeded)
+        {
+            firstGeneration = checkpointGeneration;
+        }
+        return checkpointSucceeded;
+    }
+
+    /**
+     * @brief Restituisce la generazione del log corrente
+     *
+     * @return uint64_t è la generazione (incrementata da ogni checkpoint)
+     */
+    inline uint64_t logGeneration() const
+    {
+        return generation;
+    }
+};
+
+#endif
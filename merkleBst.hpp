@@ -0,0 +1,185 @@
+#ifndef __merkleBst_hpp__
+#define __merkleBst_hpp__
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "bst.hpp"
+
+/**
+ * @class merkleBst
+ *
+ * @brief Albero binario di ricerca in cui ogni nodo memorizza l'hash delle chiavi del proprio sottoalbero.
+ * Gli hash vengono aggiornati incrementalmente da inserimenti, cancellazioni e rotazioni (vedi subtreeHash), quindi
+ * rootHash() permette di verificare in O(1) se due repliche contengono le stesse chiavi e diff() trova le differenze
+ * confrontando gli hash di intervalli di chiavi: gli intervalli con lo stesso hash vengono saltati senza visitarli.
+ * L'hash è una somma di hash a 64 bit: due insiemi diversi hanno lo stesso hash con probabilità trascurabile,
+ * ma non è una protezione contro collisioni costruite di proposito.
+ *
+ * @tparam T è il tipo di dato delle chiavi associate ai nodi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ * @tparam HASH è la funzione hash del tipo T (chiavi equivalenti secondo CMP devono avere lo stesso hash)
+ */
+template <typename T, typename CMP = std::greater<T>, typename HASH = std::hash<T>>
+class merkleBst : public bst<T, CMP, subtreeHash<T, HASH>>
+{
+private:
+    using node_type = bst<T, CMP, subtreeHash<T, HASH>>;
+
+    /**
+     * @brief Primo nodo incontrato scendendo dalla radice con chiave strettamente compresa tra gli estremi
+     *
+     * @tparam LOW è il tipo del predicato "chiave maggiore dell'estremo sinistro"
+     * @tparam HIGH è il tipo del predicato "chiave minore dell'estremo destro"
+     * @param node è la radice del sottoalbero (può essere nullptr)
+     * @param aboveLow è il predicato per l'estremo sinistro
+     * @param belowHigh è il predicato per l'estremo destro
+     * @return puntatore al nodo trovato o nullptr se nessuna chiave è compresa tra gli estremi
+     */
+    template <typename LOW, typename HIGH>
+    static const node_type *splitNode(const node_type *node, LOW &aboveLow, HIGH &belowHigh)
+    {
+        while (node != nullptr)
+        {
+            if (!aboveLow(node->key))
+            {
+                node = node->right;
+            }
+            else if (!belowHigh(node->key))
+            {
+                node = node->left;
+            }
+            else
+            {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Numero di occorrenze di una chiave nel sottoalbero con radice node
+     *
+     * @param node è la radice del sottoalbero (può essere nullptr)
+     * @param value è la chiave da contare
+     * @return numero di occorrenze di value
+     */
+    static std::size_t occurrences(const node_type *node, const T &value)
+    {
+        std::size_t found{0};
+        while (node != nullptr)
+        {
+            if (node->cmp(value, node->key))
+            {
+                node = node->right;
+            }
+            else if (node->cmp(node->key, value))
+            {
+                node = node->left;
+            }
+            else // Dopo le rotazioni i duplicati possono trovarsi in entrambi i sottoalberi
+            {
+                return found + node->count + occurrences(node->left, value) + occurrences(node->right, value);
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief Confronta le chiavi di due alberi strettamente comprese tra due estremi
+     * Se gli hash dei due intervalli coincidono l'intervallo viene saltato; altrimenti lo si divide in corrispondenza
+     * della chiave più vicina alla radice e si confrontano le occorrenze di tale chiave. Gli hash degli intervalli
+     * arrivano dalla chiamata precedente: per ogni divisione si calcola con aggregateRange() solo l'hash della parte
+     * sinistra, mentre quello della parte destra si ottiene per differenza (l'hash è una somma). Tutte le chiavi
+     * dell'intervallo si trovano nel sottoalbero del primo nodo compreso tra gli estremi, quindi le discese partono
+     * da quel nodo invece che dalla radice.
+     *
+     * @param a è il nodo del primo albero sotto cui si trovano le chiavi dell'intervallo (nullptr se nessuna)
+     * @param b è il nodo del secondo albero sotto cui si trovano le chiavi dell'intervallo (nullptr se nessuna)
+     * @param low è l'estremo sinistro escluso (nullptr se illimitato)
+     * @param high è l'estremo destro escluso (nullptr se illimitato)
+     * @param hashA è l'hash delle chiavi del primo albero nell'intervallo
+     * @param hashB è l'hash delle chiavi del secondo albero nell'intervallo
+     * @param result sono le chiavi presenti solo nel primo e solo nel secondo albero
+     */
+    static void diffRange(const node_type *a, const node_type *b, const T *low, const T *high, uint64_t hashA, uint64_t hashB,
+                          std::pair<std::vector<T>, std::vector<T>> &result)
+    {
+        if (hashA == hashB)
+        {
+            return;
+        }
+        CMP cmp;
+        auto aboveLow{[&](const T &k)
+                      { return low == nullptr || cmp(k, *low); }};
+        auto belowHigh{[&](const T &k)
+                       { return high == nullptr || cmp(*high, k); }};
+        a = splitNode(a, aboveLow, belowHigh);
+        b = splitNode(b, aboveLow, belowHigh);
+        const T pivot{(a != nullptr ? a : b)->key};
+        auto belowPivot{[&](const T &k)
+                        { return cmp(pivot, k); }};
+        uint64_t leftA{node_type::aggregateRange(a, false, false, aboveLow, belowPivot)};
+        uint64_t leftB{node_type::aggregateRange(b, false, false, aboveLow, belowPivot)};
+        std::size_t inA{occurrences(a, pivot)};
+        std::size_t inB{occurrences(b, pivot)};
+        uint64_t rightA{hashA - leftA - subtreeHash<T, HASH>::lift(pivot, inA)};
+        uint64_t rightB{hashB - leftB - subtreeHash<T, HASH>::lift(pivot, inB)};
+        diffRange(a, b, low, &pivot, leftA, leftB, result);
+        for (; inA > inB; --inA)
+        {
+            result.first.push_back(pivot);
+        }
+        for (; inB > inA; --inB)
+        {
+            result.second.push_back(pivot);
+        }
+        diffRange(a, b, &pivot, high, rightA, rightB, result);
+    }
+
+public:
+    /**
+     * @brief Costruttore vuoto
+     */
+    merkleBst() : node_type() {}
+
+    /**
+     * @brief Costruttore per convertire un array in un albero
+     *
+     * @param array che si vuole convertire nell'albero binario di ricerca
+     * @param length è la lunghezza dell'array
+     */
+    merkleBst(const T array[], uint length) : node_type(array, length) {}
+
+    /**
+     * @brief Hash di tutte le chiavi dell'albero
+     *
+     * @return uint64_t è l'hash (0 se l'albero è vuoto); due alberi con le stesse chiavi hanno lo stesso hash
+     */
+    inline uint64_t rootHash() const
+    {
+        return this->isEmpty() ? 0 : this->aug;
+    }
+
+    /**
+     * @brief Differenze tra le chiavi di due alberi
+     * Il costo è proporzionale al numero d di differenze invece che al numero di chiavi, ma non raggiunge O(d·log n):
+     * le due repliche hanno in generale forme diverse, quindi a ogni divisione l'hash di un intervallo va calcolato in
+     * entrambi gli alberi con una discesa O(h), e ogni differenza richiede fino a h divisioni. Il caso peggiore è quindi
+     * O(d·h²) (O(d·log² n) con alberi bilanciati), contro O(n) per una visita completa.
+     * Le chiavi duplicate compaiono tante volte quante sono le occorrenze in eccesso.
+     *
+     * @param a è il primo albero
+     * @param b è il secondo albero
+     * @return std::pair<std::vector<T>, std::vector<T>> sono le chiavi presenti solo in a e solo in b, in ordine crescente
+     */
+    static std::pair<std::vector<T>, std::vector<T>> diff(const merkleBst<T, CMP, HASH> &a, const merkleBst<T, CMP, HASH> &b)
+    {
+        std::pair<std::vector<T>, std::vector<T>> result;
+        diffRange(a.isEmpty() ? nullptr : &a, b.isEmpty() ? nullptr : &b, nullptr, nullptr, a.rootHash(), b.rootHash(), result);
+        return result;
+    }
+};
+
+#endif
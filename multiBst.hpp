@@ -0,0 +1,345 @@
+#ifndef __multiBst_hpp__
+#define __multiBst_hpp__
+
+#include "bst.hpp"
+
+/**
+ * @class multiBst
+ *
+ * @brief Albero binario di ricerca in modalità multiset.
+ * Le chiavi duplicate non generano nuovi nodi: ogni nodo memorizza una chiave distinta insieme al numero
+ * delle sue occorrenze. In questo modo l'altezza dell'albero e la memoria occupata dipendono solo dal
+ * numero di chiavi distinte e non dal numero di ripetizioni.
+ *
+ * Due chiavi sono considerate uguali se sono equivalenti secondo la relazione d'ordine CMP
+ * (per esempio due città con la stessa popolazione).
+ *
+ * L'ereditarietà da bst è privata: gli inserimenti di bst che non passano da insertValue() (insertBatch, inserimento con
+ * hint, join) creerebbero un secondo nodo per una chiave già presente, quindi non sono disponibili, e per lo stesso motivo
+ * i nodi restituiti sono costanti. Le cancellazioni di intervalli (eraseRange, erase, eraseIf) restano disponibili.
+ *
+ * @tparam T è il tipo di dato delle chiavi associate ai nodi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ */
+template <typename T, typename CMP = std::greater<T>>
+class multiBst : private bst<T, CMP>
+{
+public:
+    using typename bst<T, CMP>::const_iterator;
+    using bst<T, CMP>::operator new;
+    using bst<T, CMP>::operator delete;
+    using bst<T, CMP>::getKey;
+    using bst<T, CMP>::getCount;
+    using bst<T, CMP>::isEmpty;
+    using bst<T, CMP>::findFrom;
+    using bst<T, CMP>::isPresent;
+    using bst<T, CMP>::nodesCount;
+    using bst<T, CMP>::leavesCount;
+    using bst<T, CMP>::height;
+    using bst<T, CMP>::inorder;
+    using bst<T, CMP>::preorder;
+    using bst<T, CMP>::postorder;
+    using bst<T, CMP>::eraseRange;
+    using bst<T, CMP>::erase;
+    using bst<T, CMP>::eraseIf;
+    using bst<T, CMP>::rebalance;
+    using bst<T, CMP>::relayout;
+    using bst<T, CMP>::compact;
+    using bst<T, CMP>::begin;
+    using bst<T, CMP>::end;
+    using bst<T, CMP>::cend;
+
+    /**
+     * @brief Iteratore costante che espande i duplicati
+     *
+     * Una chiave con molteplicità k viene restituita k volte consecutive. Per visitare ogni chiave distinta
+     * una sola volta (duplicati compressi) si utilizza il const_iterator di bst e il metodo getCount() del nodo.
+     */
+    class expanded_iterator
+    {
+    private:
+        const bst<T, CMP> *ptr; // puntatore al nodo corrente (nullptr dopo l'ultimo elemento)
+        uint repeat;            // indice dell'occorrenza corrente della chiave del nodo
+
+        /**
+         * @brief Costruttore privato
+         *
+         * @param inputPtr è il puntatore al nodo da associare all'iteratore
+         */
+        expanded_iterator(const bst<T, CMP> *inputPtr) : ptr{inputPtr}, repeat{0} {}
+
+    public:
+        using iterator_category = std::forward_iterator_tag; // categoria di iteratore
+        using difference_type = std::ptrdiff_t;              // il tipo della differenza tra iteratori
+        using value_type = T;                                // il valore trattato dall'iteratore
+        using pointer = const value_type *;                  // il tipo puntatore
+        using reference = const value_type &;                // il tipo riferimento
+
+        /**
+         * @brief Costruttore vuoto pubblico
+         */
+        expanded_iterator() : ptr{nullptr}, repeat{0} {}
+
+        /**
+         * @brief Operatore di incremento prefisso
+         * Si passa al nodo successivo solo dopo aver restituito tutte le occorrenze della chiave corrente
+         *
+         * @return expanded_iterator& restituisce il riferimento al successivo elemento
+         */
+        expanded_iterator &operator++()
+        {
+            if (++repeat >= ptr->getCount())
+            {
+                ptr = multiBst<T, CMP>::nextNode(ptr);
+                repeat = 0;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Operatore di incremento postfisso
+         *
+         * @return expanded_iterator è una copia dell'iteratore precedente all'incremento
+         */
+        expanded_iterator operator++(int)
+        {
+            expanded_iterator current{*this}; // copia dell'iteratore corrente
+            ++(*this);
+            return current;
+        }
+
+        inline reference operator*() const
+        {
+            return ptr->getKey();
+        }
+
+        inline pointer operator->() const
+        {
+            return &(ptr->getKey());
+        }
+
+        inline bool operator==(const expanded_iterator &it) const
+        {
+            return ptr == it.ptr && repeat == it.repeat;
+        }
+
+        inline bool operator!=(const expanded_iterator &it) const
+        {
+            return !(*this == it);
+        }
+
+        friend class multiBst<T, CMP>;
+    };
+
+    /**
+     * @brief Costruttore vuoto
+     */
+    multiBst() : bst<T, CMP>() {}
+
+    /**
+     * @brief Costruttore con passaggio della chiave della radice
+     *
+     * @param inputKey è il riferimento al valore del nodo
+     */
+    multiBst(const T &inputKey) : bst<T, CMP>(inputKey) {}
+
+    /**
+     * @brief Costruttore per convertire un array in un multiset
+     *
+     * @param array che si vuole convertire nell'albero binario di ricerca
+     * @param length è la lunghezza dell'array
+     */
+    multiBst(const T array[], uint length) : bst<T, CMP>()
+    {
+        for (u_int i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    /**
+     * @brief Restituisce il sottoalbero sinistro
+     *
+     * @return puntatore costante al nodo figlio sinistro
+     */
+    inline const bst<T, CMP> *getLeft() const
+    {
+        return bst<T, CMP>::getLeft();
+    }
+
+    /**
+     * @brief Restituisce il sottoalbero destro
+     *
+     * @return puntatore costante al nodo figlio destro
+     */
+    inline const bst<T, CMP> *getRight() const
+    {
+        return bst<T, CMP>::getRight();
+    }
+
+    /**
+     * @brief Restituisce il nodo con la chiave più piccola
+     *
+     * @return puntatore costante al nodo con valore minimo
+     */
+    inline const bst<T, CMP> *min()
+    {
+        return bst<T, CMP>::min();
+    }
+
+    /**
+     * @brief Restituisce il nodo con la chiave più grande
+     *
+     * @return puntatore costante al nodo con valore massimo
+     */
+    inline const bst<T, CMP> *max()
+    {
+        return bst<T, CMP>::max();
+    }
+
+    /**
+     * @brief Ricerca iterativa di una chiave
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore costante al nodo con la chiave o nullptr se non è presente
+     */
+    inline const bst<T, CMP> *find(const T &value) const
+    {
+        return bst<T, CMP>::find(value);
+    }
+
+    /**
+     * @brief Ricerca di una chiave che lancia un'eccezione se non è presente
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore costante al nodo con la chiave
+     */
+    inline const bst<T, CMP> *binarySearch(const T &value)
+    {
+        return bst<T, CMP>::binarySearch(value);
+    }
+
+    /**
+     * @brief Inserisce un valore nel multiset
+     * Con una sola discesa dalla radice: se la chiave è già presente viene solo incrementato il contatore delle
+     * occorrenze del nodo, altrimenti il nuovo nodo viene attaccato dove la discesa si è fermata.
+     *
+     * @param value è il valore da inserire
+     * @return multiBst& è l'albero stesso
+     */
+    multiBst<T, CMP> &insertValue(const T &value)
+    {
+        if (bst<T, CMP>::isEmpty())
+        {
+            this->insertNode(value);
+            return *this;
+        }
+        bst<T, CMP> *node{this};
+        while (true)
+        {
+            bst<T, CMP> **child;
+            if (node->cmp(value, node->key)) // I valori maggiori si trovano a destra
+            {
+                child = &node->right;
+            }
+            else if (node->cmp(node->key, value)) // I valori minori si trovano a sinistra
+            {
+                child = &node->left;
+            }
+            else // La chiave è già presente: nessun nuovo nodo
+            {
+                ++node->count;
+                return *this;
+            }
+            if (*child == nullptr)
+            {
+                *child = new bst<T, CMP>(value);
+                (*child)->parent = node;
+                bst<T, CMP>::fixUpward(node);
+                return *this;
+            }
+            node = *child;
+        }
+    }
+
+    /**
+     * @brief Elimina un'occorrenza della chiave fornita
+     * Il nodo viene eliminato dall'albero solo quando si rimuove la sua ultima occorrenza.
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave di cui eliminare un'occorrenza
+     */
+    void deleteKey(const T &value)
+    {
+        bst<T, CMP> *node{bst<T, CMP>::find(value)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        if (node->count > 1)
+        {
+            --node->count;
+        }
+        else
+        {
+            bst<T, CMP>::deleteKey(node); // Il nodo è già noto: nessuna seconda ricerca
+        }
+    }
+
+    /**
+     * @brief Restituisce il numero di occorrenze di una chiave
+     *
+     * @param value è la chiave da cercare
+     * @return naturale che rappresenta la molteplicità della chiave (0 se non è presente)
+     */
+    uint count(const T &value) const
+    {
+        const bst<T, CMP> *node{this->find(value)};
+        return node == nullptr ? 0 : node->getCount();
+    }
+
+    /**
+     * @brief Restituisce il numero totale di elementi del multiset (duplicati compresi)
+     *
+     * @return naturale che rappresenta la somma delle molteplicità delle chiavi
+     */
+    u_int size() const
+    {
+        u_int total{0};
+        if (!this->isEmpty())
+        {
+            const bst<T, CMP> *node{this};
+            while (node->left != nullptr)
+            {
+                node = node->left;
+            }
+            for (; node != nullptr; node = bst<T, CMP>::nextNode(node))
+            {
+                total += node->getCount();
+            }
+        }
+        return total;
+    }
+
+    /**
+     * @brief Iteratore al primo elemento con i duplicati espansi
+     *
+     * @return expanded_iterator corrispondente alla prima occorrenza della chiave minima
+     */
+    inline expanded_iterator beginExpanded()
+    {
+        return this->isEmpty() ? expanded_iterator{} : expanded_iterator{this->min()};
+    }
+
+    /**
+     * @brief Iteratore successivo all'ultimo elemento con i duplicati espansi
+     *
+     * @return expanded_iterator che indica la fine della visita
+     */
+    inline expanded_iterator endExpanded()
+    {
+        return expanded_iterator{};
+    }
+};
+
+#endif
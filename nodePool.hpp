@@ -0,0 +1,325 @@
+#ifndef __nodePool_hpp__
+#define __nodePool_hpp__
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Allocatore a blocchi per i nodi di dimensione fissa
+ *
+ * I nodi vengono ricavati da blocchi contigui di memoria (chunk) di dimensione crescente e i nodi liberati
+ * vengono riutilizzati tramite una lista libera. Nodi allocati uno dopo l'altro risultano quindi adiacenti
+ * in memoria e gli indirizzi di un chunk sono crescenti nell'ordine di allocazione.
+ *
+ * Esiste un'unica istanza per ogni dimensione di nodo. L'istanza non viene mai distrutta, in modo che anche
+ * gli alberi distrutti durante la terminazione del programma possano restituire i loro nodi. La memoria non resta però
+ * occupata per sempre: ogni chunk ha la propria lista libera e il numero dei suoi nodi liberi, e un chunk i cui nodi
+ * sono tutti tornati nella lista condivisa viene restituito al sistema, purché gli altri chunk abbiano almeno tanti
+ * nodi liberi quanti ne contiene (così alternare inserimenti e cancellazioni al confine di un chunk non lo alloca e
+ * libera a ogni operazione).
+ *
+ * L'allocatore può essere usato da più thread: ogni thread preleva e restituisce i nodi in una piccola lista locale,
+ * che scambia con la lista libera condivisa (protetta da un mutex) a blocchi di batchSlots nodi. Il mutex viene quindi
+ * acquisito una volta ogni batchSlots allocazioni e i thread che inseriscono in alberi diversi non si contendono la memoria.
+ * Nella lista condivisa ogni nodo restituito viene assegnato al suo chunk con una ricerca binaria sugli indirizzi (O(log C)
+ * per C chunk) e i nodi vengono prelevati dai chunk con gli indirizzi più bassi.
+ * I nodi trattenuti nelle liste locali impedirebbero il rilascio dei loro chunk, quindi quando più di metà dei nodi
+ * riservati (oltre i primi maxChunkSlots) è libera l'allocatore passa in modalità di rilascio: le liste locali vengono
+ * svuotate e ogni nodo viene prelevato e restituito direttamente nella lista condivisa, al costo di acquisire il mutex a
+ * ogni operazione, finché la memoria libera non torna sotto la metà. Un thread che non alloca né libera nodi trattiene
+ * al più 2·batchSlots nodi.
+ * Quando un thread termina la sua lista locale viene restituita alla lista condivisa, quindi i thread di breve durata
+ * (come quelli di insertBatch) non abbandonano nodi liberi.
+ *
+ * @tparam SIZE è la dimensione in byte di un nodo
+ * @tparam ALIGN è l'allineamento richiesto da un nodo
+ */
+template <std::size_t SIZE, std::size_t ALIGN>
+class nodePool
+{
+private:
+    /**
+     * @brief Elemento di un chunk: contiene un nodo oppure il puntatore al successivo elemento libero
+     */
+    union slot
+    {
+        slot *next;
+        alignas(ALIGN) unsigned char storage[SIZE];
+    };
+
+    /**
+     * @brief Blocco contiguo di nodi con la propria lista libera
+     */
+    struct chunk
+    {
+        slot *first;          // primo elemento del blocco
+        std::size_t slots;    // numero di elementi del blocco
+        slot *freeList;       // primo elemento libero del blocco nella lista condivisa
+        std::size_t freeSize; // numero di elementi del blocco nella lista condivisa
+    };
+
+    /**
+     * @brief Lista libera locale di un thread
+     */
+    struct cache
+    {
+        slot *head;       // primo elemento libero
+        std::size_t size; // numero di elementi liberi
+        bool closed;      // true dopo la terminazione del thread: i nodi passano direttamente per la lista condivisa
+    };
+
+    /**
+     * @brief Oggetto locale a ogni thread il cui distruttore restituisce la lista locale alla lista condivisa
+     * La lista locale resta un oggetto senza distruttore, quindi gli alberi distrutti dopo questo oggetto (per esempio
+     * quelli globali durante la terminazione del programma) possono ancora restituire i loro nodi.
+     */
+    struct releaser
+    {
+        ~releaser()
+        {
+            cache &nodes{local()};
+            instance().release(nodes);
+            nodes.closed = true;
+        }
+    };
+
+    static const std::size_t maxChunkSlots{1 << 16}; // numero massimo di nodi in un chunk
+    static const std::size_t batchSlots{64};         // numero di nodi scambiati tra lista locale e lista condivisa
+
+    std::vector<chunk> chunks; // blocchi di memoria allocati in ordine di indirizzo, con la lista condivisa
+    std::size_t firstFree;     // nessun chunk prima di questo indice ha elementi nella lista condivisa
+    std::size_t freeSlots;     // numero di elementi nella lista condivisa
+    std::size_t reserved;      // numero di elementi dei chunk allocati
+    std::size_t chunkSlots;    // numero di nodi del prossimo chunk
+    std::atomic<bool> direct;  // true in modalità di rilascio: i nodi non passano per le liste locali
+    std::mutex lock;           // protegge chunks e la lista condivisa
+
+    nodePool() : firstFree{0}, freeSlots{0}, reserved{0}, chunkSlots{64}, direct{false} {}
+
+    /**
+     * @brief Entra o esce dalla modalità di rilascio a seconda della frazione di nodi liberi
+     * Va chiamato con il mutex acquisito.
+     */
+    void updateMode()
+    {
+        direct.store(reserved > maxChunkSlots && 2 * freeSlots > reserved, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Inserisce un elemento nella lista condivisa del suo chunk e restituisce il chunk se è diventato libero
+     * Va chiamato con il mutex acquisito.
+     *
+     * @param s è l'elemento da restituire
+     */
+    void giveBack(slot *s)
+    {
+        std::size_t i{std::size_t(std::upper_bound(chunks.begin(), chunks.end(), s, [](slot *p, const chunk &c)
+                                                   { return std::less<slot *>()(p, c.first); }) -
+                                  chunks.begin()) -
+                      1};
+        chunk &owner{chunks[i]};
+        s->next = owner.freeList;
+        owner.freeList = s;
+        ++owner.freeSize;
+        ++freeSlots;
+        firstFree = std::min(firstFree, i);
+        if (owner.freeSize == owner.slots && freeSlots - owner.freeSize >= owner.slots) // Chunk libero e memoria libera sufficiente negli altri
+        {
+            freeSlots -= owner.slots;
+            reserved -= owner.slots;
+            ::operator delete(owner.first, std::align_val_t{alignof(slot)});
+            chunks.erase(chunks.begin() + i);
+            firstFree = std::min(firstFree, chunks.size());
+        }
+    }
+
+    /**
+     * @brief Restituisce la lista libera locale del thread corrente
+     * Al primo uso in un thread registra il releaser che alla terminazione del thread restituisce la lista locale.
+     *
+     * @return cache& è il riferimento alla lista locale
+     */
+    static cache &local()
+    {
+        static thread_local cache nodes{nullptr, 0, false};
+        static thread_local releaser guard;
+        (void)guard;
+        return nodes;
+    }
+
+    /**
+     * @brief Restituisce alla lista condivisa tutti gli elementi della lista locale
+     *
+     * @param nodes è la lista locale
+     */
+    void release(cache &nodes)
+    {
+        std::lock_guard<std::mutex> guard{lock};
+        while (nodes.head != nullptr)
+        {
+            slot *s{nodes.head};
+            nodes.head = s->next;
+            giveBack(s);
+        }
+        nodes.size = 0;
+        updateMode();
+    }
+
+    /**
+     * @brief Sposta nella lista locale alcuni elementi della lista condivisa, dai chunk con gli indirizzi più bassi
+     *
+     * @param nodes è la lista locale (vuota)
+     * @param count è il numero massimo di elementi da spostare
+     */
+    void refill(cache &nodes, std::size_t count)
+    {
+        std::lock_guard<std::mutex> guard{lock};
+        if (freeSlots == 0)
+        {
+            grow();
+        }
+        slot **tail{&nodes.head};
+        std::size_t taken{0};
+        while (taken < count && freeSlots > 0)
+        {
+            while (chunks[firstFree].freeSize == 0)
+            {
+                ++firstFree;
+            }
+            chunk &source{chunks[firstFree]};
+            for (; taken < count && source.freeList != nullptr; ++taken)
+            {
+                *tail = source.freeList;
+                tail = &source.freeList->next;
+                source.freeList = source.freeList->next;
+                --source.freeSize;
+                --freeSlots;
+            }
+        }
+        *tail = nullptr;
+        nodes.size = taken;
+        updateMode();
+    }
+
+    /**
+     * @brief Restituisce alla lista condivisa batchSlots elementi della lista locale
+     *
+     * @param nodes è la lista locale (con più di batchSlots elementi)
+     */
+    void drain(cache &nodes)
+    {
+        std::lock_guard<std::mutex> guard{lock};
+        for (std::size_t i{0}; i < batchSlots; ++i)
+        {
+            slot *s{nodes.head};
+            nodes.head = s->next;
+            giveBack(s);
+        }
+        nodes.size -= batchSlots;
+        updateMode();
+    }
+
+    /**
+     * @brief Alloca un nuovo chunk e ne inserisce gli elementi nella sua lista libera in ordine di indirizzo
+     */
+    void grow()
+    {
+        slot *first{static_cast<slot *>(::operator new(chunkSlots * sizeof(slot), std::align_val_t{alignof(slot)}))};
+        for (std::size_t i{0}; i + 1 < chunkSlots; ++i)
+        {
+            first[i].next = &first[i + 1];
+        }
+        first[chunkSlots - 1].next = nullptr;
+        typename std::vector<chunk>::iterator position{std::upper_bound(chunks.begin(), chunks.end(), first, [](slot *p, const chunk &c)
+                                                               { return std::less<slot *>()(p, c.first); })};
+        firstFree = std::min(firstFree, std::size_t(position - chunks.begin()));
+        chunks.insert(position, chunk{first, chunkSlots, first, chunkSlots});
+        freeSlots += chunkSlots;
+        reserved += chunkSlots;
+        if (chunkSlots < maxChunkSlots) // I chunk crescono per ridurre il numero di allocazioni degli alberi grandi
+        {
+            chunkSlots *= 2;
+        }
+    }
+
+public:
+    nodePool(const nodePool &) = delete;
+    nodePool &operator=(const nodePool &) = delete;
+
+    /**
+     * @brief Restituisce l'istanza dell'allocatore per la dimensione di nodo SIZE
+     *
+     * @return nodePool& è il riferimento all'allocatore
+     */
+    static nodePool &instance()
+    {
+        static nodePool *pool{new nodePool()}; // Volutamente mai distrutto (vedi la descrizione della classe)
+        return *pool;
+    }
+
+    /**
+     * @brief Numero di nodi contenuti nei chunk ancora allocati
+     *
+     * @return std::size_t è il numero di nodi, liberi o in uso
+     */
+    std::size_t reservedSlots()
+    {
+        std::lock_guard<std::mutex> guard{lock};
+        return reserved;
+    }
+
+    /**
+     * @brief Restituisce la memoria per un nuovo nodo
+     *
+     * @return void* è il puntatore alla memoria del nodo
+     */
+    void *allocate()
+    {
+        cache &nodes{local()};
+        bool single{direct.load(std::memory_order_relaxed)};
+        if (single && nodes.head != nullptr) // Ingresso nella modalità di rilascio: la lista locale torna nella lista condivisa
+        {
+            release(nodes);
+        }
+        if (nodes.head == nullptr)
+        {
+            refill(nodes, single ? 1 : batchSlots);
+        }
+        slot *s{nodes.head};
+        nodes.head = s->next;
+        --nodes.size;
+        if (nodes.closed) // Thread in terminazione: gli altri nodi prelevati tornano subito nella lista condivisa
+        {
+            release(nodes);
+        }
+        return s;
+    }
+
+    /**
+     * @brief Restituisce all'allocatore la memoria di un nodo
+     *
+     * @param p è il puntatore alla memoria del nodo
+     */
+    void deallocate(void *p)
+    {
+        cache &nodes{local()};
+        slot *s{static_cast<slot *>(p)};
+        s->next = nodes.head;
+        nodes.head = s;
+        if (nodes.closed || direct.load(std::memory_order_relaxed))
+        {
+            release(nodes);
+        }
+        else if (++nodes.size > 2 * batchSlots)
+        {
+            drain(nodes);
+        }
+    }
+};
+
+#endif
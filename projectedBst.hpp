@@ -0,0 +1,296 @@
+#ifndef __projectedBst_hpp__
+#define __projectedBst_hpp__
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "bst.hpp"
+
+/**
+ * @brief Chiave di un nodo di projectedBst: chiave di confronto proiettata e posizione del valore completo
+ *
+ * @tparam K è il tipo della chiave proiettata
+ */
+template <typename K>
+struct projectedKey
+{
+    K key;         // chiave di confronto
+    uint32_t slot; // posizione del valore nell'array dei valori
+
+    inline bool operator==(const projectedKey<K> &other) const
+    {
+        return key == other.key;
+    }
+};
+
+/**
+ * @brief Relazione d'ordine delle chiavi projectedKey: confronta solo le chiavi proiettate
+ *
+ * @tparam K è il tipo della chiave proiettata
+ * @tparam CMP è la relazione d'ordine del tipo K
+ */
+template <typename K, typename CMP>
+struct projectedOrder
+{
+    CMP cmp;
+
+    inline bool operator()(const projectedKey<K> &a, const projectedKey<K> &b) const
+    {
+        return cmp(a.key, b.key);
+    }
+};
+
+/**
+ * @class projectedBst
+ *
+ * @brief Albero binario di ricerca che separa la chiave di confronto dal resto del valore.
+ * La proiezione PROJ (per esempio &City::getPopulation) ricava da ogni valore la chiave usata per l'ordine: i nodi
+ * memorizzano solo tale chiave e la posizione del valore in un array parallelo, quindi una ricerca legge nodi piccoli
+ * (per City 40 byte invece di 72) e accede al valore completo solo per il nodo trovato.
+ * Le posizioni liberate dalle cancellazioni vengono riutilizzate dagli inserimenti successivi. bst è una classe base
+ * privata, perché i suoi metodi che inseriscono, eliminano o spostano nodi in altri alberi (insertBatch, inserimento con
+ * suggerimento, split, join, swap, release/adopt, eraseRange, eraseIf, remove) non aggiornerebbero l'array dei valori;
+ * per lo stesso motivo ricerche e visite restituiscono nodi costanti.
+ *
+ * @tparam T è il tipo dei valori
+ * @tparam PROJ è la proiezione dal valore alla chiave di confronto (funzione o puntatore a metodo o a membro)
+ * @tparam CMP è la relazione d'ordine delle chiavi proiettate
+ */
+template <typename T, auto PROJ, typename CMP = std::greater<std::decay_t<std::invoke_result_t<decltype(PROJ), const T &>>>>
+class projectedBst : private bst<projectedKey<std::decay_t<std::invoke_result_t<decltype(PROJ), const T &>>>,
+                                projectedOrder<std::decay_t<std::invoke_result_t<decltype(PROJ), const T &>>, CMP>>
+{
+public:
+    using key_type = std::decay_t<std::invoke_result_t<decltype(PROJ), const T &>>;
+    using node_type = bst<projectedKey<key_type>, projectedOrder<key_type, CMP>>;
+    using typename node_type::const_iterator;
+    using node_type::operator new;
+    using node_type::operator delete;
+    using node_type::getKey;
+    using node_type::getCount;
+    using node_type::isEmpty;
+    using node_type::findFrom;
+    using node_type::nodesCount;
+    using node_type::leavesCount;
+    using node_type::height;
+    using node_type::inorder;
+    using node_type::preorder;
+    using node_type::postorder;
+    using node_type::rebalance;
+    using node_type::relayout;
+    using node_type::compact;
+    using node_type::begin;
+    using node_type::end;
+    using node_type::cend;
+
+private:
+    std::vector<T> values;         // valori completi, indicizzati da projectedKey::slot
+    std::vector<uint32_t> released; // posizioni di values non più utilizzate
+
+    /**
+     * @brief Chiave usata per cercare una chiave proiettata
+     */
+    static inline projectedKey<key_type> probe(const key_type &key)
+    {
+        return projectedKey<key_type>{key, 0};
+    }
+
+public:
+    /**
+     * @brief Costruttore vuoto
+     */
+    projectedBst() : node_type() {}
+
+    /**
+     * @brief Costruttore per convertire un array in un albero
+     *
+     * @param array che si vuole convertire nell'albero
+     * @param length è la lunghezza dell'array
+     */
+    projectedBst(const T array[], uint length) : projectedBst()
+    {
+        values.reserve(length);
+        for (uint i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    /**
+     * @brief Restituisce il sottoalbero sinistro
+     * I nodi sono restituiti costanti: un inserimento fatto attraverso di essi non riserverebbe la posizione del valore.
+     *
+     * @return puntatore costante al nodo figlio sinistro
+     */
+    inline const node_type *getLeft() const
+    {
+        return node_type::getLeft();
+    }
+
+    /**
+     * @brief Restituisce il sottoalbero destro
+     *
+     * @return puntatore costante al nodo figlio destro
+     */
+    inline const node_type *getRight() const
+    {
+        return node_type::getRight();
+    }
+
+    /**
+     * @brief Restituisce il nodo con la chiave proiettata più piccola
+     *
+     * @return puntatore costante al nodo con valore minimo
+     */
+    inline const node_type *min()
+    {
+        return node_type::min();
+    }
+
+    /**
+     * @brief Restituisce il nodo con la chiave proiettata più grande
+     *
+     * @return puntatore costante al nodo con valore massimo
+     */
+    inline const node_type *max()
+    {
+        return node_type::max();
+    }
+
+    /**
+     * @brief Inserisce un valore: la chiave proiettata va nel nodo e il valore nell'array parallelo
+     *
+     * @param value è il valore da inserire
+     * @return projectedBst& è l'albero stesso, così anche gli inserimenti concatenati riservano la posizione del valore
+     */
+    projectedBst<T, PROJ, CMP> &insertValue(const T &value)
+    {
+        uint32_t slot;
+        if (released.empty())
+        {
+            slot = static_cast<uint32_t>(values.size());
+            values.push_back(value);
+        }
+        else
+        {
+            slot = released.back();
+            released.pop_back();
+            values[slot] = value;
+        }
+        node_type::insertValue(projectedKey<key_type>{std::invoke(PROJ, value), slot});
+        return *this;
+    }
+
+    /**
+     * @brief Ricerca di una chiave proiettata
+     *
+     * @param key è la chiave da cercare
+     * @return puntatore costante al nodo trovato o nullptr se la chiave non è presente
+     */
+    inline const node_type *find(const key_type &key) const
+    {
+        return node_type::find(probe(key));
+    }
+
+    /**
+     * @brief Metodo che informa se una chiave proiettata è presente (senza lanciare eccezioni)
+     *
+     * @param key è la chiave da cercare
+     * @return true se la chiave è presente
+     * @return false se la chiave non è presente
+     */
+    inline bool isPresent(const key_type &key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * @brief Ricerca di una chiave proiettata
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param key è la chiave da cercare
+     * @return puntatore costante al nodo trovato
+     */
+    const node_type *binarySearch(const key_type &key) const
+    {
+        const node_type *node{find(key)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(key);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Valore completo associato a un nodo
+     *
+     * @param node è il nodo (non nullptr)
+     * @return const T& è il riferimento al valore (valido fino alla modifica successiva dell'albero)
+     */
+    inline const T &payload(const node_type *node) const
+    {
+        return values[node->getKey().slot];
+    }
+
+    /**
+     * @brief Valore completo con una data chiave proiettata
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param key è la chiave da cercare
+     * @return const T& è il riferimento al valore (valido fino alla modifica successiva dell'albero)
+     */
+    inline const T &lookup(const key_type &key) const
+    {
+        return payload(binarySearch(key));
+    }
+
+    /**
+     * @brief Eliminazione di un valore con una data chiave proiettata
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param key è la chiave del valore da eliminare
+     */
+    void deleteKey(const key_type &key)
+    {
+        node_type *node{node_type::find(probe(key))};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(key);
+        }
+        uint32_t slot{node->getKey().slot};
+        values[slot] = T(); // Libera subito le risorse del valore (per esempio la stringa di City)
+        released.push_back(slot);
+        node_type::deleteKey(node);
+    }
+};
+
+/**
+ * @brief Metodo per ottenere una rappresentazione mediante stringa di una chiave projectedKey
+ *
+ * @param key è la chiave di cui si vuole ricavare una rappresentazione mediante stringa
+ * @return std::string
+ */
+template <typename K>
+inline std::string to_string(const projectedKey<K> &key)
+{
+    return to_string_adl(key.key);
+}
+
+/**
+ * Stampa una chiave projectedKey su uno stream
+ *
+ * @param os è lo stream di output
+ * @param key è la chiave da stampare
+ * @return è il riferimento allo stream di output
+ */
+template <typename K>
+std::ostream &operator<<(std::ostream &os, const projectedKey<K> &key)
+{
+    os << key.key;
+    return os;
+}
+
+#endif
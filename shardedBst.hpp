@@ -0,0 +1,630 @@
+#ifndef __shardedBst_hpp__
+#define __shardedBst_hpp__
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bst.hpp"
+
+/**
+ * @class shardedBst
+ *
+ * @brief Contenitore ordinato diviso in shard: lo spazio delle chiavi è partizionato per intervalli tra N alberi bst
+ * indipendenti, ciascuno protetto dal proprio mutex, quindi thread che inseriscono chiavi di shard diversi non si bloccano.
+ * Le chiavi divisorie (splitter) stabiliscono lo shard di ogni chiave: lo shard i contiene le chiavi k con
+ * splitter[i - 1] <= k < splitter[i]. Gli splitter sono immutabili e pubblicati con un puntatore atomico, quindi
+ * l'instradamento non richiede lock condivisi; le versioni sostituite vengono liberate appena nessun thread le sta leggendo
+ * (due contatori di lettori alternati, come in SRCU). Quando uno shard diventa troppo grande rispetto alla media le chiavi
+ * del suo bordo vengono spostate nello shard vicino più piccolo con split e join di bst, bloccando solo i due shard
+ * coinvolti; gli altri shard continuano a ricevere inserimenti.
+ * Ogni thread alloca i nodi dalla propria lista locale di nodePool.
+ *
+ * insertValue(), deleteKey() e isPresent() possono essere chiamati da più thread; find(), binarySearch(), gli iteratori
+ * e le visite richiedono invece che nessun thread stia modificando il contenitore.
+ *
+ * @tparam T è il tipo di dato delle chiavi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ */
+template <typename T, typename CMP = std::greater<T>>
+class shardedBst
+{
+private:
+    /**
+     * @brief Shard: albero e mutex su una propria linea di cache
+     */
+    struct alignas(64) shard
+    {
+        std::mutex lock;     // protegge tree e size
+        bst<T, CMP> tree;    // chiavi dello shard
+        std::size_t size{0}; // numero di chiavi dello shard
+    };
+
+    /**
+     * @brief Versione degli splitter: le chiavi divisorie e un numero che cambia a ogni sostituzione
+     */
+    struct boundaries
+    {
+        std::size_t version; // numero della versione
+        std::vector<T> keys; // splitter (al più shardCount - 1)
+    };
+
+    /**
+     * @brief Contatore dei thread che stanno leggendo gli splitter, su una propria linea di cache
+     */
+    struct alignas(64) readerCount
+    {
+        std::atomic<std::size_t> count{0};
+    };
+
+    static const std::size_t rebalanceMinimum{4096}; // numero di chiavi sotto cui uno shard non è mai considerato sbilanciato
+
+    std::size_t shardCount;                   // numero di shard
+    std::unique_ptr<shard[]> shards;          // shard in ordine di chiave
+    std::atomic<const boundaries *> splitters; // splitter correnti
+    std::atomic<std::size_t> generation;      // versione degli splitter correnti (leggibile senza accedere agli splitter)
+    std::atomic<bool> complete;               // true se gli splitter correnti sono shardCount - 1
+    std::atomic<std::size_t> epoch;           // la parità sceglie il contatore dei nuovi lettori
+    mutable readerCount readers[2];           // lettori degli splitter per parità di epoch
+    std::atomic<std::size_t> total;           // numero totale di chiavi
+    std::atomic<std::size_t> nextRebalance;   // numero di chiavi prima del quale non si ribilancia di nuovo
+    double skew;                              // rapporto massimo tra uno shard e la media
+    std::mutex rebalanceLock;                 // un solo ribilanciamento alla volta
+    CMP cmp;                                  // comparatore
+
+    /**
+     * @brief Shard a cui appartiene una chiave secondo gli splitter forniti
+     *
+     * @param bounds sono gli splitter
+     * @param value è la chiave
+     * @return std::size_t è l'indice dello shard
+     */
+    std::size_t route(const std::vector<T> &bounds, const T &value) const
+    {
+        return std::upper_bound(bounds.begin(), bounds.end(), value, [this](const T &a, const T &b)
+                                { return cmp(b, a); }) -
+               bounds.begin();
+    }
+
+    /**
+     * @brief Shard a cui appartiene una chiave secondo gli splitter correnti
+     * Il thread si registra nel contatore dei lettori prima di leggere il puntatore agli splitter e si cancella dopo
+     * l'instradamento, quindi retire() non libera una versione mentre viene letta.
+     *
+     * @param value è la chiave
+     * @param version è il numero della versione degli splitter usata
+     * @return std::size_t è l'indice dello shard
+     */
+    std::size_t locate(const T &value, std::size_t &version) const
+    {
+        std::atomic<std::size_t> &reading{readers[epoch.load() & 1].count};
+        reading.fetch_add(1);
+        const boundaries *bounds{splitters.load()};
+        version = bounds->version;
+        std::size_t index{route(bounds->keys, value)};
+        reading.fetch_sub(1);
+        return index;
+    }
+
+    /**
+     * @brief Libera una versione degli splitter già sostituita
+     * Ogni lettore si registra nel contatore della parità di epoch letta all'inizio: dopo due cambi di parità, ciascuno
+     * seguito dall'attesa che il contatore della parità precedente si azzeri, ogni thread che poteva leggere la vecchia
+     * versione ha terminato l'instradamento. I lettori che iniziano dopo un cambio usano l'altro contatore, quindi l'attesa
+     * non dipende dal traffico e dura al più un instradamento.
+     *
+     * @param old è la versione sostituita
+     */
+    void retire(const boundaries *old)
+    {
+        for (uint round{0}; round < 2; ++round)
+        {
+            std::size_t previous{epoch.fetch_add(1)};
+            while (readers[previous & 1].count.load() != 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+        delete old;
+    }
+
+    /**
+     * @brief Pubblica una nuova versione degli splitter (con i lock degli shard di cui cambia l'intervallo)
+     *
+     * @param keys sono i nuovi splitter
+     * @return const boundaries* è la versione sostituita, da passare a retire() dopo aver sbloccato gli shard
+     */
+    const boundaries *publish(std::vector<T> &&keys)
+    {
+        const boundaries *old{splitters.load()};
+        complete.store(keys.size() + 1 == shardCount, std::memory_order_relaxed);
+        splitters.store(new boundaries{old->version + 1, std::move(keys)});
+        generation.store(old->version + 1);
+        return old;
+    }
+
+    /**
+     * @brief Blocca lo shard di una chiave
+     * Se gli splitter cambiano tra l'instradamento e l'acquisizione del mutex l'operazione viene ripetuta: i ribilanciamenti
+     * pubblicano i nuovi splitter tenendo bloccati gli shard di cui cambia l'intervallo, quindi con il mutex acquisito e la
+     * stessa versione gli splitter letti sono validi per lo shard bloccato.
+     *
+     * @param value è la chiave
+     * @param index è l'indice dello shard bloccato
+     * @return std::unique_lock<std::mutex> è il lock dello shard
+     */
+    std::unique_lock<std::mutex> lockShard(const T &value, std::size_t &index)
+    {
+        for (;;)
+        {
+            std::size_t version;
+            index = locate(value, version);
+            std::unique_lock<std::mutex> guard{shards[index].lock};
+            if (generation.load() == version)
+            {
+                return guard;
+            }
+        }
+    }
+
+    /**
+     * @brief Controlla se due chiavi sono equivalenti per la relazione d'ordine
+     */
+    inline bool equivalent(const T &a, const T &b) const
+    {
+        return !cmp(a, b) && !cmp(b, a);
+    }
+
+    /**
+     * @brief Sposta in uno shard vicino le chiavi di uno shard che superano la dimensione media
+     * Vengono bloccati solo lo shard e i due vicini (in ordine di indice); lo shard viene diviso con bst::split() in
+     * corrispondenza della chiave di bordo e la parte eccedente viene concatenata al vicino con bst::join(), poi i due
+     * alberi vengono ribilanciati (concatenazioni ripetute e chiavi crescenti li renderebbero sempre più alti). Il costo è
+     * lineare nella dimensione dei due shard e non dipende dagli altri. Le chiavi uguali non vengono separate: se lo shard
+     * contiene una sola chiave ripetuta non si sposta nulla.
+     *
+     * @param index è l'indice dello shard
+     * @param step è la direzione dello spostamento (+1 verso destra, -1 verso sinistra, 0 verso il vicino più piccolo)
+     * @param mean è la dimensione media degli shard
+     * @return std::size_t è il numero di chiavi spostate
+     */
+    std::size_t shiftBoundary(std::size_t index, int &step, std::size_t mean)
+    {
+        const boundaries *old{nullptr};
+        std::size_t moved{0};
+        {
+            std::vector<std::unique_lock<std::mutex>> guards;
+            for (std::size_t i{index > 0 ? index - 1 : 0}; i <= index + 1 && i < shardCount; ++i)
+            {
+                guards.emplace_back(shards[i].lock);
+            }
+            if (step == 0)
+            {
+                step = index == 0 || (index + 1 < shardCount && shards[index + 1].size < shards[index - 1].size) ? 1 : -1;
+            }
+            bool toRight{step > 0};
+            std::size_t neighbour{index + step};
+            shard &source{shards[index]};
+            shard &target{shards[neighbour]};
+            if (source.size <= mean)
+            {
+                return 0;
+            }
+            // Nodo di bordo dopo source.size - mean chiavi, esteso alle chiavi uguali; beyond è il primo nodo che resta
+            bst<T, CMP> *node{toRight ? source.tree.max() : source.tree.min()};
+            for (moved = 1; moved < source.size - mean; ++moved)
+            {
+                node = toRight ? bst<T, CMP>::prevNode(node) : bst<T, CMP>::nextNode(node);
+            }
+            bst<T, CMP> *beyond{toRight ? bst<T, CMP>::prevNode(node) : bst<T, CMP>::nextNode(node)};
+            while (beyond != nullptr && equivalent(beyond->getKey(), node->getKey()))
+            {
+                node = beyond;
+                beyond = toRight ? bst<T, CMP>::prevNode(node) : bst<T, CMP>::nextNode(node);
+                ++moved;
+            }
+            if (beyond == nullptr) // Tutte le chiavi dello shard sono uguali a quella di bordo
+            {
+                return 0;
+            }
+            T divider{toRight ? node->getKey() : beyond->getKey()}; // Prima chiave dello shard di destra
+            auto parts{source.tree.split(divider)};
+            std::vector<T> keys{splitters.load()->keys};
+            if (toRight)
+            {
+                source.tree = std::move(parts.first);
+                target.tree = bst<T, CMP>::join(std::move(parts.second), std::move(target.tree));
+                keys[index] = divider;
+            }
+            else
+            {
+                target.tree = bst<T, CMP>::join(std::move(target.tree), std::move(parts.first));
+                source.tree = std::move(parts.second);
+                keys[neighbour] = divider;
+            }
+            source.tree.rebalance();
+            target.tree.rebalance();
+            source.size -= moved;
+            target.size += moved;
+            old = publish(std::move(keys));
+        }
+        retire(old);
+        return moved;
+    }
+
+    /**
+     * @brief Corregge lo sbilanciamento di uno shard spostando chiavi di bordo tra shard vicini
+     * L'eccesso rispetto alla media passa al vicino più piccolo; se il vicino supera a sua volta la media lo spostamento
+     * prosegue nella stessa direzione, quindi anche con chiavi crescenti (che finiscono tutte nell'ultimo shard) l'eccesso
+     * si distribuisce sugli shard precedenti. Ogni passo blocca al più tre shard adiacenti e gli altri shard continuano a
+     * ricevere inserimenti. Tra due correzioni vengono inserite almeno n/N chiavi.
+     *
+     * @param index è l'indice dello shard sbilanciato
+     */
+    void spread(std::size_t index)
+    {
+        std::unique_lock<std::mutex> single{rebalanceLock, std::try_to_lock};
+        if (!single.owns_lock())
+        {
+            return;
+        }
+        std::size_t n{total.load(std::memory_order_relaxed)};
+        int step{0};
+        while (shiftBoundary(index, step, n / shardCount) > 0)
+        {
+            index += step;
+            if ((step < 0 && index == 0) || (step > 0 && index + 1 == shardCount)) // Nessun vicino nella stessa direzione
+            {
+                break;
+            }
+        }
+        nextRebalance.store(n + n / shardCount, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Controlla se uno shard è troppo grande rispetto alla media (o se gli splitter non sono ancora stati calcolati)
+     * Tra due ribilanciamenti vengono inserite almeno n/N chiavi, quindi il costo O(n) del ribilanciamento si ripartisce
+     * in O(N) per inserimento anche quando lo sbilanciamento non si può correggere (per esempio chiavi tutte uguali).
+     *
+     * @param size è il numero di chiavi dello shard
+     * @return true se conviene ribilanciare
+     */
+    inline bool skewed(std::size_t size) const
+    {
+        std::size_t n{total.load(std::memory_order_relaxed)};
+        return shardCount > 1 && size > rebalanceMinimum && n >= nextRebalance.load(std::memory_order_relaxed) &&
+               (size > skew * n / shardCount || !partitioned());
+    }
+
+    /**
+     * @brief Controlla se gli splitter dividono le chiavi in tutti gli shard
+     * Legge un indicatore aggiornato da publish() invece degli splitter, che fuori da locate() possono essere liberati.
+     */
+    inline bool partitioned() const
+    {
+        return complete.load(std::memory_order_relaxed);
+    }
+
+public:
+    /**
+     * @class const_iterator
+     *
+     * @brief Iteratore costante sulle chiavi in ordine globale
+     * Gli shard contengono intervalli disgiunti e ordinati di chiavi, quindi la fusione degli shard si riduce a visitarli
+     * uno dopo l'altro.
+     */
+    class const_iterator
+    {
+    private:
+        const shardedBst *owner; // contenitore
+        std::size_t index;       // shard corrente (shardCount per end())
+        bst<T, CMP> *ptr;        // nodo corrente
+
+        const_iterator(const shardedBst *inputOwner, std::size_t inputIndex, bst<T, CMP> *inputPtr) : owner{inputOwner}, index{inputIndex}, ptr{inputPtr}
+        {
+            skipEmpty();
+        }
+
+        /**
+         * @brief Passa al primo nodo del primo shard non vuoto a partire da quello corrente, se il nodo corrente manca
+         */
+        void skipEmpty()
+        {
+            while (ptr == nullptr && index < owner->shardCount)
+            {
+                if (++index < owner->shardCount && !owner->shards[index].tree.isEmpty())
+                {
+                    ptr = owner->shards[index].tree.min();
+                }
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = bst<T, CMP>;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        /**
+         * @brief Costruttore vuoto pubblico
+         */
+        const_iterator() : owner{nullptr}, index{0}, ptr{nullptr} {}
+
+        const_iterator &operator++()
+        {
+            ptr = bst<T, CMP>::nextNode(ptr);
+            skipEmpty();
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator current{*this};
+            ++(*this);
+            return current;
+        }
+
+        inline reference operator*() const
+        {
+            return *ptr;
+        }
+
+        inline pointer operator->() const
+        {
+            return ptr;
+        }
+
+        inline bool operator==(const const_iterator &it) const
+        {
+            return index == it.index && ptr == it.ptr;
+        }
+
+        inline bool operator!=(const const_iterator &it) const
+        {
+            return !(*this == it);
+        }
+
+        friend class shardedBst<T, CMP>;
+    };
+
+    /**
+     * @brief Costruttore vuoto
+     * Finché non ci sono abbastanza chiavi per calcolare gli splitter tutte le chiavi vanno nel primo shard.
+     *
+     * @param inputShardCount è il numero di shard (per default il numero di core)
+     * @param inputSkew è il rapporto tra la dimensione di uno shard e la media oltre il quale gli shard vengono ribilanciati
+     */
+    shardedBst(std::size_t inputShardCount = std::max(1u, std::thread::hardware_concurrency()), double inputSkew = 2)
+        : shardCount{std::max<std::size_t>(1, inputShardCount)}, shards{new shard[shardCount]}, splitters{new boundaries{0, {}}}, generation{0}, complete{shardCount == 1}, epoch{0},
+          total{0}, nextRebalance{0}, skew{inputSkew}
+    {
+    }
+
+    /**
+     * @brief Costruttore con gli splitter calcolati da un campione di chiavi
+     *
+     * @param sample sono chiavi con la stessa distribuzione di quelle che verranno inserite
+     * @param inputShardCount è il numero di shard
+     * @param inputSkew è il rapporto tra la dimensione di uno shard e la media oltre il quale gli shard vengono ribilanciati
+     */
+    shardedBst(std::vector<T> sample, std::size_t inputShardCount, double inputSkew = 2) : shardedBst(inputShardCount, inputSkew)
+    {
+        std::sort(sample.begin(), sample.end(), [this](const T &a, const T &b)
+                  { return cmp(b, a); });
+        std::vector<T> bounds;
+        for (std::size_t i{1}; i < shardCount && !sample.empty(); ++i)
+        {
+            bounds.push_back(sample[i * sample.size() / shardCount]);
+        }
+        delete publish(std::move(bounds)); // Nessun altro thread può leggere gli splitter durante la costruzione
+    }
+
+    shardedBst(const shardedBst<T, CMP> &) = delete;
+    shardedBst<T, CMP> &operator=(const shardedBst<T, CMP> &) = delete;
+
+    ~shardedBst()
+    {
+        delete splitters.load();
+    }
+
+    /**
+     * @brief Inserisce un valore nel suo shard (thread-safe)
+     * Se lo shard diventa troppo grande rispetto alla media le chiavi del suo bordo vengono spostate nello shard vicino;
+     * finché gli splitter non dividono le chiavi in tutti gli shard vengono invece calcolati con rebalance().
+     *
+     * @param value è il valore da inserire
+     */
+    void insertValue(const T &value)
+    {
+        std::size_t index;
+        bool unbalanced;
+        {
+            std::unique_lock<std::mutex> guard{lockShard(value, index)};
+            shards[index].tree.insertValue(value);
+            total.fetch_add(1, std::memory_order_relaxed);
+            unbalanced = skewed(++shards[index].size);
+        }
+        if (unbalanced)
+        {
+            if (partitioned())
+            {
+                spread(index);
+            }
+            else
+            {
+                rebalance();
+            }
+        }
+    }
+
+    /**
+     * @brief Elimina un'occorrenza di una chiave (thread-safe)
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da eliminare
+     */
+    void deleteKey(const T &value)
+    {
+        std::size_t index;
+        std::unique_lock<std::mutex> guard{lockShard(value, index)};
+        shards[index].tree.deleteKey(value);
+        --shards[index].size;
+        total.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Metodo che informa se una chiave è presente (thread-safe)
+     *
+     * @param value è la chiave da cercare
+     * @return true se la chiave è presente
+     * @return false se la chiave non è presente
+     */
+    bool isPresent(const T &value)
+    {
+        std::size_t index;
+        std::unique_lock<std::mutex> guard{lockShard(value, index)};
+        return shards[index].tree.find(value) != nullptr;
+    }
+
+    /**
+     * @brief Ricerca di una chiave nel suo shard
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore al nodo trovato o nullptr se la chiave non è presente
+     */
+    bst<T, CMP> *find(const T &value) const
+    {
+        std::size_t version;
+        return shards[locate(value, version)].tree.find(value);
+    }
+
+    /**
+     * @brief Ricerca di una chiave
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore al nodo trovato
+     */
+    bst<T, CMP> *const binarySearch(const T &value) const
+    {
+        bst<T, CMP> *node{find(value)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Ricalcola tutti gli splitter in modo che gli shard abbiano lo stesso numero di chiavi
+     * Tutti gli shard vengono bloccati, concatenati in un solo albero con bst::join(), ribilanciati con bst::rebalance() e
+     * divisi con bst::split() intorno alle chiavi di rango i·n/N, che si trovano con una visita simmetrica. Il costo è O(n)
+     * con tutti gli shard bloccati: insertValue() lo usa solo per calcolare i primi splitter (quando tutte le chiavi sono
+     * ancora in pochi shard), poi corregge gli sbilanciamenti spostando le chiavi di bordo tra shard vicini.
+     * Se un altro thread sta già ribilanciando il metodo ritorna subito.
+     */
+    void rebalance()
+    {
+        std::unique_lock<std::mutex> single{rebalanceLock, std::try_to_lock};
+        if (!single.owns_lock())
+        {
+            return;
+        }
+        std::vector<std::unique_lock<std::mutex>> guards;
+        for (std::size_t i{0}; i < shardCount; ++i) // Sempre in ordine di indice, come in spread()
+        {
+            guards.emplace_back(shards[i].lock);
+        }
+        std::size_t n{0};
+        for (std::size_t i{0}; i < shardCount; ++i)
+        {
+            n += shards[i].size;
+        }
+        if (n == 0)
+        {
+            return;
+        }
+
+        std::vector<T> bounds;
+        std::size_t rank{0}, next{1};
+        for (std::size_t i{0}; i < shardCount && next < shardCount; ++i)
+        {
+            if (shards[i].tree.isEmpty())
+            {
+                continue;
+            }
+            for (bst<T, CMP> *node{shards[i].tree.min()}; node != nullptr && next < shardCount; node = bst<T, CMP>::nextNode(node), ++rank)
+            {
+                while (next < shardCount && rank == next * n / shardCount)
+                {
+                    bounds.push_back(node->getKey());
+                    ++next;
+                }
+            }
+        }
+
+        bst<T, CMP> all;
+        for (std::size_t i{0}; i < shardCount; ++i)
+        {
+            all = bst<T, CMP>::join(std::move(all), std::move(shards[i].tree));
+        }
+        all.rebalance(); // Le concatenazioni allungano l'albero: gli split lavorano su altezza O(log n)
+        for (std::size_t i{0}; i < bounds.size(); ++i)
+        {
+            auto parts{all.split(bounds[i])};
+            shards[i].tree = std::move(parts.first);
+            all = std::move(parts.second);
+        }
+        shards[bounds.size()].tree = std::move(all);
+        for (std::size_t i{0}; i < shardCount; ++i)
+        {
+            shards[i].size = shards[i].tree.nodesCount();
+        }
+        const boundaries *old{publish(std::move(bounds))};
+        nextRebalance.store(n + n / shardCount, std::memory_order_relaxed);
+        guards.clear();
+        retire(old);
+    }
+
+    /**
+     * @brief Restituisce il numero totale di chiavi
+     *
+     * @return std::size_t è il numero di chiavi
+     */
+    inline std::size_t nodesCount() const
+    {
+        return total.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Restituisce il numero di chiavi di ogni shard
+     *
+     * @return std::vector<std::size_t> sono le dimensioni degli shard in ordine di chiave
+     */
+    std::vector<std::size_t> shardSizes() const
+    {
+        std::vector<std::size_t> sizes(shardCount);
+        for (std::size_t i{0}; i < shardCount; ++i)
+        {
+            sizes[i] = shards[i].size;
+        }
+        return sizes;
+    }
+
+    inline const_iterator begin() const
+    {
+        return const_iterator{this, 0, shards[0].tree.isEmpty() ? nullptr : shards[0].tree.min()};
+    }
+
+    inline const_iterator end() const
+    {
+        return const_iterator{this, shardCount, nullptr};
+    }
+};
+
+#endif
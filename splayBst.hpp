@@ -0,0 +1,283 @@
+#ifndef __splayBst_hpp__
+#define __splayBst_hpp__
+
+#include "bst.hpp"
+
+/**
+ * @class splayBst
+ *
+ * @brief Albero binario di ricerca autoaggiustante (splay tree).
+ * Ogni nodo a cui si accede con find(), binarySearch(), insertValue() o deleteKey() viene portato nella radice mediante
+ * una sequenza di rotazioni (zig, zig-zig, zig-zag); una ricerca senza successo porta nella radice l'ultimo nodo visitato.
+ * Ogni accesso costa O(log n) ammortizzato e le chiavi appena usate si trovano vicino alla radice.
+ *
+ * Con setSplayPeriod(p) lo splaying avviene solo in un accesso su p in media, scelto in modo pseudocasuale (splaying
+ * randomizzato): le chiavi richieste spesso salgono comunque verso la radice, ma gli accessi restanti non pagano le
+ * scritture delle rotazioni. Nelle misure di bench.cpp lo splaying a ogni accesso (p = 1, il default) è più lento di bst
+ * con tutte le distribuzioni provate, anche con poche chiavi calde; con p = 16 splayBst è più veloce di bst quando
+ * il 90% delle ricerche riguarda 300 chiavi, pari a bst con la distribuzione di Zipf e più lento con ricerche uniformi.
+ * L'accesso in tempo quasi costante alle chiavi calde si ottiene quindi solo con lo splaying randomizzato.
+ *
+ * Nota: l'ultima rotazione, che coinvolge la radice, scambia le chiavi tra i nodi per mantenere fisso l'oggetto radice,
+ * quindi dopo un accesso i puntatori ai nodi ottenuti in precedenza possono riferirsi a chiavi diverse.
+ *
+ * @tparam T è il tipo di dato delle chiavi associate ai nodi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ */
+template <typename T, typename CMP = std::greater<T>>
+class splayBst : public bst<T, CMP>
+{
+private:
+    uint period;    // in media un accesso su period provoca lo splaying
+    uint32_t state; // stato del generatore xorshift che sceglie gli accessi con splaying
+
+    /**
+     * @brief Rotazione che porta un nodo al posto del genitore ricollegando i puntatori (senza spostare chiavi)
+     * Il genitore non deve essere la radice, perché l'oggetto radice non può cambiare posizione.
+     *
+     * @param node è il nodo da far salire (il suo nonno deve esistere)
+     */
+    static void rotateUp(bst<T, CMP> *node)
+    {
+        bst<T, CMP> *p{node->parent};
+        bst<T, CMP> *g{p->parent};
+        if (node == p->left)
+        {
+            p->left = node->right; // Il sottoalbero destro del nodo resta tra le due chiavi
+            if (p->left != nullptr)
+            {
+                p->left->parent = p;
+            }
+            node->right = p;
+        }
+        else
+        {
+            p->right = node->left; // Il sottoalbero sinistro del nodo resta tra le due chiavi
+            if (p->right != nullptr)
+            {
+                p->right->parent = p;
+            }
+            node->left = p;
+        }
+        p->parent = node;
+        node->parent = g;
+        (g->left == p ? g->left : g->right) = node;
+    }
+
+    /**
+     * @brief Porta la chiave del nodo fornito nella radice dell'albero
+     * Sotto la radice i passi zig-zig e zig-zag ricollegano i puntatori, quindi ogni nodo mantiene la sua chiave;
+     * solo l'ultimo passo, che coinvolge la radice, scambia il contenuto dei nodi con le rotazioni di bst.
+     *
+     * @param node è il nodo la cui chiave deve diventare la radice
+     */
+    void splay(bst<T, CMP> *node)
+    {
+        while (node->parent != nullptr)
+        {
+            bst<T, CMP> *p{node->parent};
+            bst<T, CMP> *g{p->parent};
+            if (g == nullptr) // zig: il genitore è la radice
+            {
+                if (node == p->left)
+                {
+                    bst<T, CMP>::rotateRight(p);
+                }
+                else
+                {
+                    bst<T, CMP>::rotateLeft(p);
+                }
+                return;
+            }
+            if (g->parent != nullptr) // Il nonno non è la radice: rotazioni con i puntatori
+            {
+                if ((node == p->left) == (p == g->left)) // zig-zig
+                {
+                    rotateUp(p);
+                    rotateUp(node);
+                }
+                else // zig-zag
+                {
+                    rotateUp(node);
+                    rotateUp(node);
+                }
+                continue;
+            }
+            if (node == p->left && p == g->left) // zig-zig a sinistra sotto la radice
+            {
+                bst<T, CMP>::rotateRight(g);
+                bst<T, CMP>::rotateRight(g);
+            }
+            else if (node == p->right && p == g->right) // zig-zig a destra sotto la radice
+            {
+                bst<T, CMP>::rotateLeft(g);
+                bst<T, CMP>::rotateLeft(g);
+            }
+            else if (node == p->right) // zig-zag: figlio destro di un figlio sinistro della radice
+            {
+                bst<T, CMP>::rotateLeft(p);
+                bst<T, CMP>::rotateRight(g);
+            }
+            else // zig-zag: figlio sinistro di un figlio destro della radice
+            {
+                bst<T, CMP>::rotateRight(p);
+                bst<T, CMP>::rotateLeft(g);
+            }
+            return; // Le rotazioni mantengono fissa la radice, che ora contiene la chiave cercata
+        }
+    }
+
+    /**
+     * @brief Porta nella radice un nodo raggiunto se l'accesso corrente è tra quelli scelti per lo splaying
+     *
+     * @param node è il nodo raggiunto
+     * @return puntatore al nodo che contiene la chiave di node dopo l'eventuale splaying
+     */
+    bst<T, CMP> *splayChosen(bst<T, CMP> *node)
+    {
+        if (period > 1)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            if (state % period != 0)
+            {
+                return node;
+            }
+        }
+        splay(node);
+        return this;
+    }
+
+    /**
+     * @brief Cerca una chiave e porta nella radice il nodo trovato o l'ultimo nodo visitato
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore al nodo che contiene la chiave o nullptr se la chiave non è presente
+     */
+    bst<T, CMP> *access(const T &value)
+    {
+        if (this->isEmpty())
+        {
+            return nullptr;
+        }
+        bst<T, CMP> *node{this};
+        while (true)
+        {
+            bst<T, CMP> *next;
+            if (this->cmp(value, node->key)) // I valori maggiori si trovano a destra
+            {
+                next = node->right;
+            }
+            else if (this->cmp(node->key, value)) // I valori minori si trovano a sinistra
+            {
+                next = node->left;
+            }
+            else // Chiave trovata
+            {
+                return splayChosen(node);
+            }
+            if (next == nullptr) // Chiave assente: si porta in radice l'ultimo nodo visitato
+            {
+                splayChosen(node);
+                return nullptr;
+            }
+            node = next;
+        }
+    }
+
+public:
+    /**
+     * @brief Costruttore vuoto
+     */
+    splayBst() : bst<T, CMP>(), period{1}, state{0x9e3779b9u} {}
+
+    /**
+     * @brief Costruttore con passaggio della chiave della radice
+     *
+     * @param inputKey è il riferimento al valore del nodo
+     */
+    splayBst(const T &inputKey) : bst<T, CMP>(inputKey), period{1}, state{0x9e3779b9u} {}
+
+    /**
+     * @brief Costruttore per convertire un array in uno splay tree
+     *
+     * @param array che si vuole convertire nell'albero binario di ricerca
+     * @param length è la lunghezza dell'array
+     */
+    splayBst(const T array[], uint length) : splayBst()
+    {
+        for (u_int i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    /**
+     * @brief Imposta la frequenza dello splaying
+     *
+     * @param inputPeriod è il numero medio di accessi per ogni splaying (1 per lo splaying a ogni accesso, 0 equivale a 1)
+     */
+    void setSplayPeriod(uint inputPeriod)
+    {
+        period = inputPeriod == 0 ? 1 : inputPeriod;
+    }
+
+    /**
+     * @brief Ricerca di una chiave con splaying del nodo trovato
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore al nodo che contiene la chiave (la radice se è avvenuto lo splaying) o nullptr se la chiave non è presente
+     */
+    bst<T, CMP> *find(const T &value)
+    {
+        return access(value);
+    }
+
+    /**
+     * @brief Ricerca di una chiave con splaying del nodo trovato
+     * Se la chiave non è presente nell'albero viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore al nodo che contiene la chiave cercata
+     */
+    bst<T, CMP> *const binarySearch(const T value)
+    {
+        bst<T, CMP> *node{access(value)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Inserisce un valore e porta il nuovo nodo nella radice
+     *
+     * @param value è il valore da inserire
+     * @return puntatore alla radice dell'albero
+     */
+    bst<T, CMP> *insertValue(const T &value)
+    {
+        splayChosen(this->insertNode(value));
+        return this;
+    }
+
+    /**
+     * @brief Elimina il nodo associato a una chiave
+     * Il nodo viene prima portato nella radice. Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value chiave corrispondente al nodo da eliminare
+     */
+    void deleteKey(const T &value)
+    {
+        bst<T, CMP> *node{access(value)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        bst<T, CMP>::deleteKey(node);
+    }
+};
+
+#endif
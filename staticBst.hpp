@@ -0,0 +1,211 @@
+#ifndef __staticBst_hpp__
+#define __staticBst_hpp__
+
+#include <array>
+#include <cstddef>
+#include <functional>
+
+/**
+ * @class staticBst
+ *
+ * @brief Albero binario di ricerca statico costruibile a tempo di compilazione.
+ * Le chiavi vengono ordinate e disposte in un array secondo il layout di Eytzinger: la radice è in posizione 1
+ * e i figli del nodo in posizione k sono in posizione 2k e 2k + 1. L'albero è quindi completo e bilanciato,
+ * non usa puntatori né memoria dinamica e, se dichiarato constexpr, non ha alcun costo di inizializzazione.
+ * Con una chiave costante anche le ricerche vengono valutate a tempo di compilazione:
+ *
+ * @code
+ * constexpr staticBst<uint, 4> populations{{6984, 2873000, 13960000, 8468000}};
+ * static_assert(populations.contains(2873000));
+ * @endcode
+ *
+ * Le chiavi devono essere di un tipo utilizzabile nelle espressioni costanti (per esempio non City, che contiene una std::string).
+ *
+ * @tparam T è il tipo di dato delle chiavi
+ * @tparam N è il numero di chiavi
+ * @tparam CMP è la relazione d'ordine del tipo T (relazione di "maggiore" come in bst)
+ */
+template <typename T, std::size_t N, typename CMP = std::greater<T>>
+class staticBst
+{
+    static_assert(N > 0, "staticBst richiede almeno una chiave (min() e max() leggerebbero fuori dall'array)");
+
+private:
+    std::array<T, N + 1> keys; // chiavi nel layout di Eytzinger (la posizione 0 non è utilizzata)
+    CMP cmp;                   // comparatore
+
+    /**
+     * @brief Dispone le chiavi ordinate nel layout di Eytzinger con una visita simmetrica dell'albero implicito
+     *
+     * @param sorted sono le chiavi ordinate
+     * @param next è l'indice della prossima chiave ordinata da collocare
+     * @param k è la posizione del nodo corrente
+     */
+    constexpr void fill(const std::array<T, N> &sorted, std::size_t &next, std::size_t k)
+    {
+        if (k <= N)
+        {
+            fill(sorted, next, 2 * k);
+            keys[k] = sorted[next++];
+            fill(sorted, next, 2 * k + 1);
+        }
+    }
+
+    /**
+     * @brief Costruisce l'albero da un array di chiavi non necessariamente ordinato
+     *
+     * @param input sono le chiavi da inserire
+     */
+    constexpr void build(std::array<T, N> input)
+    {
+        for (std::size_t i{1}; i < N; ++i) // Ordinamento per inserimento (std::sort non è constexpr in C++17)
+        {
+            T current{input[i]};
+            std::size_t j{i};
+            while (j > 0 && cmp(input[j - 1], current))
+            {
+                input[j] = input[j - 1];
+                --j;
+            }
+            input[j] = current;
+        }
+        std::size_t next{0};
+        fill(input, next, 1);
+    }
+
+    /**
+     * @brief Posizione della prima chiave non minore di value
+     *
+     * @param value è la chiave da cercare
+     * @return std::size_t è la posizione nel layout di Eytzinger (0 se tutte le chiavi sono minori di value)
+     */
+    constexpr std::size_t lowerBoundIndex(const T &value) const
+    {
+        std::size_t k{1};
+        while (k <= N)
+        {
+            k = 2 * k + (cmp(value, keys[k]) ? 1 : 0); // A destra se value è maggiore della chiave
+        }
+        while (k & 1) // Si annullano le ultime discese a destra: il nodo cercato è l'ultimo da cui si è scesi a sinistra
+        {
+            k >>= 1;
+        }
+        return k >> 1;
+    }
+
+public:
+    /**
+     * @brief Costruttore da std::array
+     *
+     * @param input sono le chiavi dell'albero
+     */
+    constexpr staticBst(const std::array<T, N> &input) : keys{}, cmp{}
+    {
+        build(input);
+    }
+
+    /**
+     * @brief Costruttore da array
+     *
+     * @param input sono le chiavi dell'albero
+     */
+    constexpr staticBst(const T (&input)[N]) : keys{}, cmp{}
+    {
+        std::array<T, N> copy{};
+        for (std::size_t i{0}; i < N; ++i)
+        {
+            copy[i] = input[i];
+        }
+        build(copy);
+    }
+
+    /**
+     * @brief Restituisce il numero di chiavi
+     *
+     * @return std::size_t è il numero di chiavi dell'albero
+     */
+    constexpr std::size_t size() const
+    {
+        return N;
+    }
+
+    /**
+     * @brief Ricerca della prima chiave non minore di value
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore alla chiave trovata o nullptr se tutte le chiavi sono minori di value
+     */
+    constexpr const T *lower_bound(const T &value) const
+    {
+        std::size_t k{lowerBoundIndex(value)};
+        return k == 0 ? nullptr : &keys[k];
+    }
+
+    /**
+     * @brief Ricerca di una chiave
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore alla chiave trovata o nullptr se non è presente
+     */
+    constexpr const T *find(const T &value) const
+    {
+        const T *candidate{lower_bound(value)};
+        return (candidate == nullptr || cmp(*candidate, value)) ? nullptr : candidate;
+    }
+
+    /**
+     * @brief Metodo che informa se una chiave è presente
+     *
+     * @param value è la chiave da cercare
+     * @return true se la chiave è presente
+     * @return false se la chiave non è presente
+     */
+    constexpr bool contains(const T &value) const
+    {
+        return find(value) != nullptr;
+    }
+
+    /**
+     * @brief Restituisce la chiave minima
+     *
+     * @return const T& è il riferimento alla chiave minima
+     */
+    constexpr const T &min() const
+    {
+        std::size_t k{1};
+        while (2 * k <= N)
+        {
+            k = 2 * k;
+        }
+        return keys[k];
+    }
+
+    /**
+     * @brief Restituisce la chiave massima
+     *
+     * @return const T& è il riferimento alla chiave massima
+     */
+    constexpr const T &max() const
+    {
+        std::size_t k{1};
+        while (2 * k + 1 <= N)
+        {
+            k = 2 * k + 1;
+        }
+        return keys[k];
+    }
+};
+
+/**
+ * @brief Guida alla deduzione dei parametri per la costruzione da std::array
+ */
+template <typename T, std::size_t N>
+staticBst(const std::array<T, N> &) -> staticBst<T, N>;
+
+/**
+ * @brief Guida alla deduzione dei parametri per la costruzione da array
+ */
+template <typename T, std::size_t N>
+staticBst(const T (&)[N]) -> staticBst<T, N>;
+
+#endif
@@ -0,0 +1,300 @@
+#ifndef __stringBst_hpp__
+#define __stringBst_hpp__
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bst.hpp"
+
+/**
+ * @brief Chiave di stringBst: prefisso di 8 byte normalizzato in un intero e riferimento ai byte completi
+ * Il prefisso contiene i primi 8 byte della stringa in ordine big-endian (completati con zeri), quindi il confronto
+ * tra due prefissi come interi coincide con il confronto lessicografico dei loro primi 8 byte.
+ */
+struct prefixedString
+{
+    uint64_t prefix;       // primi 8 byte della stringa
+    std::string_view text; // stringa completa
+
+    /**
+     * @brief Costruisce la chiave di una stringa senza copiarne i byte
+     *
+     * @param inputText è la stringa
+     * @return prefixedString è la chiave
+     */
+    static inline prefixedString of(std::string_view inputText)
+    {
+        unsigned char bytes[8]{};
+        if (!inputText.empty())
+        {
+            std::memcpy(bytes, inputText.data(), std::min<std::size_t>(8, inputText.size()));
+        }
+        uint64_t value{0};
+        for (unsigned char b : bytes)
+        {
+            value = (value << 8) | b;
+        }
+        return prefixedString{value, inputText};
+    }
+
+    inline bool operator==(const prefixedString &other) const
+    {
+        return prefix == other.prefix && text == other.text;
+    }
+};
+
+/**
+ * @brief Relazione d'ordine lessicografica delle chiavi prefixedString nel ruolo di std::greater
+ * I prefissi diversi decidono il confronto con un solo confronto tra interi; solo a parità di prefisso si confrontano
+ * i byte delle stringhe, a partire da quelli successivi ai primi 8 (già uguali).
+ */
+struct prefixGreater
+{
+    inline bool operator()(const prefixedString &a, const prefixedString &b) const
+    {
+        if (a.prefix != b.prefix)
+        {
+            return a.prefix > b.prefix;
+        }
+        std::size_t skip{std::min<std::size_t>({8, a.text.size(), b.text.size()})};
+        return a.text.substr(skip) > b.text.substr(skip);
+    }
+};
+
+/**
+ * @class stringBst
+ *
+ * @brief Albero binario di ricerca di stringhe in ordine lessicografico con i byte delle chiavi in un'arena.
+ * Ogni nodo contiene il prefisso normalizzato della propria stringa (vedi prefixedString) e un string_view verso l'arena
+ * dell'albero, quindi la discesa confronta quasi sempre solo interi senza accedere ai byte delle stringhe, e un inserimento
+ * non alloca memoria per la stringa: i byte vengono copiati in blocchi da 64 KiB condivisi da tutte le chiavi.
+ * I byte delle chiavi eliminate restano nell'arena fino alla distruzione dell'albero.
+ * L'albero non è copiabile, perché le chiavi della copia farebbero riferimento all'arena dell'originale. Per lo stesso
+ * motivo bst è una classe base privata: split, join, swap, release/adopt e le cancellazioni a intervalli sposterebbero
+ * in altri alberi nodi che puntano all'arena, e gli inserimenti di bst (a lotti o con suggerimento) non copierebbero i
+ * byte nell'arena. Sono pubblici solo i metodi di bst che non fanno nessuna delle due cose, e i nodi restituiti da
+ * ricerche e visite sono costanti, così da un nodo non si può chiamare insertValue() di bst.
+ */
+class stringBst : private bst<prefixedString, prefixGreater>
+{
+private:
+    using node_type = bst<prefixedString, prefixGreater>;
+
+    static const std::size_t blockBytes{1 << 16}; // dimensione di un blocco dell'arena
+
+    std::vector<std::unique_ptr<char[]>> blocks; // blocchi dell'arena
+    char *cursor;                                // primo byte libero dell'ultimo blocco
+    std::size_t available;                       // byte liberi dell'ultimo blocco
+    std::size_t reserved;                        // byte allocati per tutti i blocchi
+
+    /**
+     * @brief Copia una stringa nell'arena
+     * Le stringhe più grandi di un blocco ricevono un blocco dedicato.
+     *
+     * @param text è la stringa da copiare
+     * @return std::string_view è la copia nell'arena
+     */
+    std::string_view store(std::string_view text)
+    {
+        if (text.empty())
+        {
+            return std::string_view();
+        }
+        if (text.size() > available)
+        {
+            std::size_t size{text.size() > blockBytes ? text.size() : blockBytes};
+            blocks.emplace_back(new char[size]);
+            cursor = blocks.back().get();
+            available = size;
+            reserved += size;
+        }
+        char *copy{cursor};
+        std::memcpy(copy, text.data(), text.size());
+        cursor += text.size();
+        available -= text.size();
+        return std::string_view(copy, text.size());
+    }
+
+public:
+    using node_type::const_iterator;
+    using node_type::operator new;
+    using node_type::operator delete;
+    using node_type::getKey;
+    using node_type::getCount;
+    using node_type::isEmpty;
+    using node_type::findFrom;
+    using node_type::nodesCount;
+    using node_type::leavesCount;
+    using node_type::height;
+    using node_type::inorder;
+    using node_type::preorder;
+    using node_type::postorder;
+    using node_type::rebalance;
+    using node_type::relayout;
+    using node_type::compact;
+    using node_type::begin;
+    using node_type::end;
+    using node_type::cend;
+
+    /**
+     * @brief Costruttore vuoto
+     */
+    stringBst() : node_type(), cursor{nullptr}, available{0}, reserved{0} {}
+
+    /**
+     * @brief Costruttore per convertire un array di stringhe in un albero
+     *
+     * @param array che si vuole convertire nell'albero
+     * @param length è la lunghezza dell'array
+     */
+    stringBst(const std::string array[], uint length) : stringBst()
+    {
+        for (uint i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    stringBst(const stringBst &) = delete;
+    stringBst &operator=(const stringBst &) = delete;
+
+    /**
+     * @brief Restituisce il sottoalbero sinistro
+     * I nodi sono restituiti costanti: un inserimento fatto attraverso di essi non copierebbe i byte nell'arena.
+     *
+     * @return puntatore costante al nodo figlio sinistro
+     */
+    inline const node_type *getLeft() const
+    {
+        return node_type::getLeft();
+    }
+
+    /**
+     * @brief Restituisce il sottoalbero destro
+     *
+     * @return puntatore costante al nodo figlio destro
+     */
+    inline const node_type *getRight() const
+    {
+        return node_type::getRight();
+    }
+
+    /**
+     * @brief Restituisce il nodo con la stringa più piccola
+     *
+     * @return puntatore costante al nodo con valore minimo
+     */
+    inline const node_type *min()
+    {
+        return node_type::min();
+    }
+
+    /**
+     * @brief Restituisce il nodo con la stringa più grande
+     *
+     * @return puntatore costante al nodo con valore massimo
+     */
+    inline const node_type *max()
+    {
+        return node_type::max();
+    }
+
+    /**
+     * @brief Inserisce una stringa, copiandone i byte nell'arena
+     *
+     * @param value è la stringa da inserire
+     * @return stringBst& è l'albero stesso, così anche gli inserimenti concatenati copiano i byte nell'arena
+     */
+    stringBst &insertValue(std::string_view value)
+    {
+        node_type::insertValue(prefixedString{prefixedString::of(value).prefix, store(value)});
+        return *this;
+    }
+
+    /**
+     * @brief Ricerca di una stringa (senza copiarla)
+     *
+     * @param value è la stringa da cercare
+     * @return puntatore costante al nodo trovato o nullptr se la stringa non è presente
+     */
+    inline const node_type *find(std::string_view value) const
+    {
+        return node_type::find(prefixedString::of(value));
+    }
+
+    /**
+     * @brief Metodo che informa se una stringa è presente (senza lanciare eccezioni)
+     *
+     * @param value è la stringa da cercare
+     * @return true se la stringa è presente
+     * @return false se la stringa non è presente
+     */
+    inline bool isPresent(std::string_view value) const
+    {
+        return find(value) != nullptr;
+    }
+
+    /**
+     * @brief Ricerca di una stringa
+     * Se la stringa non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la stringa da cercare
+     * @return puntatore costante al nodo trovato
+     */
+    inline const node_type *binarySearch(std::string_view value)
+    {
+        return node_type::binarySearch(prefixedString::of(value));
+    }
+
+    /**
+     * @brief Eliminazione di un'occorrenza di una stringa (i suoi byte restano nell'arena)
+     * Se la stringa non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la stringa da eliminare
+     */
+    inline void deleteKey(std::string_view value)
+    {
+        node_type::deleteKey(prefixedString::of(value));
+    }
+
+    /**
+     * @brief Restituisce la memoria occupata dall'arena
+     *
+     * @return std::size_t è il numero di byte allocati per i blocchi
+     */
+    std::size_t arenaBytes() const
+    {
+        return reserved;
+    }
+};
+
+/**
+ * Stampa una chiave prefixedString su uno stream
+ *
+ * @param os è lo stream di output
+ * @param key è la chiave da stampare
+ * @return è il riferimento allo stream di output
+ */
+inline std::ostream &operator<<(std::ostream &os, const prefixedString &key)
+{
+    os << key.text;
+    return os;
+}
+
+/**
+ * @brief Metodo per ottenere una rappresentazione mediante stringa di una chiave prefixedString
+ *
+ * @param key è la chiave di cui si vuole ricavare una rappresentazione mediante stringa
+ * @return std::string
+ */
+inline std::string to_string(const prefixedString &key)
+{
+    return std::string(key.text);
+}
+
+#endif
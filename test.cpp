@@ -1,10 +1,138 @@
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <set>
+#include <thread>
+#include <type_traits>
+
 #include "bst.hpp"
 #include "City.hpp"
+#include "loggedBst.hpp"
+#include "augmentation.hpp"
+#include "balancedBst.hpp"
+#include "btree.hpp"
+#include "bufferedBst.hpp"
+#include "filteredBst.hpp"
+#include "indexBst.hpp"
+#include "indexedBst.hpp"
+#include "intervalTree.hpp"
+#include "lazyBst.hpp"
+#include "learnedIndex.hpp"
+#include "merkleBst.hpp"
+#include "multiBst.hpp"
+#include "projectedBst.hpp"
+#include "shardedBst.hpp"
+#include "splayBst.hpp"
+#include "staticBst.hpp"
+#include "stringBst.hpp"
+#include "vebTree.hpp"
+#include "weightedBst.hpp"
 
 void testBST_1();
 void testBST_2();
 void testBST_City();
 void testBST_Iterator();
+void testSplay();
+void testFinger();
+void testRelayout();
+void testStatic();
+void testBalanced();
+void testBuffered();
+void testWeighted();
+void testLogged();
+void testBtree();
+void testSharded();
+void testBatch();
+void testVeb();
+void testString();
+void testProjected();
+void testLazy();
+void testIndexed();
+void testMulti();
+void testErase();
+void testSplitJoin();
+void testIndex();
+void testFiltered();
+void testLearned();
+void testMerkle();
+void testAggregate();
+void testInterval();
+
+uint failures{0}; // numero di verifiche fallite
+
+/**
+ * @brief Stampa l'esito di una verifica e conta quelle fallite
+ *
+ * @param condition è la condizione da verificare
+ * @param description è la descrizione della verifica
+ */
+void check(bool condition, const std::string &description)
+{
+    std::cout << (condition ? "[OK] " : "[ERRORE] ") << description << std::endl;
+    if (!condition)
+    {
+        ++failures;
+    }
+}
+
+/**
+ * @brief Raccoglie le chiavi di un sottoalbero nell'ordine della visita simmetrica verificando i puntatori ai genitori
+ *
+ * @param node è la radice del sottoalbero
+ * @param parent è il genitore atteso della radice
+ * @param keys è il vettore in cui aggiungere le chiavi (ognuna ripetuta tante volte quante sono le sue occorrenze)
+ * @return true se tutti i puntatori ai genitori sono corretti
+ */
+template <typename T, typename CMP, typename AUG>
+bool collectKeys(const bst<T, CMP, AUG> *node, const bst<T, CMP, AUG> *parent, std::vector<T> &keys)
+{
+    if (node == nullptr)
+    {
+        return true;
+    }
+    bool linked{node->getParent() == parent && collectKeys(node->getLeft(), node, keys)};
+    keys.insert(keys.end(), node->getCount(), node->getKey());
+    return linked && collectKeys(node->getRight(), node, keys);
+}
+
+/**
+ * @brief Verifica che un albero sia ben collegato, ordinato e contenga esattamente le chiavi attese
+ *
+ * @param tree è l'albero da verificare
+ * @param expected sono le chiavi attese in qualsiasi ordine
+ * @return true se l'albero contiene le chiavi attese in ordine
+ */
+template <typename T, typename CMP, typename AUG>
+bool holds(const bst<T, CMP, AUG> &tree, std::vector<T> expected)
+{
+    std::vector<T> keys;
+    if (!tree.isEmpty() && !collectKeys(&tree, static_cast<const bst<T, CMP, AUG> *>(nullptr), keys))
+    {
+        return false;
+    }
+    CMP cmp;
+    std::sort(expected.begin(), expected.end(), [&cmp](const T &a, const T &b)
+              { return cmp(b, a); });
+    return keys == expected;
+}
+
+/**
+ * @brief Genera le chiavi 0, ..., n - 1 in ordine casuale (sempre lo stesso)
+ *
+ * @param n è il numero di chiavi
+ * @return std::vector<uint> sono le chiavi mescolate
+ */
+std::vector<uint> shuffledKeys(uint n)
+{
+    std::vector<uint> keys(n);
+    for (uint i{0}; i < n; ++i)
+    {
+        keys[i] = i;
+    }
+    std::mt19937 gen(n);
+    std::shuffle(keys.begin(), keys.end(), gen);
+    return keys;
+}
 
 /**
  * @brief Programma di prova per testare la classe bst
@@ -13,6 +141,34 @@ void testBST_Iterator();
  * 2 - testBST_2() per creare un albero binario di interi, visualizzarlo graficamente ed eliminare un nodo
  * 3 - testBST_City() per creare un albero binario di città
  * 4 - testBST_Iterator() per sfruttare gli iteratori nella lettura di un albero
+ *
+ * Le funzioni successive verificano il comportamento delle varianti dell'albero con check(); il programma termina
+ * con un codice diverso da zero se almeno una verifica fallisce (ctest esegue il programma):
+ * 5 - testSplay() per splayBst
+ * 6 - testFinger() per bst::insertValue(hint, value) e bst::findFrom()
+ * 7 - testRelayout() per bst::relayout() e bst::compact()
+ * 8 - testStatic() per staticBst
+ * 9 - testBalanced() per balancedBst (numero di nodi e limite di altezza dopo ogni operazione)
+ * 10 - testBuffered() per bufferedBst (ricerche e conteggi con operazioni in attesa)
+ * 11 - testWeighted() per weightedBst (contatori degli accessi e ricostruzione ottima)
+ * 12 - testLogged() per loggedBst (ripristino dal log, dall'istantanea e dopo un record incompleto)
+ * 13 - testBtree() per btree (stesse chiavi di bst, visite complete con cend())
+ * 14 - testSharded() per shardedBst (inserimenti concorrenti e spostamento delle chiavi di bordo)
+ * 15 - testBatch() per bst::insertBatch() e balancedBst::insertBatch()
+ * 16 - testVeb() per vebTree (cluster ad array ordinato e a bitmap, successor() e predecessor())
+ * 17 - testString() per stringBst (ordine lessicografico, arena e cancellazioni)
+ * 18 - testProjected() per projectedBst (valori nell'array parallelo e posizioni riutilizzate)
+ * 19 - testLazy() per lazyBst (tombstone, ricostruzione dei sottoalberi e rebuild())
+ * 20 - testIndexed() per indexedBst (indice hash, cancellazioni e chiavi con gli stessi bit bassi)
+ * 21 - testMulti() per multiBst (occorrenze nei nodi e iteratore con i duplicati espansi)
+ * 22 - testErase() per eraseRange(), erase() ed eraseIf() di bst
+ * 23 - testSplitJoin() per split() e join() di bst e balancedBst
+ * 24 - testIndex() per indexBst (visite con e senza indice del genitore, ricerche e iteratori di find())
+ * 25 - testFiltered() per filteredBst (falsi positivi del filtro e cancellazioni)
+ * 26 - testLearned() per learnedIndex (lower_bound(), contains() ed errore massimo dei modelli)
+ * 27 - testMerkle() per merkleBst (hash indipendente dalla forma e diff() con chiavi ripetute)
+ * 28 - testAggregate() per gli aumenti di bst (aggregate() su intervalli dopo inserimenti, cancellazioni e rotazioni)
+ * 29 - testInterval() per intervalBst (overlaps() e stabbing() confrontati con una ricerca lineare)
  */
 int main()
 {
@@ -29,7 +185,34 @@ int main()
     }
     // testBST_Iterator();
 
-    return 0;
+    testSplay();
+    testFinger();
+    testRelayout();
+    testStatic();
+    testBalanced();
+    testBuffered();
+    testWeighted();
+    testLogged();
+    testBtree();
+    testSharded();
+    testBatch();
+    testVeb();
+    testString();
+    testProjected();
+    testLazy();
+    testIndexed();
+    testMulti();
+    testErase();
+    testSplitJoin();
+    testIndex();
+    testFiltered();
+    testLearned();
+    testMerkle();
+    testAggregate();
+    testInterval();
+
+    std::cout << (failures == 0 ? "Tutte le verifiche sono riuscite" : "Verifiche fallite: " + std::to_string(failures)) << std::endl;
+    return failures == 0 ? 0 : 1;
 }
 
 void testBST_1()
@@ -128,6 +311,1367 @@ void testBST_Iterator()
               << bst_example << std::endl;
 }
 
+void testSplay()
+{
+    std::vector<uint> keys{shuffledKeys(2000)};
+    splayBst<uint> tree(keys.data(), keys.size());
+    check(holds(tree, keys), "splayBst: inserimenti");
+
+    bool found{true};
+    for (uint k : keys)
+    {
+        const bst<uint> *node{tree.find(k)};
+        found = found && node != nullptr && node->getKey() == k;
+    }
+    check(found && tree.find(5000) == nullptr && holds(tree, keys), "splayBst: find() di chiavi presenti e assenti");
+
+    uint hot{keys[1234]};
+    const bst<uint> *node{tree.find(hot)};
+    check(node == &tree && tree.getKey() == hot && holds(tree, keys), "splayBst: find() porta la chiave cercata nella radice");
+    tree.find(5000);
+    check(tree.getKey() == 1999 && holds(tree, keys), "splayBst: una ricerca senza successo porta nella radice l'ultimo nodo visitato");
+
+    splayBst<uint> sampled(keys.data(), keys.size());
+    sampled.setSplayPeriod(16);
+    for (uint i{0}; i < 200; ++i)
+    {
+        sampled.find(hot);
+    }
+    check(sampled.getKey() == hot && holds(sampled, keys), "splayBst: con splaying randomizzato una chiave calda raggiunge la radice");
+
+    for (uint i{0}; i < 1000; ++i)
+    {
+        tree.deleteKey(keys.back());
+        keys.pop_back();
+    }
+    check(holds(tree, keys), "splayBst: deleteKey()");
+}
+
+/**
+ * @brief Relazione d'ordine di "maggiore" che conta i confronti eseguiti (un confronto per nodo visitato)
+ */
+struct countingGreater
+{
+    static inline std::size_t comparisons{0};
+
+    bool operator()(uint a, uint b) const
+    {
+        ++comparisons;
+        return a > b;
+    }
+};
+
+void testFinger()
+{
+    const uint n{4000};
+    std::vector<uint> keys;
+    bst<uint, countingGreater> sorted;
+    bst<uint, countingGreater>::const_iterator it;
+    countingGreater::comparisons = 0;
+    for (uint i{0}; i < n; ++i)
+    {
+        it = sorted.insertValue(it, i);
+        keys.push_back(i);
+    }
+    std::size_t comparisons{countingGreater::comparisons};
+    check(holds(sorted, keys) && comparisons <= 2 * n, "finger: inserimento ordinato con hint in O(1) confronti per chiave");
+
+    countingGreater::comparisons = 0;
+    bool found{true};
+    it = bst<uint, countingGreater>::const_iterator{};
+    for (uint i{0}; i < n; ++i)
+    {
+        it = sorted.findFrom(it, i);
+        found = found && it != bst<uint, countingGreater>::const_iterator{} && it->getKey() == i;
+    }
+    check(found && countingGreater::comparisons <= 6 * n, "finger: ricerche ordinate con findFrom() in O(1) confronti per chiave");
+
+    bst<uint, countingGreater> interleaved; // Chiavi pari in un albero bilanciato, poi le dispari in ordine
+    for (uint k : shuffledKeys(n))
+    {
+        interleaved.insertValue(2 * k);
+        keys[k] = 2 * k;
+    }
+    interleaved.rebalance();
+    countingGreater::comparisons = 0;
+    it = bst<uint, countingGreater>::const_iterator{};
+    for (uint i{0}; i < n; ++i)
+    {
+        it = interleaved.insertValue(it, 2 * i + 1);
+        keys.push_back(2 * i + 1);
+    }
+    comparisons = countingGreater::comparisons;
+    check(holds(interleaved, keys) && comparisons <= 8 * n, "finger: inserimento ordinato tra chiavi esistenti con hint");
+
+    countingGreater::comparisons = 0;
+    found = true;
+    it = interleaved.begin();
+    for (uint i{0}; i < 2 * n; ++i)
+    {
+        it = interleaved.findFrom(it, i);
+        found = found && it != bst<uint, countingGreater>::const_iterator{} && it->getKey() == i;
+    }
+    found = found && interleaved.findFrom(it, 2 * n) == bst<uint, countingGreater>::const_iterator{};
+    check(found && countingGreater::comparisons <= 8 * 2 * n, "finger: ricerche ordinate con findFrom() in un albero bilanciato");
+
+    bst<uint> clustered; // Hint arbitrari: il risultato deve coincidere con gli inserimenti dalla radice
+    bst<uint> reference;
+    std::vector<uint> values{shuffledKeys(300)};
+    bst<uint>::const_iterator hint;
+    for (uint i{0}; i < values.size(); ++i)
+    {
+        uint v{values[i] / 3}; // Chiavi ripetute
+        hint = clustered.insertValue(i % 7 == 0 ? clustered.begin() : hint, v);
+        reference.insertValue(v);
+        values[i] = v;
+    }
+    check(holds(clustered, values) && clustered.height() == reference.height(), "finger: inserimenti con hint qualsiasi e chiavi ripetute");
+}
+
+/**
+ * @brief Raccoglie le chiavi di un albero in ordine anticipato, che insieme alla visita simmetrica ne descrive la forma
+ *
+ * @param node è la radice del sottoalbero
+ * @param keys è il vettore in cui aggiungere le chiavi
+ */
+template <typename T, typename CMP, typename AUG>
+void collectPreorder(const bst<T, CMP, AUG> *node, std::vector<T> &keys)
+{
+    if (node != nullptr)
+    {
+        keys.push_back(node->getKey());
+        collectPreorder(node->getLeft(), keys);
+        collectPreorder(node->getRight(), keys);
+    }
+}
+
+/**
+ * @brief Aggiunge al vettore i nodi di un sottoalbero che si trovano a una certa profondità, da sinistra a destra
+ *
+ * @param node è la radice del sottoalbero
+ * @param depth è la profondità dei nodi da aggiungere
+ * @param nodes è il vettore in cui aggiungere i nodi
+ */
+template <typename T, typename CMP, typename AUG>
+void collectAtDepth(const bst<T, CMP, AUG> *node, uint depth, std::vector<const bst<T, CMP, AUG> *> &nodes)
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+    if (depth == 0)
+    {
+        nodes.push_back(node);
+        return;
+    }
+    collectAtDepth(node->getLeft(), depth - 1, nodes);
+    collectAtDepth(node->getRight(), depth - 1, nodes);
+}
+
+/**
+ * @brief Aggiunge al vettore i nodi di un sottoalbero nell'ordine di van Emde Boas: prima il sottoalbero superiore
+ * con levels/2 livelli, poi da sinistra a destra i sottoalberi inferiori con i livelli restanti
+ *
+ * @param node è la radice del sottoalbero
+ * @param levels è il numero di livelli del sottoalbero
+ * @param nodes è il vettore in cui aggiungere i nodi
+ */
+template <typename T, typename CMP, typename AUG>
+void collectVeb(const bst<T, CMP, AUG> *node, uint levels, std::vector<const bst<T, CMP, AUG> *> &nodes)
+{
+    if (levels == 1)
+    {
+        nodes.push_back(node);
+        return;
+    }
+    uint top{levels / 2};
+    collectVeb(node, top, nodes);
+    std::vector<const bst<T, CMP, AUG> *> bottoms;
+    collectAtDepth(node, top, bottoms);
+    for (const bst<T, CMP, AUG> *bottom : bottoms)
+    {
+        collectVeb(bottom, levels - top, nodes);
+    }
+}
+
+void testRelayout()
+{
+    using sumTree = bst<uint, std::greater<uint>, monoidAugmentation<uint, keyProjection, sumMonoid<uint64_t>>>;
+    for (layoutOrder order : {layoutOrder::inorder, layoutOrder::vanEmdeBoas})
+    {
+        std::string name{order == layoutOrder::inorder ? "relayout(inorder)" : "relayout(vanEmdeBoas)"};
+        sumTree tree;
+        std::vector<uint> keys;
+        std::vector<uint> values{shuffledKeys(3000)};
+        for (uint v : values)
+        {
+            tree.insertValue(v % 1000); // Chiavi ripetute
+        }
+        for (uint i{0}; i < values.size(); ++i) // Frammentazione: cancellazioni e reinserimenti alternati
+        {
+            if (i % 3 == 0)
+            {
+                tree.deleteKey(values[i] % 1000);
+            }
+            else
+            {
+                keys.push_back(values[i] % 1000);
+            }
+        }
+        std::vector<uint> shape, reshaped;
+        collectPreorder(&tree, shape);
+        std::vector<const sumTree *> before;
+        for (sumTree::const_iterator it{tree.begin()}; it != sumTree::const_iterator{}; ++it)
+        {
+            before.push_back(&*it);
+        }
+        uint64_t total{tree.aggregate()}, range{tree.aggregate(100, 199)};
+
+        tree.relayout(order);
+        collectPreorder(&tree, reshaped);
+        std::vector<const sumTree *> after;
+        for (sumTree::const_iterator it{tree.begin()}; it != sumTree::const_iterator{}; ++it)
+        {
+            after.push_back(&*it);
+        }
+        std::vector<const sumTree *> expected{after}; // Nodi nell'ordine richiesto
+        if (order == layoutOrder::vanEmdeBoas)
+        {
+            expected.clear();
+            collectVeb<uint>(&tree, tree.height(), expected);
+        }
+        bool increasing{expected.size() == after.size()};
+        const sumTree *previous{nullptr};
+        for (const sumTree *node : expected)
+        {
+            if (node != &tree) // La radice resta al suo posto
+            {
+                increasing = increasing && (previous == nullptr || std::less<const sumTree *>()(previous, node));
+                previous = node;
+            }
+        }
+        std::sort(before.begin(), before.end());
+        std::sort(after.begin(), after.end());
+        check(holds(tree, keys) && shape == reshaped && before == after, name + ": stessa forma e stessi nodi");
+        check(increasing && tree.aggregate() == total && tree.aggregate(100, 199) == range,
+              name + ": indirizzi nell'ordine richiesto e aumenti corretti");
+    }
+
+    using pool = nodePool<sizeof(bst<long double>), alignof(bst<long double>)>;
+    std::size_t reserved{0};
+    {
+        bst<long double> tree;
+        for (uint k : shuffledKeys(300000))
+        {
+            tree.insertValue(k);
+        }
+        reserved = pool::instance().reservedSlots();
+    }
+    check(reserved >= 300000 && pool::instance().reservedSlots() <= reserved / 4,
+          "nodePool: i chunk tornati interamente liberi vengono restituiti al sistema");
+}
+
+void testStatic()
+{
+    constexpr staticBst<uint, 4> populations{{6984, 2873000, 13960000, 8468000}};
+    static_assert(populations.contains(2873000) && !populations.contains(1), "ricerca a tempo di compilazione");
+    static_assert(populations.min() == 6984 && populations.max() == 13960000, "estremi a tempo di compilazione");
+
+    std::array<uint, 7> values{};
+    std::vector<uint> keys{shuffledKeys(7)};
+    std::copy(keys.begin(), keys.end(), values.begin());
+    staticBst<uint, 7> tree{values};
+    bool found{true};
+    for (uint k : keys)
+    {
+        found = found && tree.contains(k) && *tree.find(k) == k;
+    }
+    check(found && !tree.contains(7) && tree.min() == 0 && tree.max() == 6, "staticBst: ricerche, minimo e massimo");
+
+    constexpr staticBst<uint, 1> single{{42}};
+    static_assert(single.min() == 42 && single.max() == 42, "albero con una sola chiave");
+}
+
+/**
+ * @brief Verifica che un albero bilanciato contenga le chiavi attese, ne conosca il numero e rispetti il limite 2·log₂(n) + 1
+ *
+ * @param tree è l'albero da verificare
+ * @param expected sono le chiavi attese
+ * @return true se l'albero è corretto
+ */
+bool balancedHolds(const balancedBst<uint> &tree, const std::vector<uint> &expected)
+{
+    return holds(tree, expected) && tree.nodesCount() == expected.size() && tree.height() <= 2 * log2(expected.size() + 1) + 1;
+}
+
+/**
+ * @brief Genera le chiavi comprese in un intervallo [first, last)
+ *
+ * @param first è la prima chiave
+ * @param last è la chiave successiva all'ultima
+ * @return std::vector<uint> sono le chiavi in ordine
+ */
+std::vector<uint> keyRange(uint first, uint last)
+{
+    std::vector<uint> keys;
+    for (uint k{first}; k < last; ++k)
+    {
+        keys.push_back(k);
+    }
+    return keys;
+}
+
+void testBalanced()
+{
+    balancedBst<uint> sorted;
+    for (uint k{0}; k < 1000; ++k)
+    {
+        sorted.insertValue(k);
+    }
+    check(balancedHolds(sorted, keyRange(0, 1000)), "balancedBst: inserimento ordinato entro il limite di altezza");
+
+    balancedBst<uint> small;
+    for (uint k : shuffledKeys(100))
+    {
+        small.insertValue(k);
+    }
+    check(small.eraseRange(0, 89) == 90 && balancedHolds(small, keyRange(90, 100)), "balancedBst: eraseRange() aggiorna il numero di nodi");
+
+    std::pair<balancedBst<uint>, balancedBst<uint>> halves{sorted.split(500)};
+    check(sorted.nodesCount() == 0 && balancedHolds(halves.first, keyRange(0, 500)) && balancedHolds(halves.second, keyRange(500, 1000)),
+          "balancedBst: split() a metà");
+    balancedBst<uint> joined{balancedBst<uint>::join(std::move(halves.first), std::move(halves.second))};
+    check(halves.first.nodesCount() == 0 && balancedHolds(joined, keyRange(0, 1000)), "balancedBst: join() di due metà");
+
+    std::pair<balancedBst<uint>, balancedBst<uint>> uneven{joined.split(990)};
+    check(balancedHolds(uneven.first, keyRange(0, 990)) && balancedHolds(uneven.second, keyRange(990, 1000)), "balancedBst: split() sbilanciato");
+    balancedBst<uint> tail{balancedBst<uint>::join(std::move(uneven.second), 2000, balancedBst<uint>{})};
+    balancedBst<uint> rejoined{balancedBst<uint>::join(std::move(uneven.first), std::move(tail))};
+    std::vector<uint> keys{keyRange(0, 1000)};
+    keys.push_back(2000);
+    check(balancedHolds(rejoined, keys), "balancedBst: join() di alberi di dimensioni diverse e con pivot");
+
+    std::vector<uint> odd;
+    balancedBst<uint>::const_iterator hint;
+    for (uint k{0}; k < 1000; ++k)
+    {
+        hint = rejoined.insertValue(hint, 2001 + 2 * k);
+        keys.push_back(2001 + 2 * k);
+        odd.push_back(2001 + 2 * k);
+    }
+    check(balancedHolds(rejoined, keys), "balancedBst: inserimenti ordinati con hint");
+    check(rejoined.eraseIf([](uint k)
+                           { return k <= 2000; }) == 1001 &&
+              balancedHolds(rejoined, odd),
+          "balancedBst: eraseIf() aggiorna il numero di nodi e ribilancia");
+    balancedBst<uint>::const_iterator last{rejoined.findFrom(balancedBst<uint>::const_iterator{}, 2001 + 2 * 900)};
+    check(rejoined.erase(rejoined.begin(), last) == 900 && balancedHolds(rejoined, std::vector<uint>(odd.begin() + 900, odd.end())),
+          "balancedBst: erase() tra due iteratori");
+}
+
+/**
+ * @brief Vale true se dal risultato di insertValue() si può chiamare di nuovo insertValue() su un nodo, scavalcando l'albero
+ *
+ * @tparam TREE è il tipo dell'albero
+ * @tparam KEY è il tipo delle chiavi passate all'albero
+ * @tparam NODE_KEY è il tipo delle chiavi passate al nodo (quello della classe base bst)
+ */
+template <typename TREE, typename KEY, typename NODE_KEY = KEY, typename = void>
+struct insertEscapes : std::false_type
+{
+};
+
+template <typename TREE, typename KEY, typename NODE_KEY>
+struct insertEscapes<TREE, KEY, NODE_KEY, std::void_t<decltype(std::declval<TREE &>().insertValue(std::declval<KEY>())->insertValue(std::declval<NODE_KEY>()))>>
+    : std::true_type
+{
+};
+
+/**
+ * @brief Vale true se un nodo raggiunto con find() e getLeft() permette di inserire chiavi, scavalcando l'albero
+ *
+ * @tparam TREE è il tipo dell'albero
+ * @tparam KEY è il tipo delle chiavi passate all'albero
+ * @tparam NODE_KEY è il tipo delle chiavi passate al nodo (quello della classe base bst)
+ */
+template <typename TREE, typename KEY, typename NODE_KEY = KEY, typename = void>
+struct findEscapes : std::false_type
+{
+};
+
+template <typename TREE, typename KEY, typename NODE_KEY>
+struct findEscapes<TREE, KEY, NODE_KEY, std::void_t<decltype(std::declval<TREE &>().find(std::declval<KEY>())->getLeft()->insertValue(std::declval<NODE_KEY>()))>>
+    : std::true_type
+{
+};
+
+void testBuffered()
+{
+    bufferedBst<uint> tree(64);
+    for (uint k{0}; k < 10; ++k)
+    {
+        tree.insertValue(k);
+    }
+    check(tree.pending() == 10 && tree.nodesCount() == 10 && tree.isPresent(3), "bufferedBst: conteggio e presenza con inserimenti in attesa");
+    bufferedBst<uint>::const_iterator it;
+    check(tree.find(3) != nullptr && tree.find(3)->getKey() == 3 && tree.find(10) == nullptr, "bufferedBst: find() di una chiave in attesa");
+
+    for (uint k{10}; k < 30; ++k)
+    {
+        tree.insertValue(k);
+    }
+    tree.flush();
+    tree.deleteKey(5);
+    tree.deleteKey(7);
+    tree.insertValue(40);
+    bool threw{false};
+    try
+    {
+        tree.binarySearch(5);
+    }
+    catch (const NonExistingValueException &e)
+    {
+        threw = true;
+    }
+    check(threw && tree.find(7) == nullptr && !tree.isPresent(5) && tree.binarySearch(40)->getKey() == 40 && tree.nodesCount() == 29,
+          "bufferedBst: ricerche e conteggio con cancellazioni in attesa");
+
+    tree.deleteKey(6);
+    tree.insertValue(50);
+    std::vector<uint> keys;
+    check(tree.eraseRange(20, 29) == 10 && tree.nodesCount() == 19, "bufferedBst: eraseRange() applica prima i buffer");
+    tree.deleteKey(8);
+    tree.insertValue(60);
+    check(tree.eraseIf([](uint k)
+                       { return k % 10 == 0; }) == 5 &&
+              tree.pending() == 0,
+          "bufferedBst: eraseIf() applica prima i buffer");
+    tree.deleteKey(9);
+    for (it = tree.begin(); it != bufferedBst<uint>::const_iterator{}; ++it)
+    {
+        keys.push_back(it->getKey());
+    }
+    check(keys == std::vector<uint>{1, 2, 3, 4, 11, 12, 13, 14, 15, 16, 17, 18, 19} && tree.nodesCount() == 13 && tree.height() >= 4,
+          "bufferedBst: visita con gli iteratori dopo le operazioni in attesa");
+
+    bufferedBst<uint> single(16);
+    single.insertValue(1).insertValue(2); // Inserimenti concatenati: passano entrambi dal buffer
+    single.flush();
+    single.deleteKey(1);
+    single.deleteKey(2);
+    check(single.isEmpty() && single.pending() == 2 && !insertEscapes<bufferedBst<uint>, uint>::value && !findEscapes<bufferedBst<uint>, uint>::value,
+          "bufferedBst: isEmpty() con tutte le chiavi in attesa di cancellazione e nodi costanti");
+
+    bufferedBst<uint> duplicates(1 << 20);
+    std::multiset<uint> expected;
+    for (uint k : shuffledKeys(4000))
+    {
+        duplicates.insertValue(k % 300); // Chiavi ripetute, con occorrenze in entrambi i sottoalberi dopo rebalance()
+        expected.insert(k % 300);
+    }
+    duplicates.rebalance();
+    std::mt19937 gen(5);
+    for (uint i{0}; i < 2500; ++i)
+    {
+        uint k{uint(gen() % 300)};
+        if (expected.count(k) > 0)
+        {
+            duplicates.deleteKey(k);
+            expected.erase(expected.find(k));
+        }
+    }
+    bool pendingBeforeFlush{duplicates.pending() > 2000};
+    duplicates.flush();
+    keys.clear();
+    for (it = duplicates.begin(); it != bufferedBst<uint>::const_iterator{}; ++it)
+    {
+        keys.push_back(it->getKey());
+    }
+    check(pendingBeforeFlush && keys == std::vector<uint>(expected.begin(), expected.end()),
+          "bufferedBst: flush() applica in una sola visita un lotto di cancellazioni con duplicati");
+}
+
+void testWeighted()
+{
+    weightedBst<uint> tree;
+    std::vector<uint> keys{shuffledKeys(200)};
+    for (uint k : keys)
+    {
+        tree.insertValue(k);
+    }
+    for (uint i{0}; i < 1000; ++i) // Chiave 17 molto frequente, le chiavi 100-109 meno frequenti
+    {
+        tree.find(17);
+        tree.find(100 + i % 10);
+    }
+    tree.find(1000); // Le ricerche senza esito non registrano accessi
+    tree.recordAccess(150, 500);
+    std::pair<double, double> cost{tree.rebuildOptimal()};
+    check(holds(tree, keys) && tree.getKey() == 17 && cost.second < cost.first && cost.second < 3, "weightedBst: ricostruzione ottima con i contatori registrati");
+
+    tree.clearAccesses();
+    check(tree.expectedCost() == 0 && tree.binarySearch(17) == &tree && tree.expectedCost() == 1,
+          "weightedBst: azzeramento dei contatori");
+}
+
+/**
+ * @brief Raccoglie le chiavi di un albero visitandolo con i suoi iteratori fino all'iteratore vuoto
+ *
+ * @tparam TREE è il tipo dell'albero
+ * @param tree è l'albero da visitare
+ * @return std::vector<uint> sono le chiavi in ordine
+ */
+template <typename TREE>
+std::vector<uint> iteratedKeys(TREE &tree)
+{
+    std::vector<uint> keys;
+    for (typename TREE::const_iterator it{tree.begin()}; it != typename TREE::const_iterator{}; ++it)
+    {
+        keys.insert(keys.end(), it->getCount(), it->getKey());
+    }
+    return keys;
+}
+
+void testLogged()
+{
+    const std::string path{"/tmp/bstTest." + std::to_string(::getpid())};
+    auto clean{[&path]()
+               {
+                   for (uint g{0}; g < 4; ++g)
+                   {
+                       std::remove((path + ".log." + std::to_string(g)).c_str());
+                   }
+                   std::remove((path + ".snapshot").c_str());
+               }};
+    clean();
+    std::vector<uint> keys;
+    {
+        loggedBst<uint> tree(path, syncPolicy::never, 256);
+        for (uint k : shuffledKeys(100))
+        {
+            tree.insertValue(k % 60); // Chiavi ripetute
+        }
+        tree.deleteKey(5);
+        tree.remove(tree.find(30));
+        tree.insertValue(200).insertValue(201); // Inserimenti concatenati: passano entrambi dal log
+        keys = iteratedKeys(tree);
+    }
+    loggedBst<uint> *recovered{new loggedBst<uint>(path)};
+    check(keys.size() < 101 && iteratedKeys(*recovered) == keys, "loggedBst: ripristino dal log");
+    check(recovered->isPresent(200) && recovered->isPresent(201), "loggedBst: gli inserimenti concatenati sono registrati");
+    check(insertEscapes<bst<uint>, uint>::value && findEscapes<bst<uint>, uint>::value &&
+              !insertEscapes<loggedBst<uint>, uint>::value && !findEscapes<loggedBst<uint>, uint>::value,
+          "loggedBst: i nodi restituiti non permettono modifiche che scavalcano il log");
+
+    recovered->checkpoint();
+    recovered->insertValue(1000);
+    recovered->deleteKey(keys.front());
+    bool snapshot{recovered->waitCheckpoint()};
+    keys = iteratedKeys(*recovered);
+    delete recovered;
+    {
+        loggedBst<uint> tree(path);
+        check(snapshot && tree.logGeneration() == 1 && iteratedKeys(tree) == keys, "loggedBst: ripristino dall'istantanea e dal log successivo");
+    }
+
+    {
+        std::ofstream torn(path + ".log.1", std::ios::binary | std::ios::app); // Record incompleto di una scrittura interrotta
+        torn << "I12";
+    }
+    {
+        loggedBst<uint> tree(path);
+        bool recoveredKeys{iteratedKeys(tree) == keys};
+        tree.insertValue(2000);
+        keys.push_back(2000);
+        check(recoveredKeys, "loggedBst: un record incompleto in coda al log viene scartato");
+    }
+    {
+        loggedBst<uint> tree(path);
+        check(iteratedKeys(tree) == keys, "loggedBst: i record scritti dopo quello incompleto vengono ripristinati");
+    }
+    clean();
+}
+
+/**
+ * @brief Raccoglie le chiavi di un albero di qualsiasi tipo visitandolo da begin() a cend()
+ *
+ * @tparam TREE è il tipo dell'albero (bst, btree o vebTree)
+ * @param tree è l'albero da visitare
+ * @return std::vector<uint> sono le chiavi in ordine
+ */
+template <typename TREE>
+std::vector<uint> visitedKeys(TREE &tree)
+{
+    std::vector<uint> keys;
+    for (typename TREE::const_iterator it{tree.begin()}; it != tree.cend(); ++it)
+    {
+        keys.push_back(it->getKey());
+    }
+    return keys;
+}
+
+void testBtree()
+{
+    bst<uint> reference;
+    btree<uint, std::greater<uint>, 64> tree; // Nodi piccoli: anche 2000 chiavi producono più livelli
+    std::vector<uint> keys;
+    for (uint k : shuffledKeys(2000))
+    {
+        reference.insertValue(k % 1500); // Chiavi ripetute
+        tree.insertValue(k % 1500);
+        keys.push_back(k % 1500);
+    }
+    std::sort(keys.begin(), keys.end());
+    check(visitedKeys(reference) == keys && visitedKeys(tree) == keys && tree.nodesCount() == keys.size() && tree.height() > 1,
+          "btree: la visita fino a cend() restituisce le stesse chiavi di bst");
+    check(reference.end()->getKey() == 1499 && tree.end() == tree.cend() && (--tree.end())->getKey() == 1499,
+          "btree: end() segue il massimo, mentre bst::end() è il massimo");
+
+    for (uint k{0}; k < 1500; k += 3)
+    {
+        reference.deleteKey(k);
+        tree.deleteKey(k);
+        keys.erase(std::find(keys.begin(), keys.end(), k));
+    }
+    bool found{true};
+    for (uint k{0}; k < 1500; ++k)
+    {
+        found = found && tree.isPresent(k) == std::binary_search(keys.begin(), keys.end(), k);
+    }
+    check(found && visitedKeys(reference) == keys && visitedKeys(tree) == keys && tree.min()->getKey() == keys.front() && tree.max()->getKey() == keys.back(),
+          "btree: cancellazioni di una sola occorrenza, ricerche, min e max");
+
+    bool thrown{false};
+    try
+    {
+        tree.binarySearch(3000);
+    }
+    catch (const NonExistingValueException &e)
+    {
+        thrown = true;
+    }
+    check(thrown && tree.find(3000) == nullptr, "btree: ricerca di una chiave assente");
+
+    bst<uint> descending; // La radice è il massimo e non ha figlio destro
+    for (uint k{3}; k > 0; --k)
+    {
+        descending.insertValue(k);
+    }
+    check(visitedKeys(descending) == std::vector<uint>{1, 2, 3}, "bst: la visita fino a cend() termina anche se la radice è il massimo");
+}
+
+void testSharded()
+{
+    const uint n{40000};
+    shardedBst<uint> tree(8);
+    std::vector<std::thread> workers;
+    for (uint t{0}; t < 4; ++t) // Chiavi crescenti: finiscono tutte nell'ultimo shard, che deve cedere le chiavi di bordo
+    {
+        workers.emplace_back([&tree, t]()
+                             {
+                                 for (uint k{t}; k < n; k += 4)
+                                 {
+                                     tree.insertValue(k);
+                                     if (k % 10 == 0)
+                                     {
+                                         tree.deleteKey(k);
+                                     }
+                                 }
+                             });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    std::vector<uint> keys;
+    for (uint k{0}; k < n; ++k)
+    {
+        if (k % 10 != 0)
+        {
+            keys.push_back(k);
+        }
+    }
+    std::vector<uint> visited;
+    for (shardedBst<uint>::const_iterator it{tree.begin()}; it != tree.end(); ++it)
+    {
+        visited.push_back(it->getKey());
+    }
+    std::vector<std::size_t> sizes{tree.shardSizes()};
+    check(visited == keys && tree.nodesCount() == keys.size(), "shardedBst: inserimenti e cancellazioni da più thread");
+    check(*std::max_element(sizes.begin(), sizes.end()) <= 2 * keys.size() / sizes.size() + 4096 && *std::min_element(sizes.begin(), sizes.end()) > 0,
+          "shardedBst: con chiavi crescenti le chiavi di bordo passano agli shard precedenti");
+    check(tree.isPresent(n - 1) && !tree.isPresent(n - 10) && tree.find(n + 1) == nullptr && tree.binarySearch(1)->getKey() == 1,
+          "shardedBst: ricerche dopo gli spostamenti");
+
+    tree.rebalance();
+    sizes = tree.shardSizes();
+    visited.clear();
+    for (shardedBst<uint>::const_iterator it{tree.begin()}; it != tree.end(); ++it)
+    {
+        visited.push_back(it->getKey());
+    }
+    check(visited == keys && *std::max_element(sizes.begin(), sizes.end()) - *std::min_element(sizes.begin(), sizes.end()) <= 1,
+          "shardedBst: rebalance() divide le chiavi in parti uguali");
+}
+
+void testBatch()
+{
+    std::mt19937 gen(7);
+    std::vector<uint> keys;
+    bst<uint> tree;
+    for (uint round{0}; round < 3; ++round) // Lotti più grandi di bst::parallelMinimum: il lavoro viene diviso in compiti
+    {
+        std::vector<uint> batch(40000);
+        for (uint &k : batch)
+        {
+            k = gen() % 60000; // Chiavi ripetute, anche tra un lotto e l'altro
+        }
+        tree.insertBatch(batch.begin(), batch.end(), 8);
+        keys.insert(keys.end(), batch.begin(), batch.end());
+    }
+    check(holds(tree, keys), "bst: insertBatch() in un albero vuoto e in un albero esistente");
+
+    balancedBst<uint> balanced;
+    std::vector<uint> ascending{keyRange(0, 20000)};
+    balanced.insertBatch(ascending.begin(), ascending.end(), 4);
+    bool held{balancedHolds(balanced, ascending)};
+    for (uint round{0}; round < 50; ++round) // Lotti piccoli concentrati sopra il massimo: allungano un solo cammino
+    {
+        std::vector<uint> batch{keyRange(20000 + 40 * round, 20000 + 40 * (round + 1))};
+        balanced.insertBatch(batch.begin(), batch.end());
+        ascending.insert(ascending.end(), batch.begin(), batch.end());
+        held = held && balancedHolds(balanced, ascending);
+    }
+    check(held, "balancedBst: insertBatch() aggiorna il numero di nodi e rispetta il limite di altezza");
+}
+
+void testVeb()
+{
+    std::mt19937 gen(11);
+    vebTree<uint> tree;
+    std::vector<uint> keys;
+    for (uint i{0}; i < 20000; ++i) // Chiavi sparse nell'universo e un blocco denso che riempie la bitmap di un cluster
+    {
+        uint k{i < 10000 ? uint(gen()) : (7u << 16) | uint(gen() % 12000)};
+        tree.insertValue(k);
+        keys.push_back(k);
+    }
+    std::sort(keys.begin(), keys.end());
+    bool neighbours{true};
+    for (uint i{0}; i < 2000; ++i)
+    {
+        uint probe{i % 2 == 0 ? uint(gen()) : (7u << 16) | uint(gen() % 13000)};
+        auto above{std::upper_bound(keys.begin(), keys.end(), probe)};
+        auto below{std::lower_bound(keys.begin(), keys.end(), probe)};
+        neighbours = neighbours && tree.isPresent(probe) == std::binary_search(keys.begin(), keys.end(), probe) &&
+                     (above == keys.end() ? tree.successor(probe) == tree.end() : tree.successor(probe)->getKey() == *above) &&
+                     (below == keys.begin() ? tree.predecessor(probe) == tree.end() : tree.predecessor(probe)->getKey() == *(below - 1));
+    }
+    check(visitedKeys(tree) == keys && tree.nodesCount() == keys.size() && neighbours,
+          "vebTree: visita, successor() e predecessor() con cluster ad array e a bitmap");
+
+    std::shuffle(keys.begin(), keys.end(), gen);
+    for (uint i{0}; i < 18000; ++i) // Il cluster denso torna ad array ordinato
+    {
+        tree.deleteKey(keys.back());
+        keys.pop_back();
+    }
+    std::sort(keys.begin(), keys.end());
+    check(visitedKeys(tree) == keys && tree.min()->getKey() == keys.front() && tree.max()->getKey() == keys.back(),
+          "vebTree: cancellazioni fino al ritorno ad array ordinato");
+
+    vebTree<uint16_t> small;
+    std::vector<uint> smallKeys;
+    for (uint k : shuffledKeys(65536))
+    {
+        if (k % 3 != 0)
+        {
+            small.insertValue(uint16_t(k));
+            small.insertValue(uint16_t(k)); // Ogni chiave due volte
+            smallKeys.insert(smallKeys.end(), 2, k);
+        }
+    }
+    std::sort(smallKeys.begin(), smallKeys.end());
+    check(visitedKeys(small) == smallKeys && small.successor(65535) == small.end() && small.predecessor(3)->getKey() == 2 &&
+              small.successor(3)->getKey() == 4,
+          "vebTree: universo di 16 bit (un solo livello a bitmap) con chiavi duplicate");
+}
+
+void testString()
+{
+    std::vector<std::string> names;
+    for (uint k : shuffledKeys(3000))
+    {
+        names.push_back("provincia di " + std::to_string(k % 2000)); // Stesso prefisso di 8 byte e nomi ripetuti
+    }
+    names.push_back("");
+    names.push_back("Roma");
+    names.push_back(std::string(70000, 'z')); // Più grande di un blocco dell'arena
+    stringBst tree;
+    for (const std::string &name : names)
+    {
+        tree.insertValue(std::string(name)); // Il temporaneo viene distrutto: l'albero deve usare la propria copia
+    }
+    std::sort(names.begin(), names.end());
+    std::vector<std::string> visited;
+    for (stringBst::const_iterator it{tree.begin()}; it != tree.cend(); ++it)
+    {
+        visited.insert(visited.end(), it->getCount(), std::string(it->getKey().text));
+    }
+    check(visited == names && tree.arenaBytes() >= 70000 + (1 << 16), "stringBst: ordine lessicografico con prefissi uguali e stringhe copiate nell'arena");
+
+    for (uint k{0}; k < 2000; k += 2)
+    {
+        tree.deleteKey("provincia di " + std::to_string(k));
+        names.erase(std::find(names.begin(), names.end(), "provincia di " + std::to_string(k)));
+    }
+    bool found{true};
+    for (uint k{0}; k < 2100; ++k)
+    {
+        std::string name{"provincia di " + std::to_string(k)};
+        found = found && tree.isPresent(name) == std::binary_search(names.begin(), names.end(), name);
+    }
+    check(found && tree.isPresent("") && tree.find("Rom") == nullptr && tree.binarySearch("Roma")->getKey().text == "Roma",
+          "stringBst: ricerche e cancellazioni di una sola occorrenza");
+
+    tree.insertValue(std::string("provincia di 5000")).insertValue(std::string("provincia di 5001"));
+    check(tree.isPresent("provincia di 5000") && tree.isPresent("provincia di 5001") &&
+              !insertEscapes<stringBst, std::string_view, prefixedString>::value && !findEscapes<stringBst, std::string_view, prefixedString>::value,
+          "stringBst: i nodi restituiti non permettono inserimenti che scavalcano l'arena");
+}
+
+void testProjected()
+{
+    projectedBst<City, &City::getPopulation> tree;
+    std::vector<uint> populations;
+    for (uint k : shuffledKeys(1000))
+    {
+        tree.insertValue(City("città " + std::to_string(k), k % 700)); // Popolazioni ripetute
+        populations.push_back(k % 700);
+    }
+    std::sort(populations.begin(), populations.end());
+    std::vector<uint> visited;
+    bool matching{true};
+    for (auto it{tree.begin()}; it != tree.cend(); ++it)
+    {
+        visited.push_back(it->getKey().key);
+        const City &city{tree.payload(&*it)};
+        matching = matching && city.getPopulation() == it->getKey().key && city.getName().rfind("città ", 0) == 0;
+    }
+    check(visited == populations && matching, "projectedBst: visita in ordine e valori completi nell'array parallelo");
+
+    for (uint p{0}; p < 700; p += 2)
+    {
+        tree.deleteKey(p);
+        populations.erase(std::find(populations.begin(), populations.end(), p));
+    }
+    for (uint p{0}; p < 100; ++p) // Riutilizzano le posizioni liberate
+    {
+        tree.insertValue(City("nuova " + std::to_string(p), 1000 + p));
+        populations.push_back(1000 + p);
+    }
+    bool found{true};
+    for (uint p{0}; p < 1100; ++p)
+    {
+        found = found && tree.isPresent(p) == std::binary_search(populations.begin(), populations.end(), p);
+    }
+    check(found && tree.nodesCount() == populations.size() && tree.lookup(1042).getName() == "nuova 42" && tree.lookup(1).getPopulation() == 1,
+          "projectedBst: cancellazioni e inserimenti nelle posizioni liberate");
+
+    tree.insertValue(City("Roma", 2873000)).insertValue(City("Milano", 1372000));
+    using cityTree = projectedBst<City, &City::getPopulation>;
+    check(tree.lookup(1372000).getName() == "Milano" && !insertEscapes<cityTree, City, projectedKey<uint>>::value &&
+              !findEscapes<cityTree, uint, projectedKey<uint>>::value && insertEscapes<cityTree::node_type, projectedKey<uint>>::value,
+          "projectedBst: i nodi restituiti non permettono inserimenti senza una posizione nell'array dei valori");
+}
+
+void testLazy()
+{
+    lazyBst<uint> tree(0.5);
+    std::vector<uint> keys;
+    for (uint k : shuffledKeys(20000))
+    {
+        tree.insertValue(k % 15000); // Chiavi ripetute
+        keys.push_back(k % 15000);
+    }
+    std::sort(keys.begin(), keys.end());
+    std::vector<uint> deletions(keys.begin(), keys.begin() + 9000); // Tutte le tombstone in un intervallo di chiavi
+    std::shuffle(deletions.begin(), deletions.end(), std::mt19937(5));
+    std::size_t peak{0};
+    for (uint k : deletions)
+    {
+        tree.deleteKey(k);
+        peak = std::max(peak, tree.tombstoneCount());
+    }
+    keys.erase(keys.begin(), keys.begin() + 9000);
+    std::vector<uint> visited;
+    for (lazyBst<uint>::const_iterator it{tree.begin()}; it != tree.end(); ++it)
+    {
+        visited.push_back(it->getKey());
+    }
+    check(visited == keys && tree.nodesCount() == keys.size() && tree.min()->getKey() == keys.front() && tree.max()->getKey() == keys.back(),
+          "lazyBst: visita, min e max ignorano le tombstone");
+    check(peak < 9000 && tree.tombstoneCount() < 9000, "lazyBst: i sottoalberi con troppe tombstone vengono ricostruiti");
+
+    bool found{true};
+    for (uint k{0}; k < 15000; ++k)
+    {
+        found = found && tree.isPresent(k) == std::binary_search(keys.begin(), keys.end(), k);
+    }
+    for (uint k{0}; k < 100; ++k) // Chiavi cancellate: riutilizzano le tombstone non ancora ricostruite
+    {
+        tree.insertValue(k);
+        keys.insert(std::upper_bound(keys.begin(), keys.end(), k), k);
+    }
+    bool thrown{false};
+    try
+    {
+        tree.deleteKey(20000);
+    }
+    catch (const NonExistingValueException &e)
+    {
+        thrown = true;
+    }
+    tree.rebuild();
+    visited.clear();
+    for (lazyBst<uint>::const_iterator it{tree.begin()}; it != tree.end(); ++it)
+    {
+        visited.push_back(it->getKey());
+    }
+    check(found && thrown && visited == keys && tree.tombstoneCount() == 0 && tree.isPresent(50),
+          "lazyBst: ricerche, reinserimenti e rebuild() completo");
+
+    lazyBst<uint> small;
+    small.insertValue(1).insertValue(2);
+    small.deleteKey(1);
+    small.deleteKey(2);
+    check(small.isEmpty() && small.tombstoneCount() == 2 && small.begin() == small.cend() &&
+              !std::is_convertible<lazyBst<uint> *, bst<uint, std::greater<uint>, tombstoneAugmentation> *>::value &&
+              !insertEscapes<lazyBst<uint>, uint>::value && !findEscapes<lazyBst<uint>, uint>::value,
+          "lazyBst: isEmpty() con sole tombstone e nessun accesso ai metodi di bst che ignorano i contatori");
+}
+
+void testIndexed()
+{
+    indexedBst<uint> tree;
+    std::vector<uint> keys;
+    for (uint k : shuffledKeys(3000))
+    {
+        tree.insertValue(k % 2000);
+        keys.push_back(k % 2000);
+    }
+    std::sort(keys.begin(), keys.end());
+    bool found{true};
+    for (uint k{0}; k < 2100; ++k)
+    {
+        found = found && tree.contains(k) == (k < 2000) && (k >= 2000 || tree.find(k)->getKey() == k);
+    }
+    check(found && tree.indexedKeys() == 2000 && iteratedKeys(tree) == keys, "indexedBst: l'indice contiene ogni chiave distinta");
+
+    tree.deleteKey(10); // 10 ha due occorrenze: l'indice passa all'altra
+    tree.deleteKey(1900);
+    keys.erase(std::find(keys.begin(), keys.end(), 10));
+    keys.erase(std::find(keys.begin(), keys.end(), 1900));
+    check(tree.contains(10) && tree.find(10)->getKey() == 10 && !tree.contains(1900) && iteratedKeys(tree) == keys,
+          "indexedBst: cancellazione di un'occorrenza di una chiave ripetuta e dell'unica occorrenza");
+
+    tree.eraseRange(0, 499);
+    tree.eraseIf([](uint k)
+                 { return k % 7 == 0; });
+    keys.erase(std::remove_if(keys.begin(), keys.end(), [](uint k)
+                              { return k < 500 || k % 7 == 0; }),
+               keys.end());
+    tree.rebalance();
+    found = true;
+    for (uint k{0}; k < 2000; ++k)
+    {
+        const bst<uint> *node{tree.find(k)};
+        found = found && (node != nullptr) == std::binary_search(keys.begin(), keys.end(), k) && (node == nullptr || node->getKey() == k);
+    }
+    check(found && iteratedKeys(tree) == keys, "indexedBst: indice aggiornato da eraseRange(), eraseIf() e rebalance()");
+
+    indexedBst<uint> strided;
+    for (uint k : shuffledKeys(5000))
+    {
+        strided.insertValue(k * 4096); // Stessi bit bassi: l'hash rimescolato li distribuisce comunque nella tabella
+    }
+    found = true;
+    for (uint k{0}; k < 5100; ++k)
+    {
+        found = found && strided.contains(k * 4096) == (k < 5000) && !strided.contains(k * 4096 + 1);
+    }
+    check(found && strided.indexedKeys() == 5000 && !insertEscapes<indexedBst<uint>, uint>::value && !findEscapes<indexedBst<uint>, uint>::value,
+          "indexedBst: chiavi con gli stessi bit bassi e nodi costanti");
+}
+
+void testMulti()
+{
+    multiBst<uint> tree;
+    std::vector<uint> keys;
+    for (uint k : shuffledKeys(3000))
+    {
+        tree.insertValue(k % 100);
+        keys.push_back(k % 100);
+    }
+    std::sort(keys.begin(), keys.end());
+    check(iteratedKeys(tree) == keys && tree.nodesCount() == 100 && tree.size() == 3000 && tree.count(7) == 30,
+          "multiBst: un nodo per ogni chiave distinta con il numero di occorrenze");
+
+    for (uint i{0}; i < 30; ++i)
+    {
+        tree.deleteKey(7);
+        keys.erase(std::find(keys.begin(), keys.end(), 7));
+    }
+    tree.deleteKey(8);
+    keys.erase(std::find(keys.begin(), keys.end(), 8));
+    std::vector<uint> expanded(tree.beginExpanded(), tree.endExpanded());
+    check(iteratedKeys(tree) == keys && expanded == keys && tree.count(7) == 0 && !tree.isPresent(7) && tree.count(8) == 29 && tree.nodesCount() == 99,
+          "multiBst: cancellazione delle occorrenze e iteratore con i duplicati espansi");
+
+    tree.insertValue(500).insertValue(500);
+    check(tree.count(500) == 2 && tree.nodesCount() == 100 && !std::is_convertible<multiBst<uint> *, bst<uint> *>::value &&
+              !insertEscapes<multiBst<uint>, uint>::value && !findEscapes<multiBst<uint>, uint>::value,
+          "multiBst: nessun accesso agli inserimenti di bst che duplicherebbero i nodi");
+}
+
+void testErase()
+{
+    bst<uint> tree;
+    std::vector<uint> keys;
+    for (uint k : shuffledKeys(3000))
+    {
+        tree.insertValue(k % 2000); // Chiavi ripetute
+        keys.push_back(k % 2000);
+    }
+    uint erased{tree.eraseRange(500, 999)};
+    keys.erase(std::remove_if(keys.begin(), keys.end(), [](uint k)
+                              { return k >= 500 && k <= 999; }),
+               keys.end());
+    check(holds(tree, keys) && erased == 1000, "bst: eraseRange() elimina l'intervallo chiuso con i duplicati");
+
+    erased = tree.erase(tree.findFrom(tree.begin(), 1200), tree.findFrom(tree.begin(), 1300));
+    keys.erase(std::remove_if(keys.begin(), keys.end(), [](uint k)
+                              { return k >= 1200 && k < 1300; }),
+               keys.end());
+    check(holds(tree, keys) && erased == 100, "bst: erase(first, last) esclude la chiave di last");
+
+    erased = tree.eraseIf([](uint k)
+                          { return k % 3 == 0; });
+    uint expected{uint(std::count_if(keys.begin(), keys.end(), [](uint k)
+                                     { return k % 3 == 0; }))};
+    keys.erase(std::remove_if(keys.begin(), keys.end(), [](uint k)
+                              { return k % 3 == 0; }),
+               keys.end());
+    check(holds(tree, keys) && erased == expected, "bst: eraseIf() elimina le chiavi che soddisfano il predicato");
+
+    erased = tree.erase(tree.findFrom(tree.begin(), 1900), tree.cend());
+    keys.erase(std::remove_if(keys.begin(), keys.end(), [](uint k)
+                              { return k >= 1900; }),
+               keys.end());
+    check(holds(tree, keys) && erased > 0 && tree.eraseRange(5000, 6000) == 0, "bst: erase() fino a cend() e intervalli vuoti");
+
+    bst<uint> large;
+    for (uint k : shuffledKeys(4096))
+    {
+        large.insertValue(k);
+    }
+    erased = large.eraseRange(100, 4095);
+    std::vector<uint> rest;
+    for (uint k{0}; k < 100; ++k)
+    {
+        rest.push_back(k);
+    }
+    check(erased == 3996 && holds(large, rest) && large.height() <= 7, "bst: eraseRange() ribilancia l'albero quando elimina la maggior parte dei nodi");
+}
+
+void testSplitJoin()
+{
+    bst<uint> tree;
+    std::vector<uint> keys;
+    for (uint k : shuffledKeys(2000))
+    {
+        tree.insertValue(k % 1500);
+        keys.push_back(k % 1500);
+    }
+    std::pair<bst<uint>, bst<uint>> parts{tree.split(700)};
+    std::vector<uint> less;
+    std::vector<uint> greaterEqual;
+    for (uint k : keys)
+    {
+        (k < 700 ? less : greaterEqual).push_back(k);
+    }
+    check(tree.isEmpty() && holds(parts.first, less) && holds(parts.second, greaterEqual),
+          "bst: split() divide in chiavi minori e chiavi maggiori o uguali (duplicati compresi)");
+
+    bst<uint> joined{bst<uint>::join(std::move(parts.first), std::move(parts.second))};
+    check(holds(joined, keys) && parts.first.isEmpty() && parts.second.isEmpty(), "bst: join() ricompone l'albero");
+
+    std::pair<bst<uint>, bst<uint>> low{joined.split(100)};
+    std::pair<bst<uint>, bst<uint>> high{low.second.split(101)};
+    high.first.deleteKey(100); // Le occorrenze di 100 tranne una
+    keys.erase(std::find(keys.begin(), keys.end(), 100));
+    bst<uint> pivoted{bst<uint>::join(std::move(low.first), 100, std::move(high.second))};
+    check(holds(pivoted, keys) && holds(high.first, std::vector<uint>{100}), "bst: join() con una chiave pivot");
+
+    balancedBst<uint> balanced;
+    for (uint k : shuffledKeys(2000))
+    {
+        balanced.insertValue(k);
+    }
+    std::mt19937 gen(30);
+    for (uint i{0}; i < 200; ++i)
+    {
+        std::pair<balancedBst<uint>, balancedBst<uint>> halves{balanced.split(gen() % 2000)};
+        balanced = balancedBst<uint>::join(std::move(halves.first), std::move(halves.second));
+    }
+    check(balanced.nodesCount() == 2000 && balanced.height() <= 2.0 * log2(2000.0) + 1, "balancedBst: split() e join() ripetuti mantengono il limite di altezza");
+}
+
+void testIndex()
+{
+    indexBst<uint> linked;
+    indexBst<uint, std::greater<uint>, false> compact; // Senza indice del genitore
+    std::vector<uint> keys;
+    for (uint k : shuffledKeys(3000))
+    {
+        linked.insertValue(k % 2000);
+        compact.insertValue(k % 2000);
+        keys.push_back(k % 2000);
+    }
+    for (uint k{0}; k < 2000; k += 4)
+    {
+        linked.deleteKey(k);
+        compact.deleteKey(k);
+        keys.erase(std::find(keys.begin(), keys.end(), k));
+    }
+    std::sort(keys.begin(), keys.end());
+    std::vector<uint> forward;
+    std::vector<uint> visited;
+    for (auto it{linked.begin()}; it != linked.end(); ++it)
+    {
+        forward.push_back(it->getKey());
+    }
+    for (auto it{compact.begin()}; it != compact.end(); ++it)
+    {
+        visited.push_back(it->getKey());
+    }
+    std::vector<uint> backward;
+    for (auto it{linked.max()}; it != linked.end(); --it)
+    {
+        backward.push_back(it->getKey());
+    }
+    std::reverse(backward.begin(), backward.end());
+    check(forward == keys && visited == keys && backward == keys && linked.nodesCount() == keys.size() && compact.nodesCount() == keys.size(),
+          "indexBst: visite in avanti e all'indietro con e senza indice del genitore dopo le cancellazioni");
+
+    bool found{true};
+    for (uint k{0}; k < 2100; ++k)
+    {
+        bool expected{std::binary_search(keys.begin(), keys.end(), k)};
+        found = found && linked.isPresent(k) == expected && compact.isPresent(k) == expected;
+    }
+    check(found && linked.min().getKey() == keys.front() && compact.max().getKey() == keys.back() && linked.find(1004) == linked.end(),
+          "indexBst: ricerche, min e max");
+
+    bool same{true}; // Gli iteratori di find() senza indice del genitore ricostruiscono la pila al primo spostamento
+    for (uint k{1}; k < 2000; k += 98) // Chiavi non multiple di 4, quindi non cancellate
+    {
+        auto a{linked.find(k)};
+        auto b{compact.find(k)};
+        auto c{compact.find(k)};
+        std::vector<uint> linkedKeys, compactKeys;
+        for (; a != linked.end(); ++a, ++b)
+        {
+            linkedKeys.push_back(a->getKey());
+            compactKeys.push_back(b != compact.end() ? b->getKey() : 0);
+        }
+        uint before{0};
+        for (; c != compact.end(); --c)
+        {
+            ++before;
+        }
+        same = same && !linkedKeys.empty() && linkedKeys == compactKeys && b == compact.end() &&
+               before + linkedKeys.size() == keys.size() + 1 &&
+               std::equal(linkedKeys.begin(), linkedKeys.end(), keys.end() - linkedKeys.size());
+    }
+    check(same, "indexBst: spostamenti degli iteratori restituiti da find() senza indice del genitore");
+}
+
+void testFiltered()
+{
+    filteredBst<uint> tree(1000, 0.01); // Meno chiavi previste di quelle inserite: il filtro deve crescere
+    for (uint k{0}; k < 10000; ++k)
+    {
+        tree.insertValue(2 * k);
+    }
+    bool present{true};
+    uint falsePositives{0};
+    for (uint k{0}; k < 10000; ++k)
+    {
+        present = present && tree.mayContain(2 * k) && tree.isPresent(2 * k);
+        falsePositives += tree.mayContain(2 * k + 1);
+        present = present && !tree.isPresent(2 * k + 1);
+    }
+    check(present && falsePositives < 500, "filteredBst: nessun falso negativo e pochi falsi positivi dopo la crescita del filtro");
+
+    for (uint k{0}; k < 10000; k += 2)
+    {
+        tree.deleteKey(2 * k);
+    }
+    bool deleted{true};
+    for (uint k{0}; k < 10000; ++k)
+    {
+        deleted = deleted && tree.isPresent(2 * k) == (k % 2 == 1) && (k % 2 == 0 || tree.mayContain(2 * k));
+    }
+    check(deleted && tree.nodesCount() == 5000 && tree.find(0) == nullptr, "filteredBst: le cancellazioni decrementano i contatori del filtro");
+}
+
+void testLearned()
+{
+    bst<uint> tree;
+    std::vector<uint> keys;
+    std::mt19937 gen(29);
+    for (uint k : shuffledKeys(20000))
+    {
+        uint key{k * 3 + uint(gen() % 3)}; // Chiavi distinte con passo irregolare
+        tree.insertValue(key);
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    learnedIndex<uint> index(tree, 64);
+    bool matching{true};
+    for (uint probe{0}; probe < 61000; probe += 7)
+    {
+        auto expected{std::lower_bound(keys.begin(), keys.end(), probe)};
+        const uint *found{index.lower_bound(probe)};
+        matching = matching && (expected == keys.end() ? found == nullptr : found != nullptr && *found == *expected) &&
+                   index.contains(probe) == std::binary_search(keys.begin(), keys.end(), probe);
+    }
+    check(matching && index.size() == keys.size() && index.min() == keys.front() && index.max() == keys.back(),
+          "learnedIndex: lower_bound() e contains() coincidono con la ricerca binaria");
+    check(index.find(keys[1234]) != nullptr && *index.find(keys[1234]) == keys[1234] && index.maxError() < keys.size(),
+          "learnedIndex: ricerca esatta e errore massimo dei modelli");
+}
+
+void testMerkle()
+{
+    merkleBst<uint> a;
+    merkleBst<uint> b;
+    for (uint k : shuffledKeys(2000))
+    {
+        a.insertValue(k);
+    }
+    for (uint k{0}; k < 2000; ++k) // Stesse chiavi in un altro ordine: forma diversa, stesso hash
+    {
+        b.insertValue(k);
+    }
+    check(a.rootHash() == b.rootHash() && a.rootHash() != 0 && merkleBst<uint>::diff(a, b).first.empty(),
+          "merkleBst: l'hash non dipende dalla forma dell'albero");
+
+    a.insertValue(5000);
+    a.insertValue(17); // Occorrenza in più
+    b.deleteKey(1234);
+    std::pair<std::vector<uint>, std::vector<uint>> differences{merkleBst<uint>::diff(a, b)};
+    check(a.rootHash() != b.rootHash() && differences.first == std::vector<uint>{17, 1234, 5000} && differences.second.empty(),
+          "merkleBst: diff() trova le chiavi in più, comprese le occorrenze ripetute");
+
+    b.insertValue(1234);
+    b.insertValue(5000);
+    b.insertValue(17);
+    b.rebalance();
+    check(a.rootHash() == b.rootHash() && merkleBst<uint>::diff(a, b).second.empty(), "merkleBst: repliche di nuovo allineate dopo rebalance()");
+}
+
+void testAggregate()
+{
+    bst<uint, std::greater<uint>, monoidAugmentation<uint, keyProjection, sumMonoid<uint64_t>>> sums;
+    bst<uint, std::greater<uint>, monoidAugmentation<uint, keyProjection, minMonoid<uint>>> minimums;
+    std::vector<uint> keys;
+    for (uint k : shuffledKeys(3000))
+    {
+        sums.insertValue(k % 2000);
+        minimums.insertValue(k % 2000);
+        keys.push_back(k % 2000);
+    }
+    for (uint k{0}; k < 2000; k += 5)
+    {
+        sums.deleteKey(k);
+        minimums.deleteKey(k);
+        keys.erase(std::find(keys.begin(), keys.end(), k));
+    }
+    sums.rebalance();
+    bool correct{true};
+    std::mt19937 gen(31);
+    for (uint i{0}; i < 200; ++i)
+    {
+        uint a{uint(gen() % 2100)};
+        uint b{a + uint(gen() % 600)};
+        uint64_t sum{0};
+        uint minimum{std::numeric_limits<uint>::max()};
+        for (uint k : keys)
+        {
+            if (k >= a && k <= b)
+            {
+                sum += k;
+                minimum = std::min(minimum, k);
+            }
+        }
+        correct = correct && sums.aggregate(a, b) == sum && minimums.aggregate(a, b) == minimum;
+    }
+    uint64_t total{0};
+    for (uint k : keys)
+    {
+        total += k;
+    }
+    check(correct && sums.aggregate() == total && minimums.aggregate() == *std::min_element(keys.begin(), keys.end()), "bst: aggregate() su tutto l'albero e su intervalli dopo cancellazioni e rebalance()");
+}
+
+void testInterval()
+{
+    intervalTree<int> tree;
+    std::vector<interval<int>> ranges;
+    std::mt19937 gen(37);
+    for (uint i{0}; i < 2000; ++i)
+    {
+        int low{int(gen() % 100000)};
+        interval<int> range{low, low + int(gen() % (i % 10 == 0 ? 5000 : 100))};
+        tree.insertValue(range);
+        ranges.push_back(range);
+    }
+    for (uint i{0}; i < 2000; i += 3)
+    {
+        tree.deleteKey(ranges[i]);
+    }
+    std::vector<interval<int>> kept;
+    for (uint i{0}; i < 2000; ++i)
+    {
+        if (i % 3 != 0)
+        {
+            kept.push_back(ranges[i]);
+        }
+    }
+    std::sort(kept.begin(), kept.end(), [](const interval<int> &a, const interval<int> &b)
+              { return a.low < b.low || (a.low == b.low && a.high < b.high); });
+    bool matching{true};
+    for (uint i{0}; i < 300; ++i)
+    {
+        int x{int(gen() % 105000)};
+        int y{x + int(gen() % 300)};
+        std::vector<interval<int>> expected;
+        for (const interval<int> &range : kept)
+        {
+            if (range.low <= y && x <= range.high)
+            {
+                expected.push_back(range);
+            }
+        }
+        auto any{tree.findOverlap(x, y)};
+        matching = matching && tree.overlaps(x, y) == expected && (any == nullptr) == expected.empty() &&
+                   (any == nullptr || (any->getKey().low <= y && x <= any->getKey().high));
+    }
+    check(matching, "intervalTree: overlaps() e findOverlap() coincidono con la ricerca esaustiva");
+}
+
 // METTIAMOLA NEL README
 /** @mainpage Presentazione del progetto
  *
@@ -169,4 +1713,71 @@ void testBST_Iterator()
  * 
  * @subsection BD accessory.hpp
  * Contiene funzioni utilizzate dalla classe bst, ma non specifiche degli alberi binari di ricerca
+ *
+ * @subsection BE multiBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca in modalità multiset, che memorizza per ogni chiave il numero di occorrenze
+ *
+ * @subsection BF splayBst.hpp
+ * Contiene il codice sorgente di uno splay tree, che porta nella radice ogni nodo a cui si accede
+ *
+ * @subsection BG nodePool.hpp
+ * Contiene il codice sorgente dell'allocatore a blocchi utilizzato per i nodi degli alberi
+ *
+ * @subsection BH indexBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca con nodi in un'arena e archi a 32 bit
+ *
+ * @subsection BI staticBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca statico costruito a tempo di compilazione
+ *
+ * @subsection BJ balancedBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca con ribilanciamento automatico in stile scapegoat tree
+ *
+ * @subsection BK bufferedBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca che applica inserimenti e cancellazioni a lotti
+ *
+ * @subsection BL weightedBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca ricostruibile in forma ottima per la frequenza degli accessi
+ *
+ * @subsection BM indexedBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca con un indice hash per le ricerche esatte
+ *
+ * @subsection BN filteredBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca con un filtro di Bloom per le ricerche senza esito
+ *
+ * @subsection BO learnedIndex.hpp
+ * Contiene il codice sorgente di un indice appreso sulle chiavi intere di un albero
+ *
+ * @subsection BP augmentation.hpp
+ * Contiene gli aumenti che si possono memorizzare nei nodi degli alberi (valori calcolati dai sottoalberi), tra cui
+ * monoidAugmentation per calcolare con bst::aggregate() somme, minimi e massimi sugli intervalli di chiavi
+ *
+ * @subsection BQ merkleBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca con l'hash di ogni sottoalbero, per confrontare rapidamente due repliche
+ *
+ * @subsection BR loggedBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca persistente, che registra le modifiche in un log su disco
+ *
+ * @subsection BS intervalTree.hpp
+ * Contiene il codice sorgente di un albero di intervalli per cercare gli intervalli che si sovrappongono a un intervallo dato
+ *
+ * @subsection BT btree.hpp
+ * Contiene il codice sorgente di un B+-tree con nodi grandi alcune linee di cache e la stessa interfaccia di bst
+ *
+ * @subsection BU shardedBst.hpp
+ * Contiene il codice sorgente di un contenitore ordinato diviso per intervalli di chiavi in alberi indipendenti, utilizzabile da più thread
+ *
+ * @subsection BV vebTree.hpp
+ * Contiene il codice sorgente di un albero di van Emde Boas per chiavi intere senza segno e l'alias fastBst che lo sceglie al posto di bst
+ *
+ * @subsection BW stringBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca di stringhe con prefissi interi nei nodi e byte delle chiavi in un'arena
+ *
+ * @subsection BX projectedBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca che memorizza nei nodi solo una proiezione della chiave e i valori in un array
+ *
+ * @subsection BY lazyBst.hpp
+ * Contiene il codice sorgente di un albero binario di ricerca con cancellazione pigra tramite tombstone e ricostruzione locale dei sottoalberi
+ *
+ * @subsection BZ workerPool.hpp
+ * Contiene il codice sorgente dell'insieme di thread riutilizzati dalle funzioni parallele di bst
  */
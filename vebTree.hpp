@@ -0,0 +1,860 @@
+#ifndef __vebTree_hpp__
+#define __vebTree_hpp__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bst.hpp"
+
+/**
+ * @class vebTree
+ *
+ * @brief Albero di van Emde Boas per chiavi intere senza segno, con la stessa interfaccia di ricerca di bst
+ * (insertValue, binarySearch, find, isPresent, deleteKey, min, max, successor, predecessor, const_iterator).
+ * Un livello con universo di B bit divide ogni chiave nei B/2 bit alti, che scelgono un sottolivello (cluster) con
+ * universo di B/2 bit, e nei B/2 bit bassi, che vengono cercati nel cluster; un livello "summary" contiene i cluster
+ * non vuoti. Ogni operazione scende ricorsivamente in un solo sottolivello, quindi costa O(log log U) invece di O(log n):
+ * per chiavi a 32 bit c'è un solo livello ricorsivo, con cluster e summary di 16 bit.
+ * I livelli fino a 16 bit non hanno sottolivelli: sono un array ordinato di chiavi a 8 o 16 bit finché occupa meno di
+ * una bitmap dell'universo, poi una bitmap (al più 8 KB) con un bit per ogni parola non vuota, quindi le ricerche in un
+ * cluster costano una ricerca binaria o pochi accessi a parole consecutive. Il minimo di ogni livello non viene
+ * memorizzato nei sottolivelli e i cluster non vuoti sono memorizzati direttamente nella tabella hash del livello,
+ * quindi la memoria è O(n) anche con universi a 64 bit (circa 10 byte per chiave con 1M chiavi casuali a 32 bit).
+ * Come in bst le chiavi duplicate sono ammesse: le occorrenze in più sono contate a parte e deleteKey() ne elimina una.
+ *
+ * I metodi che in bst restituiscono un nodo restituiscono qui un const_iterator, che ha l'operatore -> verso un elemento
+ * con il metodo getKey(); un iteratore non trovato è uguale a end(), che come in btree segue l'ultimo elemento.
+ *
+ * @tparam T è il tipo delle chiavi (intero senza segno)
+ */
+template <typename T>
+class vebTree
+{
+    static_assert(std::is_unsigned<T>::value && !std::is_same<T, bool>::value, "vebTree richiede chiavi intere senza segno");
+
+public:
+    /**
+     * @brief Elemento restituito dagli iteratori: contiene una chiave
+     */
+    struct entry
+    {
+        T key;
+
+        /**
+         * @brief Restituisce la chiave dell'elemento
+         *
+         * @return const T& è il riferimento alla chiave
+         */
+        inline const T &getKey() const
+        {
+            return key;
+        }
+    };
+
+private:
+    /**
+     * @brief Livello con universo di BITS bit (caso ricorsivo, oltre 16 bit)
+     *
+     * @tparam BITS è il numero di bit dell'universo del livello
+     * @tparam FLAT è true se il livello è rappresentato con array piatti
+     */
+    template <unsigned BITS, bool FLAT = (BITS <= 16)>
+    struct level
+    {
+        static constexpr unsigned lowBits{BITS / 2};         // bit della chiave cercati nel cluster
+        static constexpr unsigned highBits{BITS - BITS / 2}; // bit della chiave che scelgono il cluster
+
+        using cluster_type = level<lowBits>;
+        using summary_type = level<highBits>;
+
+        T minimum{0};                                 // chiave minima (non memorizzata nei cluster)
+        T maximum{0};                                 // chiave massima
+        bool empty{true};                             // true se il livello non contiene chiavi
+        summary_type summary;                         // indici dei cluster non vuoti
+        std::unordered_map<T, cluster_type> clusters; // cluster non vuoti, memorizzati nella tabella stessa
+
+        static inline T high(T x)
+        {
+            return x >> lowBits;
+        }
+
+        static inline T low(T x)
+        {
+            return x & ((T(1) << lowBits) - 1);
+        }
+
+        static inline T index(T h, T l)
+        {
+            return (h << lowBits) | l;
+        }
+
+        /**
+         * @brief Cluster con un dato indice
+         *
+         * @return puntatore al cluster (nullptr se è vuoto)
+         */
+        inline const cluster_type *find(T h) const
+        {
+            auto it{clusters.find(h)};
+            return it == clusters.end() ? nullptr : &it->second;
+        }
+
+        bool contains(T x) const
+        {
+            if (empty)
+            {
+                return false;
+            }
+            if (x == minimum || x == maximum)
+            {
+                return true;
+            }
+            const cluster_type *c{find(high(x))};
+            return c != nullptr && c->contains(low(x));
+        }
+
+        /**
+         * @brief Inserisce una chiave non presente
+         * Se il cluster della chiave è vuoto l'inserimento nel cluster costa O(1) e si scende nel summary, altrimenti
+         * il summary non cambia: in entrambi i casi la ricorsione prosegue in un solo sottolivello.
+         */
+        void insert(T x)
+        {
+            if (empty)
+            {
+                minimum = maximum = x;
+                empty = false;
+                return;
+            }
+            if (x < minimum) // Il nuovo minimo resta in questo livello e il vecchio scende nel cluster
+            {
+                std::swap(x, minimum);
+            }
+            if (x > maximum)
+            {
+                maximum = x;
+            }
+            cluster_type &c{clusters[high(x)]};
+            if (c.empty)
+            {
+                summary.insert(high(x));
+            }
+            c.insert(low(x));
+        }
+
+        /**
+         * @brief Elimina una chiave presente
+         */
+        void remove(T x)
+        {
+            if (minimum == maximum)
+            {
+                empty = true;
+                return;
+            }
+            if (x == minimum) // Il minimo del primo cluster sale in questo livello
+            {
+                T h{summary.minimum};
+                x = minimum = index(h, find(h)->minimum);
+            }
+            T h{high(x)};
+            auto it{clusters.find(h)};
+            it->second.remove(low(x));
+            if (it->second.empty)
+            {
+                clusters.erase(it);
+                summary.remove(h);
+            }
+            if (x == maximum)
+            {
+                if (summary.empty)
+                {
+                    maximum = minimum;
+                }
+                else
+                {
+                    T last{summary.maximum};
+                    maximum = index(last, find(last)->maximum);
+                }
+            }
+        }
+
+        /**
+         * @brief Chiave successiva
+         *
+         * @param x è la chiave di partenza (può non essere presente)
+         * @param result è la minima chiave maggiore di x
+         * @return true se la chiave esiste
+         */
+        bool successor(T x, T &result) const
+        {
+            if (empty || x >= maximum)
+            {
+                return false;
+            }
+            if (x < minimum)
+            {
+                result = minimum;
+                return true;
+            }
+            T h{high(x)};
+            const cluster_type *c{find(h)};
+            if (c != nullptr && low(x) < c->maximum)
+            {
+                T l{0};
+                c->successor(low(x), l);
+                result = index(h, l);
+                return true;
+            }
+            T next{0};
+            summary.successor(h, next); // Esiste perché x < maximum
+            result = index(next, find(next)->minimum);
+            return true;
+        }
+
+        /**
+         * @brief Chiave precedente
+         *
+         * @param x è la chiave di partenza (può non essere presente)
+         * @param result è la massima chiave minore di x
+         * @return true se la chiave esiste
+         */
+        bool predecessor(T x, T &result) const
+        {
+            if (empty || x <= minimum)
+            {
+                return false;
+            }
+            if (x > maximum)
+            {
+                result = maximum;
+                return true;
+            }
+            T h{high(x)};
+            const cluster_type *c{find(h)};
+            if (c != nullptr && low(x) > c->minimum)
+            {
+                T l{0};
+                c->predecessor(low(x), l);
+                result = index(h, l);
+                return true;
+            }
+            T previous{0};
+            if (summary.predecessor(h, previous))
+            {
+                result = index(previous, find(previous)->maximum);
+                return true;
+            }
+            result = minimum; // Il minimo non è in nessun cluster
+            return true;
+        }
+    };
+
+    /**
+     * @brief Livello con universo di al più 16 bit, senza sottolivelli: array ordinato delle chiavi o bitmap
+     * Finché le chiavi occupano meno della bitmap sono tenute in un array ordinato di interi a 8 o 16 bit (ricerca
+     * binaria, inserimento con spostamento di al più 8 KB); oltre quella soglia il livello passa a una bitmap con un bit
+     * per chiave dell'universo, seguita da un bit per ogni parola non vuota, e torna all'array quando le chiavi scendono
+     * sotto metà soglia. Con 1M chiavi casuali a 32 bit i cluster hanno una quindicina di chiavi e restano array.
+     *
+     * @tparam BITS è il numero di bit dell'universo del livello
+     */
+    template <unsigned BITS>
+    struct level<BITS, true>
+    {
+        using small_type = typename std::conditional<(BITS <= 8), uint8_t, uint16_t>::type;
+
+        static constexpr std::size_t words{BITS <= 6 ? 1 : std::size_t(1) << (BITS - 6)}; // parole della bitmap
+        static constexpr std::size_t summaryWords{(words + 63) / 64};                      // parole dei bit delle parole non vuote
+        static constexpr std::size_t sparseLimit{words * sizeof(uint64_t) / sizeof(small_type)}; // chiavi oltre cui si usa la bitmap
+
+        std::vector<small_type> keys; // chiavi ordinate (se bits è vuoto)
+        std::vector<uint64_t> bits;   // bitmap delle chiavi seguita da quella delle parole non vuote (se non è vuoto)
+        uint32_t size{0};             // numero di chiavi
+        T minimum{0};                 // chiave minima
+        T maximum{0};                 // chiave massima
+        bool empty{true};             // true se il livello non contiene chiavi
+
+        inline bool dense() const
+        {
+            return !bits.empty();
+        }
+
+        inline void set(std::size_t x)
+        {
+            bits[x >> 6] |= uint64_t(1) << (x & 63);
+            bits[words + (x >> 12)] |= uint64_t(1) << ((x >> 6) & 63);
+        }
+
+        /**
+         * @brief Minima chiave della bitmap maggiore o uguale a from
+         *
+         * @return true se la chiave esiste
+         */
+        bool first(std::size_t from, T &result) const
+        {
+            std::size_t w{from >> 6};
+            uint64_t word{bits[w] & (~uint64_t(0) << (from & 63))};
+            if (word == 0) // Si cerca la prima parola non vuota successiva
+            {
+                if (++w == words)
+                {
+                    return false;
+                }
+                std::size_t s{w >> 6};
+                uint64_t mask{bits[words + s] & (~uint64_t(0) << (w & 63))};
+                while (mask == 0)
+                {
+                    if (++s == summaryWords)
+                    {
+                        return false;
+                    }
+                    mask = bits[words + s];
+                }
+                w = (s << 6) | std::size_t(__builtin_ctzll(mask));
+                word = bits[w];
+            }
+            result = T((w << 6) | std::size_t(__builtin_ctzll(word)));
+            return true;
+        }
+
+        /**
+         * @brief Massima chiave della bitmap minore o uguale a from
+         *
+         * @return true se la chiave esiste
+         */
+        bool last(std::size_t from, T &result) const
+        {
+            std::size_t w{from >> 6};
+            uint64_t word{bits[w] & (~uint64_t(0) >> (63 - (from & 63)))};
+            if (word == 0) // Si cerca l'ultima parola non vuota precedente
+            {
+                if (w-- == 0)
+                {
+                    return false;
+                }
+                std::size_t s{w >> 6};
+                uint64_t mask{bits[words + s] & (~uint64_t(0) >> (63 - (w & 63)))};
+                while (mask == 0)
+                {
+                    if (s-- == 0)
+                    {
+                        return false;
+                    }
+                    mask = bits[words + s];
+                }
+                w = (s << 6) | std::size_t(63 - __builtin_clzll(mask));
+                word = bits[w];
+            }
+            result = T((w << 6) | std::size_t(63 - __builtin_clzll(word)));
+            return true;
+        }
+
+        bool contains(T x) const
+        {
+            if (empty)
+            {
+                return false;
+            }
+            if (dense())
+            {
+                return (bits[x >> 6] >> (x & 63)) & 1;
+            }
+            return std::binary_search(keys.begin(), keys.end(), small_type(x));
+        }
+
+        /**
+         * @brief Inserisce una chiave non presente
+         */
+        void insert(T x)
+        {
+            if (!dense() && keys.size() == sparseLimit) // L'array occuperebbe più della bitmap
+            {
+                bits.assign(words + summaryWords, 0);
+                for (small_type key : keys)
+                {
+                    set(key);
+                }
+                std::vector<small_type>().swap(keys);
+            }
+            if (dense())
+            {
+                set(x);
+            }
+            else
+            {
+                keys.insert(std::upper_bound(keys.begin(), keys.end(), small_type(x)), small_type(x));
+            }
+            if (empty || x < minimum)
+            {
+                minimum = x;
+            }
+            if (empty || x > maximum)
+            {
+                maximum = x;
+            }
+            empty = false;
+            ++size;
+        }
+
+        /**
+         * @brief Elimina una chiave presente
+         */
+        void remove(T x)
+        {
+            if (--size == 0)
+            {
+                keys.clear();
+                std::vector<uint64_t>().swap(bits);
+                empty = true;
+                return;
+            }
+            if (!dense())
+            {
+                keys.erase(std::lower_bound(keys.begin(), keys.end(), small_type(x)));
+                minimum = keys.front();
+                maximum = keys.back();
+                return;
+            }
+            bits[x >> 6] &= ~(uint64_t(1) << (x & 63));
+            if (bits[x >> 6] == 0)
+            {
+                bits[words + (x >> 12)] &= ~(uint64_t(1) << ((x >> 6) & 63));
+            }
+            if (x == minimum)
+            {
+                first(x, minimum);
+            }
+            if (x == maximum)
+            {
+                last(x, maximum);
+            }
+            if (size < sparseLimit / 2) // Si torna all'array, lasciando margine prima di un nuovo passaggio alla bitmap
+            {
+                keys.reserve(size);
+                T key{minimum};
+                do
+                {
+                    keys.push_back(small_type(key));
+                } while (key < maximum && first(std::size_t(key) + 1, key));
+                std::vector<uint64_t>().swap(bits);
+            }
+        }
+
+        /**
+         * @brief Chiave successiva
+         *
+         * @param x è la chiave di partenza (può non essere presente)
+         * @param result è la minima chiave maggiore di x
+         * @return true se la chiave esiste
+         */
+        bool successor(T x, T &result) const
+        {
+            if (empty || x >= maximum)
+            {
+                return false;
+            }
+            if (x < minimum)
+            {
+                result = minimum;
+                return true;
+            }
+            if (dense())
+            {
+                return first(std::size_t(x) + 1, result); // x + 1 <= maximum sta nell'universo
+            }
+            result = *std::upper_bound(keys.begin(), keys.end(), small_type(x));
+            return true;
+        }
+
+        /**
+         * @brief Chiave precedente
+         *
+         * @param x è la chiave di partenza (può non essere presente)
+         * @param result è la massima chiave minore di x
+         * @return true se la chiave esiste
+         */
+        bool predecessor(T x, T &result) const
+        {
+            if (empty || x <= minimum)
+            {
+                return false;
+            }
+            if (x > maximum)
+            {
+                result = maximum;
+                return true;
+            }
+            if (dense())
+            {
+                return last(std::size_t(x) - 1, result);
+            }
+            result = *(std::lower_bound(keys.begin(), keys.end(), small_type(x)) - 1);
+            return true;
+        }
+    };
+
+    using root_type = level<std::numeric_limits<T>::digits>;
+
+    std::unique_ptr<root_type> root;      // livello con l'intero universo delle chiavi
+    std::unordered_map<T, uint> repeated; // occorrenze in più delle chiavi duplicate
+    std::size_t count;                    // numero di chiavi (con i duplicati)
+
+    /**
+     * @brief Numero di occorrenze di una chiave presente
+     */
+    inline uint occurrences(T value) const
+    {
+        if (repeated.empty())
+        {
+            return 1;
+        }
+        auto it{repeated.find(value)};
+        return it == repeated.end() ? 1 : 1 + it->second;
+    }
+
+public:
+    /**
+     * @class const_iterator
+     *
+     * @brief Iteratore costante bidirezionale sulle chiavi in ordine crescente (le chiavi duplicate vengono ripetute)
+     * L'elemento restituito da * e -> è contenuto nell'iteratore stesso.
+     */
+    class const_iterator
+    {
+    private:
+        const vebTree *tree; // albero
+        entry current;       // chiave corrente
+        uint occurrence;     // occorrenza corrente della chiave
+        bool atEnd;          // true per end()
+
+        const_iterator(const vebTree *inputTree, T key, uint inputOccurrence, bool inputAtEnd) : tree{inputTree}, current{key}, occurrence{inputOccurrence}, atEnd{inputAtEnd} {}
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = entry;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        /**
+         * @brief Costruttore vuoto pubblico
+         */
+        const_iterator() : tree{nullptr}, current{0}, occurrence{0}, atEnd{true} {}
+
+        const_iterator &operator++()
+        {
+            if (occurrence + 1 < tree->occurrences(current.key))
+            {
+                ++occurrence;
+            }
+            else
+            {
+                occurrence = 0;
+                atEnd = !tree->root->successor(current.key, current.key);
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator it{*this};
+            ++(*this);
+            return it;
+        }
+
+        const_iterator &operator--()
+        {
+            if (atEnd)
+            {
+                current.key = tree->root->maximum;
+                atEnd = false;
+                occurrence = tree->occurrences(current.key) - 1;
+            }
+            else if (occurrence > 0)
+            {
+                --occurrence;
+            }
+            else
+            {
+                tree->root->predecessor(current.key, current.key);
+                occurrence = tree->occurrences(current.key) - 1;
+            }
+            return *this;
+        }
+
+        const_iterator operator--(int)
+        {
+            const_iterator it{*this};
+            --(*this);
+            return it;
+        }
+
+        inline reference operator*() const
+        {
+            return current;
+        }
+
+        inline pointer operator->() const
+        {
+            return &current;
+        }
+
+        inline bool operator==(const const_iterator &it) const
+        {
+            return atEnd == it.atEnd && (atEnd || (current.key == it.current.key && occurrence == it.occurrence));
+        }
+
+        inline bool operator!=(const const_iterator &it) const
+        {
+            return !(*this == it);
+        }
+
+        friend class vebTree<T>;
+    };
+
+    /**
+     * @brief Costruttore vuoto
+     */
+    vebTree() : root{new root_type()}, count{0} {}
+
+    /**
+     * @brief Costruttore per convertire un array in un albero
+     *
+     * @param array che si vuole convertire nell'albero
+     * @param length è la lunghezza dell'array
+     */
+    vebTree(const T array[], uint length) : vebTree()
+    {
+        for (uint i{0}; i < length; ++i)
+        {
+            insertValue(array[i]);
+        }
+    }
+
+    /**
+     * @brief Costruttore di copia
+     *
+     * @param orig è l'albero da copiare
+     */
+    vebTree(const vebTree<T> &orig) : vebTree()
+    {
+        for (const entry &e : orig)
+        {
+            insertValue(e.key);
+        }
+    }
+
+    /**
+     * @brief Costruttore di spostamento
+     *
+     * @param orig è l'albero da spostare (rimane vuoto)
+     */
+    vebTree(vebTree<T> &&orig) : vebTree()
+    {
+        std::swap(root, orig.root);
+        std::swap(repeated, orig.repeated);
+        std::swap(count, orig.count);
+    }
+
+    /**
+     * @brief Operatore di assegnazione (per copia o per spostamento)
+     *
+     * @param other è l'albero da assegnare
+     * @return vebTree& è il riferimento all'albero
+     */
+    vebTree<T> &operator=(vebTree<T> other)
+    {
+        std::swap(root, other.root);
+        std::swap(repeated, other.repeated);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    /**
+     * @brief Metodo che informa se l'albero è vuoto
+     */
+    inline bool isEmpty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * @brief Restituisce il numero di chiavi (come bst::nodesCount())
+     */
+    inline std::size_t nodesCount() const
+    {
+        return count;
+    }
+
+    /**
+     * @brief Inserisce un valore nell'albero in O(log log U)
+     *
+     * @param value è il valore da inserire
+     * @return puntatore all'albero
+     */
+    vebTree<T> *insertValue(const T &value)
+    {
+        if (root->contains(value))
+        {
+            ++repeated[value];
+        }
+        else
+        {
+            root->insert(value);
+        }
+        ++count;
+        return this;
+    }
+
+    /**
+     * @brief Ricerca di una chiave in O(log log U)
+     *
+     * @param value è la chiave da cercare
+     * @return const_iterator alla prima occorrenza della chiave o end() se la chiave non è presente
+     */
+    const_iterator find(const T &value) const
+    {
+        return root->contains(value) ? const_iterator{this, value, 0, false} : end();
+    }
+
+    /**
+     * @brief Metodo che informa se una chiave è presente (senza lanciare eccezioni)
+     *
+     * @param value è la chiave da cercare
+     * @return true se la chiave è presente
+     * @return false se la chiave non è presente
+     */
+    inline bool isPresent(const T &value) const
+    {
+        return root->contains(value);
+    }
+
+    /**
+     * @brief Ricerca di una chiave
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da cercare
+     * @return const_iterator alla prima occorrenza della chiave
+     */
+    const_iterator binarySearch(const T &value) const
+    {
+        if (!root->contains(value))
+        {
+            throw NonExistingValueException(value);
+        }
+        return const_iterator{this, value, 0, false};
+    }
+
+    /**
+     * @brief Eliminazione di un'occorrenza di una chiave in O(log log U)
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da eliminare
+     */
+    void deleteKey(const T &value)
+    {
+        if (!root->contains(value))
+        {
+            throw NonExistingValueException(value);
+        }
+        auto it{repeated.find(value)};
+        if (it != repeated.end())
+        {
+            if (--it->second == 0)
+            {
+                repeated.erase(it);
+            }
+        }
+        else
+        {
+            root->remove(value);
+        }
+        --count;
+    }
+
+    /**
+     * @brief Chiave successiva a un valore in O(log log U)
+     *
+     * @param value è il valore di partenza (può non essere presente)
+     * @return const_iterator alla minima chiave maggiore di value o end() se non esiste
+     */
+    const_iterator successor(const T &value) const
+    {
+        T next{0};
+        return root->successor(value, next) ? const_iterator{this, next, 0, false} : end();
+    }
+
+    /**
+     * @brief Chiave precedente a un valore in O(log log U)
+     *
+     * @param value è il valore di partenza (può non essere presente)
+     * @return const_iterator all'ultima occorrenza della massima chiave minore di value o end() se non esiste
+     */
+    const_iterator predecessor(const T &value) const
+    {
+        T previous{0};
+        return root->predecessor(value, previous) ? const_iterator{this, previous, occurrences(previous) - 1, false} : end();
+    }
+
+    /**
+     * @brief Restituisce la chiave minima in O(1)
+     *
+     * @return const_iterator alla chiave minima (end() se l'albero è vuoto)
+     */
+    inline const_iterator min() const
+    {
+        return begin();
+    }
+
+    /**
+     * @brief Restituisce la chiave massima in O(1)
+     *
+     * @return const_iterator all'ultima occorrenza della chiave massima (end() se l'albero è vuoto)
+     */
+    inline const_iterator max() const
+    {
+        return isEmpty() ? end() : const_iterator{this, root->maximum, occurrences(root->maximum) - 1, false};
+    }
+
+    inline const_iterator begin() const
+    {
+        return isEmpty() ? end() : const_iterator{this, root->minimum, 0, false};
+    }
+
+    inline const_iterator end() const
+    {
+        return const_iterator{this, 0, 0, true};
+    }
+
+    /**
+     * @brief Iteratore successivo all'ultimo elemento, come bst::cend() (qui coincide con end())
+     */
+    inline const_iterator cend() const
+    {
+        return end();
+    }
+};
+
+/**
+ * @brief Albero di ricerca scelto a tempo di compilazione in base al tipo delle chiavi: vebTree per gli interi senza segno
+ * con l'ordine predefinito std::greater, bst negli altri casi. I metodi comuni (insertValue, binarySearch, find, isPresent,
+ * deleteKey, const_iterator) hanno lo stesso nome; binarySearch(k)->getKey() funziona con entrambi.
+ *
+ * @tparam T è il tipo delle chiavi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ */
+template <typename T, typename CMP = std::greater<T>>
+using fastBst = typename std::conditional<std::is_unsigned<T>::value && !std::is_same<T, bool>::value && std::is_same<CMP, std::greater<T>>::value,
+                                          vebTree<T>, bst<T, CMP>>::type;
+
+#endif
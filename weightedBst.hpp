@@ -0,0 +1,415 @@
+#ifndef __weightedBst_hpp__
+#define __weightedBst_hpp__
+
+#include <functional>
+#include <vector>
+#include <utility>
+
+#include "bst.hpp"
+
+/**
+ * @class weightedBst
+ *
+ * @brief Albero binario di ricerca che registra la frequenza di accesso delle chiavi e si ricostruisce in forma ottima.
+ * Ogni ricerca con esito positivo incrementa il contatore della chiave trovata (i contatori si possono anche fornire
+ * con recordAccess()). I contatori sono in una tabella hash a indirizzamento aperto, quindi una ricerca aggiunge
+ * all'albero solo un hash e di solito una lettura della tabella. rebuildOptimal() ricollega i nodi esistenti in modo da minimizzare il numero atteso di confronti
+ * per quella distribuzione: con l'algoritmo di Knuth (ottimo, O(n²)) fino a knuthLimit nodi, altrimenti con
+ * l'approssimazione di Mehlhorn (radice che bilancia il peso dei due sottoalberi, O(n log n)), il cui costo
+ * supera quello ottimo al più di una costante additiva.
+ * Adatto alle tabelle di sola lettura con una distribuzione degli accessi nota e stabile.
+ *
+ * @tparam T è il tipo di dato delle chiavi associate ai nodi
+ * @tparam CMP è la relazione d'ordine del tipo T
+ * @tparam HASH è la funzione hash del tipo T (chiavi equivalenti secondo CMP devono avere lo stesso hash)
+ */
+template <typename T, typename CMP = std::greater<T>, typename HASH = std::hash<T>>
+class weightedBst : public bst<T, CMP>
+{
+private:
+    /**
+     * @brief Posizione della tabella dei contatori (libera se hits è 0)
+     */
+    struct counter
+    {
+        std::size_t hash;   // hash rimescolato della chiave
+        unsigned long hits; // numero di accessi registrati
+        T key;              // chiave
+    };
+
+    std::vector<counter> counters; // tabella dei contatori con dimensione potenza di 2
+    std::size_t used;              // numero di posizioni occupate
+    HASH hasher;                   // funzione hash
+
+    /**
+     * @brief Hash di una chiave rimescolato con il finalizzatore di splitmix64
+     * std::hash degli interi è l'identità: senza rimescolare, chiavi con gli stessi bit bassi (per esempio multipli di 4096)
+     * finirebbero tutte nello stesso gruppo della tabella.
+     *
+     * @param value è la chiave
+     * @return std::size_t è l'hash rimescolato
+     */
+    inline std::size_t mix(const T &value) const
+    {
+        uint64_t h{(uint64_t)hasher(value) + 0x9e3779b97f4a7c15ULL};
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+
+    /**
+     * @brief Cerca la posizione del contatore di una chiave (scansione lineare)
+     *
+     * @param value è la chiave
+     * @param hash è l'hash rimescolato di value (vedi mix())
+     * @return std::size_t è la posizione del contatore o della prima posizione libera incontrata
+     */
+    std::size_t probe(const T &value, std::size_t hash) const
+    {
+        const std::size_t mask{counters.size() - 1};
+        std::size_t i{hash & mask};
+        while (counters[i].hits != 0 && (counters[i].hash != hash || !this->equivalent(counters[i].key, value)))
+        {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    /**
+     * @brief Raddoppia la dimensione della tabella dei contatori
+     */
+    void grow()
+    {
+        std::vector<counter> old(counters.size() < 16 ? 16 : 2 * counters.size(), counter{0, 0, T{}});
+        old.swap(counters);
+        for (const counter &c : old)
+        {
+            if (c.hits != 0)
+            {
+                counters[probe(c.key, c.hash)] = c;
+            }
+        }
+    }
+
+    /**
+     * @brief Aggiunge degli accessi al contatore di una chiave, creandolo se necessario
+     *
+     * @param value è la chiave
+     * @param count è il numero di accessi
+     */
+    void addHits(const T &value, unsigned long count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (2 * (used + 1) > counters.size()) // Fattore di carico massimo 1/2
+        {
+            grow();
+        }
+        std::size_t hash{mix(value)};
+        counter &c{counters[probe(value, hash)]};
+        if (c.hits == 0)
+        {
+            c.hash = hash;
+            c.key = value;
+            ++used;
+        }
+        c.hits += count;
+    }
+
+    /**
+     * @brief Restituisce il numero di accessi registrati per una chiave
+     *
+     * @param value è la chiave
+     * @return unsigned long è il numero di accessi (0 se non registrati)
+     */
+    unsigned long hitsOf(const T &value) const
+    {
+        return counters.empty() ? 0 : counters[probe(value, mix(value))].hits;
+    }
+
+    /**
+     * @brief Numero massimo di nodi per cui si usa l'algoritmo esatto di Knuth (memoria O(n²))
+     */
+    static const uint knuthLimit{1024};
+
+    /**
+     * @brief Raccoglie i nodi dell'albero nell'ordine della visita simmetrica
+     *
+     * @return std::vector<bst<T, CMP> *> sono i nodi dell'albero
+     */
+    std::vector<bst<T, CMP> *> inorderNodes()
+    {
+        std::vector<bst<T, CMP> *> nodes;
+        if (!this->isEmpty())
+        {
+            for (bst<T, CMP> *node{this->min()}; node != nullptr; node = bst<T, CMP>::nextNode(node))
+            {
+                nodes.push_back(node);
+            }
+        }
+        return nodes;
+    }
+
+    /**
+     * @brief Pesi dei nodi nell'ordine della visita simmetrica
+     * Tra chiavi equivalenti il peso viene assegnato solo alla prima, le altre non vengono mai restituite da una ricerca.
+     *
+     * @param nodes sono i nodi nell'ordine della visita simmetrica
+     * @return std::vector<double> sono i pesi dei nodi
+     */
+    std::vector<double> weightsOf(const std::vector<bst<T, CMP> *> &nodes) const
+    {
+        std::vector<double> weights(nodes.size(), 0.0);
+        for (uint i{0}; i < nodes.size(); ++i)
+        {
+            if (i > 0 && this->equivalent(nodes[i - 1]->key, nodes[i]->key))
+            {
+                continue;
+            }
+            weights[i] = hitsOf(nodes[i]->key);
+        }
+        return weights;
+    }
+
+    /**
+     * @brief Costruisce la forma dell'albero scegliendo la radice di ogni intervallo di nodi
+     * Gli intervalli di peso nullo vengono costruiti bilanciati: non influiscono sul costo atteso ma mantengono bassa l'altezza.
+     *
+     * @tparam CHOOSE è il tipo della funzione di scelta della radice
+     * @param prefix sono le somme prefisse dei pesi (prefix[i] = peso dei primi i nodi)
+     * @param chooseRoot restituisce la radice dell'intervallo semiaperto [i, j)
+     * @param leftIdx è l'indice del figlio sinistro di ogni nodo (-1 se assente)
+     * @param rightIdx è l'indice del figlio destro di ogni nodo (-1 se assente)
+     * @return uint è l'indice della radice
+     */
+    template <typename CHOOSE>
+    static uint buildShape(const std::vector<double> &prefix, CHOOSE chooseRoot, std::vector<int> &leftIdx, std::vector<int> &rightIdx)
+    {
+        struct range
+        {
+            uint first, last; // intervallo semiaperto di nodi
+            int *link;        // posizione in cui scrivere la radice dell'intervallo
+        };
+        const uint n = prefix.size() - 1;
+        leftIdx.assign(n, -1);
+        rightIdx.assign(n, -1);
+        int rootIdx{-1};
+        std::vector<range> pending{{0, n, &rootIdx}}; // Pila esplicita: con pesi molto sbilanciati l'albero può essere profondo
+        while (!pending.empty())
+        {
+            range current{pending.back()};
+            pending.pop_back();
+            if (current.first == current.last)
+            {
+                continue;
+            }
+            uint r{prefix[current.last] == prefix[current.first] ? (current.first + current.last) / 2 : chooseRoot(current.first, current.last)};
+            *current.link = r;
+            pending.push_back({current.first, r, &leftIdx[r]});
+            pending.push_back({r + 1, current.last, &rightIdx[r]});
+        }
+        return rootIdx;
+    }
+
+    /**
+     * @brief Albero ottimo con l'algoritmo di Knuth
+     * cost[i][j] è il costo minimo dell'intervallo [i, j); la radice ottima di [i, j) è compresa tra quelle di [i, j - 1) e [i + 1, j).
+     *
+     * @param prefix sono le somme prefisse dei pesi
+     * @param leftIdx è l'indice del figlio sinistro di ogni nodo
+     * @param rightIdx è l'indice del figlio destro di ogni nodo
+     * @return uint è l'indice della radice
+     */
+    static uint knuthShape(const std::vector<double> &prefix, std::vector<int> &leftIdx, std::vector<int> &rightIdx)
+    {
+        const uint n = prefix.size() - 1;
+        const uint side{n + 1};
+        std::vector<double> cost(side * side, 0.0);
+        std::vector<uint> best(side * side, 0);
+        for (uint i{0}; i < n; ++i)
+        {
+            cost[i * side + i + 1] = prefix[i + 1] - prefix[i];
+            best[i * side + i + 1] = i;
+        }
+        for (uint length{2}; length <= n; ++length)
+        {
+            for (uint i{0}; i + length <= n; ++i)
+            {
+                uint j{i + length};
+                double minimum{-1.0};
+                for (uint r{best[i * side + j - 1]}; r <= best[(i + 1) * side + j]; ++r)
+                {
+                    double candidate{cost[i * side + r] + cost[(r + 1) * side + j]};
+                    if (minimum < 0 || candidate < minimum)
+                    {
+                        minimum = candidate;
+                        best[i * side + j] = r;
+                    }
+                }
+                cost[i * side + j] = minimum + prefix[j] - prefix[i];
+            }
+        }
+        return buildShape(prefix, [&](uint i, uint j)
+                          { return best[i * side + j]; },
+                          leftIdx, rightIdx);
+    }
+
+    /**
+     * @brief Albero quasi ottimo con l'approssimazione di Mehlhorn
+     * La radice di [i, j) è il nodo il cui punto medio di peso è più vicino a metà del peso dell'intervallo.
+     *
+     * @param prefix sono le somme prefisse dei pesi
+     * @param leftIdx è l'indice del figlio sinistro di ogni nodo
+     * @param rightIdx è l'indice del figlio destro di ogni nodo
+     * @return uint è l'indice della radice
+     */
+    static uint mehlhornShape(const std::vector<double> &prefix, std::vector<int> &leftIdx, std::vector<int> &rightIdx)
+    {
+        return buildShape(prefix, [&](uint i, uint j)
+                          {
+                              double half{(prefix[i] + prefix[j]) / 2};
+                              uint low{i}, high{j - 1};
+                              while (low < high) // Primo nodo il cui punto medio non precede half (i punti medi sono crescenti)
+                              {
+                                  uint mid{(low + high) / 2};
+                                  if ((prefix[mid] + prefix[mid + 1]) / 2 < half)
+                                  {
+                                      low = mid + 1;
+                                  }
+                                  else
+                                  {
+                                      high = mid;
+                                  }
+                              }
+                              if (low > i && half - (prefix[low - 1] + prefix[low]) / 2 < (prefix[low] + prefix[low + 1]) / 2 - half)
+                              {
+                                  --low;
+                              }
+                              return low;
+                          },
+                          leftIdx, rightIdx);
+    }
+
+public:
+    /**
+     * @brief Costruttore vuoto
+     */
+    weightedBst() : bst<T, CMP>(), used{0} {}
+
+    /**
+     * @brief Costruttore per convertire un array in un albero
+     *
+     * @param array che si vuole convertire nell'albero binario di ricerca
+     * @param length è la lunghezza dell'array
+     */
+    weightedBst(const T array[], uint length) : bst<T, CMP>(array, length), used{0} {}
+
+    /**
+     * @brief Ricerca di una chiave che registra l'accesso se la chiave è presente
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore al nodo trovato o nullptr se la chiave non è presente
+     */
+    bst<T, CMP> *find(const T &value)
+    {
+        bst<T, CMP> *node{bst<T, CMP>::find(value)};
+        if (node != nullptr)
+        {
+            addHits(node->key, 1);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Ricerca binaria che registra l'accesso
+     * Se la chiave non è presente viene lanciata un'eccezione.
+     *
+     * @param value è la chiave da cercare
+     * @return puntatore al nodo trovato
+     */
+    bst<T, CMP> *const binarySearch(const T &value)
+    {
+        bst<T, CMP> *node{find(value)};
+        if (node == nullptr)
+        {
+            throw NonExistingValueException(value);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Registra degli accessi a una chiave forniti dall'utente (per esempio da statistiche raccolte altrove)
+     *
+     * @param value è la chiave a cui sono stati fatti gli accessi
+     * @param count è il numero di accessi
+     */
+    inline void recordAccess(const T &value, unsigned long count = 1)
+    {
+        addHits(value, count);
+    }
+
+    /**
+     * @brief Azzera i contatori degli accessi
+     */
+    inline void clearAccesses()
+    {
+        counters.clear();
+        used = 0;
+    }
+
+    /**
+     * @brief Numero atteso di confronti di una ricerca con la distribuzione degli accessi registrata
+     * Una ricerca che termina nel nodo a profondità d (radice a profondità 1) visita d nodi.
+     *
+     * @return double è il numero medio di nodi visitati per ricerca (0 se non sono stati registrati accessi)
+     */
+    double expectedCost()
+    {
+        std::vector<bst<T, CMP> *> nodes{inorderNodes()};
+        std::vector<double> weights{weightsOf(nodes)};
+        double total{0}, cost{0};
+        for (uint i{0}; i < nodes.size(); ++i)
+        {
+            if (weights[i] > 0)
+            {
+                uint depth{1};
+                for (const bst<T, CMP> *up{nodes[i]}; up->parent != nullptr; up = up->parent)
+                {
+                    ++depth;
+                }
+                total += weights[i];
+                cost += weights[i] * depth;
+            }
+        }
+        return total == 0 ? 0 : cost / total;
+    }
+
+    /**
+     * @brief Ricostruisce l'albero in modo da minimizzare il numero atteso di confronti per la distribuzione registrata
+     * I nodi non vengono riallocati: cambiano solo gli archi (e la chiave della radice, che resta lo stesso oggetto).
+     *
+     * @return std::pair<double, double> è il numero atteso di confronti prima e dopo la ricostruzione
+     */
+    std::pair<double, double> rebuildOptimal()
+    {
+        double before{expectedCost()};
+        std::vector<bst<T, CMP> *> nodes{inorderNodes()};
+        if (nodes.size() > 1)
+        {
+            std::vector<double> weights{weightsOf(nodes)};
+            std::vector<double> prefix(nodes.size() + 1, 0.0);
+            for (uint i{0}; i < nodes.size(); ++i)
+            {
+                prefix[i + 1] = prefix[i] + weights[i];
+            }
+            std::vector<int> leftIdx, rightIdx;
+            uint rootIdx{nodes.size() <= knuthLimit ? knuthShape(prefix, leftIdx, rightIdx) : mehlhornShape(prefix, leftIdx, rightIdx)};
+            this->relinkShape(nodes, leftIdx, rightIdx, rootIdx);
+        }
+        return {before, expectedCost()};
+    }
+};
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef __workerPool_hpp__
+#define __workerPool_hpp__
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Insieme di thread riutilizzati per dividere un lavoro ricorsivo in due parti (fork-join)
+ *
+ * I thread vengono creati al primo utilizzo, al più uno in meno dei core disponibili (almeno uno), e restano in attesa
+ * di compiti in una coda condivisa, quindi le funzioni parallele di bst non creano un thread a ogni livello di ricorsione
+ * e il numero di thread non dipende dal numero di chiamate. forkJoin() mette in coda la prima parte ed esegue la seconda
+ * nel thread chiamante; se al termine nessun thread ha ancora prelevato la prima parte, la esegue direttamente. Un thread
+ * che attende esegue quindi sempre lavoro utile o attende un compito già in esecuzione, e la ricorsione non può
+ * bloccarsi anche se tutti i thread dell'insieme stanno attendendo.
+ *
+ * Esiste un'unica istanza, che come quella di nodePool non viene mai distrutta.
+ */
+class workerPool
+{
+private:
+    /**
+     * @brief Compito in coda: la funzione, l'eventuale eccezione e l'indicatore di completamento (protetto dal mutex)
+     */
+    struct task
+    {
+        std::function<void()> work;
+        std::exception_ptr error;
+        bool done;
+
+        /**
+         * @brief Esegue la funzione conservando l'eventuale eccezione per il thread che attende
+         */
+        void execute()
+        {
+            try
+            {
+                work();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers; // thread dell'insieme
+    std::deque<task *> queue;         // compiti non ancora prelevati
+    std::mutex lock;                  // protegge queue e task::done
+    std::condition_variable ready;    // segnala un nuovo compito in coda
+    std::condition_variable finished; // segnala il completamento di un compito
+
+    workerPool()
+    {
+        unsigned threads{std::max(2u, std::thread::hardware_concurrency()) - 1};
+        for (unsigned i{0}; i < threads; ++i)
+        {
+            workers.emplace_back([this]()
+                                 { run(); });
+            workers.back().detach(); // L'istanza non viene distrutta: i thread terminano con il programma
+        }
+    }
+
+    /**
+     * @brief Ciclo di un thread dell'insieme: preleva ed esegue i compiti in ordine di arrivo
+     */
+    void run()
+    {
+        std::unique_lock<std::mutex> guard{lock};
+        for (;;)
+        {
+            ready.wait(guard, [this]()
+                       { return !queue.empty(); });
+            task *next{queue.front()};
+            queue.pop_front();
+            guard.unlock();
+            next->execute();
+            guard.lock();
+            next->done = true;
+            finished.notify_all();
+        }
+    }
+
+public:
+    workerPool(const workerPool &) = delete;
+    workerPool &operator=(const workerPool &) = delete;
+
+    /**
+     * @brief Restituisce l'istanza dell'insieme di thread
+     *
+     * @return workerPool& è il riferimento all'insieme
+     */
+    static workerPool &instance()
+    {
+        static workerPool *pool{new workerPool()}; // Volutamente mai distrutto (vedi la descrizione della classe)
+        return *pool;
+    }
+
+    /**
+     * @brief Esegue due funzioni, possibilmente in parallelo, e ritorna quando sono terminate entrambe
+     * Un'eccezione lanciata da una delle due funzioni viene rilanciata dopo il termine di entrambe.
+     *
+     * @tparam F è il tipo della prima funzione
+     * @tparam G è il tipo della seconda funzione
+     * @param f è la funzione messa in coda per un thread dell'insieme
+     * @param g è la funzione eseguita dal thread chiamante
+     */
+    template <typename F, typename G>
+    void forkJoin(F f, G g)
+    {
+        task forked{f, nullptr, false};
+        {
+            std::lock_guard<std::mutex> guard{lock};
+            queue.push_back(&forked);
+        }
+        ready.notify_one();
+        std::exception_ptr error;
+        try
+        {
+            g();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        std::unique_lock<std::mutex> guard{lock};
+        auto queued{std::find(queue.rbegin(), queue.rend(), &forked)};
+        if (queued != queue.rend()) // Nessun thread l'ha prelevata: la si esegue qui
+        {
+            queue.erase(std::next(queued).base());
+            guard.unlock();
+            forked.execute();
+        }
+        else
+        {
+            finished.wait(guard, [&forked]()
+                          { return forked.done; });
+        }
+        if (error == nullptr)
+        {
+            error = forked.error;
+        }
+        if (error != nullptr)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+#endif